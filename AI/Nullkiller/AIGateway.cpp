@@ -267,7 +267,7 @@ void AIGateway::heroVisitsTown(const CGHeroInstance * hero, const CGTownInstance
 	NET_EVENT_HANDLER;
 }
 
-void AIGateway::tileHidden(const std::unordered_set<int3> & pos)
+void AIGateway::tileHidden(const TileSpanSet & pos)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
@@ -275,15 +275,15 @@ void AIGateway::tileHidden(const std::unordered_set<int3> & pos)
 	nullkiller->memory->removeInvisibleObjects(myCb.get());
 }
 
-void AIGateway::tileRevealed(const std::unordered_set<int3> & pos)
+void AIGateway::tileRevealed(const TileSpanSet & pos)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
-	for(int3 tile : pos)
+	pos.forEachTile([this](const int3 & tile)
 	{
 		for(const CGObjectInstance * obj : myCb->getVisitableObjs(tile))
 			addVisitableObj(obj);
-	}
+	});
 
 	if (nullkiller->settings->isUpdateHitmapOnTileReveal() && !pos.empty())
 		nullkiller->dangerHitMap->resetTileOwners();
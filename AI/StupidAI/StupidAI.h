@@ -13,8 +13,6 @@
 #include "../../lib/battle/ReachabilityInfo.h"
 #include "../../lib/CGameInterface.h"
 
-class EnemyInfo;
-
 class CStupidAI : public CBattleGameInterface
 {
 	BattleSide side;
@@ -49,8 +47,5 @@ public:
 	//void battleTriggerEffect(const BattleTriggerEffect & bte) override;
 	void battleStart(const BattleID & battleID, const CCreatureSet *army1, const CCreatureSet *army2, int3 tile, const CGHeroInstance *hero1, const CGHeroInstance *hero2, BattleSide side, bool replayAllowed) override; //called by engine when battle starts; side=0 - left, side=1 - right
 	void battleCatapultAttacked(const BattleID & battleID, const CatapultAttack & ca) override; //called when catapult makes an attack
-
-private:
-	BattleAction goTowards(const BattleID & battleID, const CStack * stack, std::vector<BattleHex> hexes) const;
 };
 
@@ -0,0 +1,230 @@
+/*
+ * StupidAIPolicy.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "StupidAIPolicy.h"
+
+#include "../../lib/CStack.h"
+#include "../../lib/battle/CPlayerBattleCallback.h"
+#include "../../lib/battle/ReachabilityInfo.h"
+
+#include <vstd/RNG.h>
+
+namespace
+{
+
+struct EnemyInfo
+{
+	const CStack * stack;
+	int64_t damageDealt = 0;
+	int64_t damageReceived = 0;
+	std::vector<BattleHex> attackFrom; //for melee fight
+
+	explicit EnemyInfo(const CStack * stack)
+		: stack(stack)
+	{}
+
+	void calculateDamage(const CBattleInfoCallback & cb, const CStack * ourStack)
+	{
+		DamageEstimation retaliation;
+		DamageEstimation damage = cb.battleEstimateDamage(ourStack, stack, 0, &retaliation);
+
+		// Clip damage dealt to total stack health
+		auto totalHealth = stack->getTotalHealth();
+		vstd::amin(damage.damage.min, totalHealth);
+		vstd::amin(damage.damage.max, totalHealth);
+
+		auto ourHealth = ourStack->getTotalHealth();
+		vstd::amin(retaliation.damage.min, ourHealth);
+		vstd::amin(retaliation.damage.max, ourHealth);
+
+		damageDealt = (damage.damage.min + damage.damage.max) / 2;
+		damageReceived = (retaliation.damage.min + retaliation.damage.max) / 2;
+	}
+
+	int64_t profit() const
+	{
+		return damageDealt - damageReceived;
+	}
+};
+
+int countNeighbouringShooters(const CBattleInfoCallback & cb, BattleHex hex)
+{
+	int shooters = 0;
+
+	for(const auto & neighbour : hex.neighbouringTiles())
+	{
+		const auto * unit = cb.battleGetUnitByPos(neighbour);
+		if(unit && unit->isShooter())
+			shooters++;
+	}
+	return shooters;
+}
+
+}
+
+StupidAIPolicy::StupidAIPolicy(const CPlayerBattleCallback & cb, vstd::RNG & rand)
+	: cb(cb)
+	, rand(rand)
+{
+}
+
+BattleAction StupidAIPolicy::tacticPhase() const
+{
+	return BattleAction::makeEndOFTacticPhase(cb.battleGetTacticsSide());
+}
+
+BattleAction StupidAIPolicy::activeStack(const CStack * stack) const
+{
+	if(stack->creatureId() == CreatureID::CATAPULT)
+	{
+		static const std::vector<BattleHex> wallHexes = {50, 183, 182, 130, 78, 29, 12, 95};
+
+		BattleAction attack;
+		attack.aimToHex(*RandomGeneratorUtil::nextItem(wallHexes, rand));
+		attack.actionType = EActionType::CATAPULT;
+		attack.side = stack->unitSide();
+		attack.stackNumber = stack->unitId();
+		return attack;
+	}
+
+	if(stack->hasBonusOfType(BonusType::SIEGE_WEAPON))
+		return BattleAction::makeDefend(stack);
+
+	std::vector<EnemyInfo> enemiesShootable;
+	std::vector<EnemyInfo> enemiesReachable;
+	std::vector<EnemyInfo> enemiesUnreachable;
+
+	ReachabilityInfo reachability = cb.getReachability(stack);
+	std::vector<BattleHex> availableHexes = cb.battleGetAvailableHexes(reachability, stack, false);
+
+	for(const CStack * enemy : cb.battleGetStacks(CBattleInfoEssentials::ONLY_ENEMY))
+	{
+		if(cb.battleCanShoot(stack, enemy->getPosition()))
+		{
+			enemiesShootable.emplace_back(enemy);
+			continue;
+		}
+
+		EnemyInfo info(enemy);
+		for(BattleHex hex : availableHexes)
+			if(CStack::isMeleeAttackPossible(stack, enemy, hex))
+				info.attackFrom.push_back(hex);
+
+		if(!info.attackFrom.empty())
+			enemiesReachable.push_back(info);
+		else if(enemy->getPosition().isValid())
+			enemiesUnreachable.push_back(info);
+	}
+
+	for(auto & enemy : enemiesShootable)
+		enemy.calculateDamage(cb, stack);
+
+	for(auto & enemy : enemiesReachable)
+		enemy.calculateDamage(cb, stack);
+
+	const auto & lessProfitable = [](const EnemyInfo & a, const EnemyInfo & b)
+	{
+		return a.profit() < b.profit();
+	};
+
+	if(!enemiesShootable.empty())
+	{
+		const auto & target = *boost::max_element(enemiesShootable, lessProfitable);
+		return BattleAction::makeShotAttack(stack, target.stack);
+	}
+
+	if(!enemiesReachable.empty())
+	{
+		const auto & target = *boost::max_element(enemiesReachable, lessProfitable);
+
+		// prefer position that blocks more enemy shooters
+		BattleHex attackFrom = *boost::max_element(target.attackFrom, [&](BattleHex a, BattleHex b)
+		{
+			return countNeighbouringShooters(cb, a) < countNeighbouringShooters(cb, b);
+		});
+
+		return BattleAction::makeMeleeAttack(stack, target.stack->getPosition(), attackFrom);
+	}
+
+	if(!enemiesUnreachable.empty())
+	{
+		const auto & closestEnemy = *vstd::minElementByFun(enemiesUnreachable, [&](const EnemyInfo & info)
+		{
+			return reachability.distToNearestNeighbour(stack, info.stack);
+		});
+
+		if(reachability.distToNearestNeighbour(stack, closestEnemy.stack) < GameConstants::BFIELD_SIZE)
+			return goTowards(stack, closestEnemy.stack->getAttackableHexes(stack));
+	}
+
+	return BattleAction::makeDefend(stack);
+}
+
+BattleAction StupidAIPolicy::goTowards(const CStack * stack, std::vector<BattleHex> hexes) const
+{
+	auto reachability = cb.getReachability(stack);
+	auto availableHexes = cb.battleGetAvailableHexes(reachability, stack, false);
+
+	if(availableHexes.empty() || hexes.empty()) //we are blocked or destination is blocked
+		return BattleAction::makeDefend(stack);
+
+	std::sort(hexes.begin(), hexes.end(), [&](BattleHex h1, BattleHex h2)
+	{
+		return reachability.distances[h1] < reachability.distances[h2];
+	});
+
+	for(auto hex : hexes)
+	{
+		if(vstd::contains(availableHexes, hex))
+		{
+			if(stack->getPosition() == hex)
+				return BattleAction::makeDefend(stack);
+			return BattleAction::makeMove(stack, hex);
+		}
+
+		if(stack->coversPos(hex))
+		{
+			logAi->warn("Warning: already standing on neighbouring tile!");
+			return BattleAction::makeDefend(stack);
+		}
+	}
+
+	BattleHex bestNeighbour = hexes.front();
+
+	if(reachability.distances[bestNeighbour] > GameConstants::BFIELD_SIZE)
+		return BattleAction::makeDefend(stack);
+
+	if(stack->hasBonusOfType(BonusType::FLYING))
+	{
+		// Flying stack doesn't go hex by hex, so we can't backtrack using predecessors.
+		auto nearestAvailableHex = vstd::minElementByFun(availableHexes, [&](BattleHex hex)
+		{
+			return BattleHex::getDistance(bestNeighbour, hex);
+		});
+
+		return BattleAction::makeMove(stack, *nearestAvailableHex);
+	}
+
+	BattleHex currentDestination = bestNeighbour;
+	while(currentDestination.isValid())
+	{
+		if(vstd::contains(availableHexes, currentDestination))
+		{
+			if(stack->getPosition() == currentDestination)
+				return BattleAction::makeDefend(stack);
+			return BattleAction::makeMove(stack, currentDestination);
+		}
+
+		currentDestination = reachability.predecessors[currentDestination];
+	}
+
+	logAi->error("StupidAIPolicy::goTowards: internal error");
+	return BattleAction::makeDefend(stack);
+}
@@ -0,0 +1,38 @@
+/*
+ * StupidAIPolicy.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../../lib/battle/BattleAction.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class CPlayerBattleCallback;
+class CStack;
+
+namespace vstd
+{
+class RNG;
+}
+VCMI_LIB_NAMESPACE_END
+
+/// Decision making of StupidAI: shoot most profitable target, otherwise attack most profitable reachable target,
+/// otherwise approach closest enemy. Only depends on battle callback, so it is also used by battle benchmark
+class StupidAIPolicy
+{
+	const CPlayerBattleCallback & cb;
+	vstd::RNG & rand;
+
+	BattleAction goTowards(const CStack * stack, std::vector<BattleHex> hexes) const;
+
+public:
+	StupidAIPolicy(const CPlayerBattleCallback & cb, vstd::RNG & rand);
+
+	BattleAction activeStack(const CStack * stack) const;
+	BattleAction tacticPhase() const;
+};
@@ -53,14 +53,12 @@ namespace Goals
 		{
 			int3 tile = int3(0, 0, ourPos.z);
 
-			const auto & slice = ts->fogOfWarMap[ourPos.z];
-
 			for(tile.x = ourPos.x - scanRadius; tile.x <= ourPos.x + scanRadius; tile.x++)
 			{
 				for(tile.y = ourPos.y - scanRadius; tile.y <= ourPos.y + scanRadius; tile.y++)
 				{
 
-					if(cbp->isInTheMap(tile) && slice[tile.x][tile.y])
+					if(cbp->isInTheMap(tile) && ts->fogOfWarMap.isVisible(tile))
 					{
 						scanTile(tile);
 					}
@@ -81,13 +79,13 @@ namespace Goals
 
 			foreach_tile_pos([&](const int3 & pos)
 			{
-				if(ts->fogOfWarMap[pos.z][pos.x][pos.y])
+				if(ts->fogOfWarMap.isVisible(pos))
 				{
 					bool hasInvisibleNeighbor = false;
 
 					foreach_neighbour(cbp, pos, [&](CCallback * cbp, int3 neighbour)
 					{
-						if(!ts->fogOfWarMap[neighbour.z][neighbour.x][neighbour.y])
+						if(!ts->fogOfWarMap.isVisible(neighbour))
 						{
 							hasInvisibleNeighbor = true;
 						}
@@ -171,7 +169,7 @@ namespace Goals
 			{
 				foreach_neighbour(cbp, tile, [&](CCallback * cbp, int3 neighbour)
 				{
-					if(ts->fogOfWarMap[neighbour.z][neighbour.x][neighbour.y])
+					if(ts->fogOfWarMap.isVisible(neighbour))
 					{
 						out.push_back(neighbour);
 					}
@@ -184,15 +182,13 @@ namespace Goals
 			int ret = 0;
 			int3 npos = int3(0, 0, pos.z);
 
-			const auto & slice = ts->fogOfWarMap[pos.z];
-
 			for(npos.x = pos.x - sightRadius; npos.x <= pos.x + sightRadius; npos.x++)
 			{
 				for(npos.y = pos.y - sightRadius; npos.y <= pos.y + sightRadius; npos.y++)
 				{
 					if(cbp->isInTheMap(npos)
 						&& pos.dist2d(npos) - 0.5 < sightRadius
-						&& !slice[npos.x][npos.y])
+						&& !ts->fogOfWarMap.isVisible(npos))
 					{
 						if(allowDeadEndCancellation
 							&& !hasReachableNeighbor(npos))
@@ -277,7 +277,7 @@ void VCAI::heroVisitsTown(const CGHeroInstance * hero, const CGTownInstance * to
 	//moveCreaturesToHero(town);
 }
 
-void VCAI::tileHidden(const std::unordered_set<int3> & pos)
+void VCAI::tileHidden(const TileSpanSet & pos)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
@@ -286,15 +286,15 @@ void VCAI::tileHidden(const std::unordered_set<int3> & pos)
 	clearPathsInfo();
 }
 
-void VCAI::tileRevealed(const std::unordered_set<int3> & pos)
+void VCAI::tileRevealed(const TileSpanSet & pos)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
-	for(int3 tile : pos)
+	pos.forEachTile([this](const int3 & tile)
 	{
 		for(const CGObjectInstance * obj : myCb->getVisitableObjs(tile))
 			addVisitableObj(obj);
-	}
+	});
 
 	clearPathsInfo();
 }
@@ -0,0 +1,222 @@
+/*
+ * BattleBench.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleBench.h"
+
+#include "../lib/json/JsonNode.h"
+
+namespace
+{
+
+double toMilliseconds(BattleOutcome::Duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::string sideName(BattleSide side)
+{
+	switch(side)
+	{
+		case BattleSide::ATTACKER:
+			return "attacker";
+		case BattleSide::DEFENDER:
+			return "defender";
+		default:
+			return "none";
+	}
+}
+
+}
+
+BattleBench::BattleBench(const JsonNode & config)
+	: mapName(config["map"].String())
+{
+	if(mapName.empty())
+		throw std::runtime_error("Benchmark configuration does not define map");
+
+	for(const auto & battle : config["battles"].Struct())
+		scenarios.push_back(BattleScenario::fromJson(battle.first, battle.second));
+
+	if(scenarios.empty())
+		throw std::runtime_error("Benchmark configuration does not define any battles");
+}
+
+void BattleBench::runWorker(const std::vector<Job> & jobs, std::atomic<size_t> & nextJob, std::vector<BattleOutcome> & results, int seed) const
+{
+	static boost::mutex loadingMutex;
+
+	std::unique_ptr<BattleSimulator> simulator;
+	{
+		// map loading uses shared filesystem and is not designed to run in parallel
+		boost::mutex::scoped_lock lock(loadingMutex);
+		simulator = std::make_unique<BattleSimulator>(mapName);
+	}
+
+	for(size_t index = nextJob++; index < jobs.size(); index = nextJob++)
+	{
+		const Job & job = jobs[index];
+
+		try
+		{
+			results[index] = simulator->simulate(*job.scenario, job.repetition, seed + static_cast<int>(index));
+		}
+		catch(const std::exception & e)
+		{
+			results[index].scenario = job.scenario->name;
+			results[index].repetition = job.repetition;
+			results[index].error = e.what();
+		}
+
+		if(!results[index].error.empty())
+			logGlobal->error("Battle '%s' #%d failed: %s", job.scenario->name, job.repetition, results[index].error);
+	}
+}
+
+std::vector<BattleOutcome> BattleBench::run(int threads, int seed) const
+{
+	std::vector<Job> jobs;
+	for(const auto & scenario : scenarios)
+		for(int i = 0; i < scenario.repeat; ++i)
+			jobs.push_back({&scenario, i});
+
+	std::vector<BattleOutcome> results(jobs.size());
+	std::atomic<size_t> nextJob = 0;
+
+	threads = std::clamp<int>(threads, 1, jobs.size());
+	logGlobal->info("Playing %d battles on map %s using %d threads", jobs.size(), mapName, threads);
+
+	std::vector<boost::thread> workers;
+	for(int i = 0; i < threads; ++i)
+		workers.emplace_back([&]()
+		{
+			runWorker(jobs, nextJob, results, seed);
+		});
+
+	for(auto & worker : workers)
+		worker.join();
+
+	return results;
+}
+
+void BattleBench::printReport(const std::vector<BattleOutcome> & results) const
+{
+	for(const auto & scenario : scenarios)
+	{
+		int battles = 0;
+		int errors = 0;
+		int timeouts = 0;
+		int rounds = 0;
+		int decisions = 0;
+		BattleSideArray<int> wins = {0, 0};
+		BattleSideArray<double> remainingStrength = {0, 0};
+		BattleOutcome::Duration setupTime{};
+		BattleOutcome::Duration startTime{};
+		BattleOutcome::Duration decisionTime{};
+		BattleOutcome::Duration actionTime{};
+		BattleOutcome::Duration finishTime{};
+
+		for(const auto & result : results)
+		{
+			if(result.scenario != scenario.name)
+				continue;
+
+			if(!result.error.empty())
+			{
+				errors++;
+				continue;
+			}
+
+			battles++;
+			rounds += result.rounds;
+			decisions += result.decisions;
+
+			if(result.timedOut)
+				timeouts++;
+			else if(result.winner != BattleSide::NONE)
+				wins[result.winner]++;
+
+			for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+				if(result.initialStrength[side] != 0)
+					remainingStrength[side] += static_cast<double>(result.finalStrength[side]) / result.initialStrength[side];
+
+			setupTime += result.setupTime;
+			startTime += result.startTime;
+			decisionTime += result.decisionTime;
+			actionTime += result.actionTime;
+			finishTime += result.finishTime;
+		}
+
+		logGlobal->info("Battle '%s':", scenario.name);
+
+		if(errors != 0)
+			logGlobal->info("\tfailed: %d of %d", errors, errors + battles);
+
+		if(battles == 0)
+			continue;
+
+		int draws = battles - timeouts - wins[BattleSide::ATTACKER] - wins[BattleSide::DEFENDER];
+		double totalDecisionTime = toMilliseconds(decisionTime) / 1000.0;
+
+		logGlobal->info("\twins: attacker %d, defender %d, draws %d, timeouts %d", wins[BattleSide::ATTACKER], wins[BattleSide::DEFENDER], draws, timeouts);
+		logGlobal->info("\taverage rounds: %.2f, average remaining strength: attacker %.1f%%, defender %.1f%%",
+			static_cast<double>(rounds) / battles,
+			100.0 * remainingStrength[BattleSide::ATTACKER] / battles,
+			100.0 * remainingStrength[BattleSide::DEFENDER] / battles);
+		logGlobal->info("\tdecisions: %d, %.0f per second", decisions, totalDecisionTime > 0 ? decisions / totalDecisionTime : 0.0);
+		logGlobal->info("\taverage time, ms: setup %.2f, start %.2f, decisions %.2f, actions %.2f, finish %.2f",
+			toMilliseconds(setupTime) / battles,
+			toMilliseconds(startTime) / battles,
+			toMilliseconds(decisionTime) / battles,
+			toMilliseconds(actionTime) / battles,
+			toMilliseconds(finishTime) / battles);
+	}
+}
+
+JsonNode BattleBench::resultsToJson(const std::vector<BattleOutcome> & results)
+{
+	JsonNode output;
+
+	for(const auto & result : results)
+	{
+		JsonNode entry;
+		entry["scenario"].String() = result.scenario;
+		entry["repetition"].Integer() = result.repetition;
+
+		if(!result.error.empty())
+		{
+			entry["error"].String() = result.error;
+		}
+		else
+		{
+			entry["winner"].String() = sideName(result.winner);
+			entry["timedOut"].Bool() = result.timedOut;
+			entry["rounds"].Integer() = result.rounds;
+			entry["decisions"].Integer() = result.decisions;
+
+			for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+			{
+				auto & sideNode = entry[sideName(side)];
+				sideNode["initialStrength"].Integer() = result.initialStrength[side];
+				sideNode["finalStrength"].Integer() = result.finalStrength[side];
+			}
+
+			auto & timeNode = entry["time"];
+			timeNode["setup"].Float() = toMilliseconds(result.setupTime);
+			timeNode["start"].Float() = toMilliseconds(result.startTime);
+			timeNode["decisions"].Float() = toMilliseconds(result.decisionTime);
+			timeNode["actions"].Float() = toMilliseconds(result.actionTime);
+			timeNode["finish"].Float() = toMilliseconds(result.finishTime);
+		}
+
+		output.Vector().push_back(entry);
+	}
+
+	return output;
+}
@@ -0,0 +1,46 @@
+/*
+ * BattleBench.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "BattleSimulator.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class JsonNode;
+VCMI_LIB_NAMESPACE_END
+
+/// Plays all battles from benchmark configuration using a pool of worker threads
+/// Every worker owns separate BattleSimulator, so battles that run in parallel do not share any game state
+class BattleBench : boost::noncopyable
+{
+	std::string mapName;
+	std::vector<BattleScenario> scenarios;
+
+	struct Job
+	{
+		const BattleScenario * scenario;
+		int repetition;
+	};
+
+	void runWorker(const std::vector<Job> & jobs, std::atomic<size_t> & nextJob, std::vector<BattleOutcome> & results, int seed) const;
+
+public:
+	/// Loads configuration in form {"map" : "Maps/...", "battles" : { "name" : { scenario }, ... }}
+	explicit BattleBench(const JsonNode & config);
+
+	/// Plays every scenario required number of times. Results are ordered by scenario and repetition
+	/// Battle N uses seed + N, so results do not depend on number of threads
+	std::vector<BattleOutcome> run(int threads, int seed) const;
+
+	/// Prints summary of every scenario to the log
+	void printReport(const std::vector<BattleOutcome> & results) const;
+
+	/// Converts results of all battles to json, for comparison with results of other builds
+	static JsonNode resultsToJson(const std::vector<BattleOutcome> & results);
+};
@@ -0,0 +1,115 @@
+/*
+ * BattleScenario.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleScenario.h"
+
+#include "../lib/constants/StringConstants.h"
+#include "../lib/json/JsonNode.h"
+
+static BattleScenarioSide loadSide(const JsonNode & config)
+{
+	BattleScenarioSide result;
+
+	if(!config["player"].isNull())
+		result.player = PlayerColor(PlayerColor::decode(config["player"].String()));
+
+	if(!config["hero"].isNull())
+		result.hero = HeroTypeID(HeroTypeID::decode(config["hero"].String()));
+
+	for(const auto & stack : config["army"].Vector())
+	{
+		CreatureID creature(CreatureID::decode(stack["creature"].String()));
+		int amount = stack["amount"].Integer();
+
+		if(amount <= 0)
+			throw std::runtime_error("Invalid amount of creature " + stack["creature"].String());
+
+		result.army.emplace_back(creature, amount);
+	}
+
+	if(result.army.empty())
+		throw std::runtime_error("Army must have at least one stack");
+
+	if(result.army.size() > GameConstants::ARMY_SIZE)
+		throw std::runtime_error("Army can not have more than " + std::to_string(GameConstants::ARMY_SIZE) + " stacks");
+
+	for(const auto & artifact : config["artifacts"].Vector())
+		result.artifacts.emplace_back(ArtifactID::decode(artifact.String()));
+
+	for(const auto & skill : config["primarySkills"].Struct())
+		result.primarySkills[PrimarySkill(PrimarySkill::decode(skill.first))] = skill.second.Integer();
+
+	for(const auto & skill : config["secondarySkills"].Struct())
+	{
+		auto level = vstd::find_pos(NSecondarySkill::levels, skill.second.String());
+		if(level <= 0)
+			throw std::runtime_error("Invalid level of secondary skill " + skill.first);
+
+		result.secondarySkills.emplace_back(SecondarySkill::decode(skill.first), level);
+	}
+
+	if(!result.hero && (!result.artifacts.empty() || !result.primarySkills.empty() || !result.secondarySkills.empty()))
+		throw std::runtime_error("Army without hero can not have artifacts or skills");
+
+	return result;
+}
+
+BattleScenario BattleScenario::fromJson(const std::string & name, const JsonNode & config)
+{
+	BattleScenario result;
+	result.name = name;
+
+	try
+	{
+		if(!config["repeat"].isNull())
+			result.repeat = config["repeat"].Integer();
+
+		if(!config["maxRounds"].isNull())
+			result.maxRounds = config["maxRounds"].Integer();
+
+		if(!config["terrain"].isNull())
+			result.terrain = TerrainId(TerrainId::decode(config["terrain"].String()));
+
+		if(!config["tile"].isNull())
+		{
+			const auto & tile = config["tile"].Vector();
+			if(tile.size() != 3)
+				throw std::runtime_error("Tile must be defined as [x, y, z]");
+			result.tile = int3(tile[0].Integer(), tile[1].Integer(), tile[2].Integer());
+		}
+
+		if(!config["obstacles"].isNull())
+			result.obstacles = config["obstacles"].Bool();
+
+		if(config["siege"].isString())
+			result.siege = FactionID(FactionID::decode(config["siege"].String()));
+		else if(config["siege"].Bool())
+			result.siege = FactionID::ANY;
+
+		result.sides[BattleSide::ATTACKER] = loadSide(config["attacker"]);
+		result.sides[BattleSide::DEFENDER] = loadSide(config["defender"]);
+	}
+	catch(const IdentifierResolutionException & e)
+	{
+		throw std::runtime_error("Battle '" + name + "': unknown identifier " + e.identifierName);
+	}
+	catch(const std::runtime_error & e)
+	{
+		throw std::runtime_error("Battle '" + name + "': " + e.what());
+	}
+
+	if(result.repeat < 1 || result.maxRounds < 1)
+		throw std::runtime_error("Battle '" + name + "': number of repetitions and rounds must be positive");
+
+	if(!result.sides[BattleSide::ATTACKER].hero)
+		throw std::runtime_error("Battle '" + name + "': attacking army must be led by a hero");
+
+	return result;
+}
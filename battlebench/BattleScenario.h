@@ -0,0 +1,65 @@
+/*
+ * BattleScenario.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/battle/BattleSide.h"
+#include "../lib/constants/EntityIdentifiers.h"
+#include "../lib/int3.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class JsonNode;
+VCMI_LIB_NAMESPACE_END
+
+/// Description of one side of a simulated battle
+struct BattleScenarioSide
+{
+	/// Player that owns this side. If not set, attacker is owned by first player of the map,
+	/// defender - by second player if it has a hero, or is neutral otherwise
+	std::optional<PlayerColor> player;
+
+	/// Hero that leads this army, if any. Hero must not be present on the map
+	std::optional<HeroTypeID> hero;
+
+	std::vector<std::pair<CreatureID, int>> army;
+	std::vector<ArtifactID> artifacts;
+	std::map<PrimarySkill, int> primarySkills;
+
+	/// Secondary skills of hero. If empty, hero starts with his default skills
+	std::vector<std::pair<SecondarySkill, ui8>> secondarySkills;
+};
+
+/// Description of a battle, loaded from json file passed to battle benchmark
+struct BattleScenario
+{
+	std::string name;
+
+	/// Number of times this battle should be played
+	int repeat = 1;
+
+	/// Battle is considered a draw if it is not over after this number of rounds
+	int maxRounds = 100;
+
+	/// Terrain of the battlefield. Battle takes place on first free map tile with such terrain
+	std::optional<TerrainId> terrain;
+
+	/// Map tile on which battle takes place, overrides terrain
+	std::optional<int3> tile;
+
+	/// If false, all obstacles are removed from battlefield after its creation
+	bool obstacles = true;
+
+	/// If set, defender defends first suitable town of the map. Town of any faction is used if faction is ANY
+	std::optional<FactionID> siege;
+
+	BattleSideArray<BattleScenarioSide> sides;
+
+	/// Loads scenario from json. Throws std::runtime_error on invalid input
+	static BattleScenario fromJson(const std::string & name, const JsonNode & config);
+};
@@ -0,0 +1,474 @@
+/*
+ * BattleSimulator.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleSimulator.h"
+
+#include "../AI/StupidAI/StupidAIPolicy.h"
+
+#include "../server/CGameHandler.h"
+#include "../server/CVCMIServer.h"
+#include "../server/battles/BattleProcessor.h"
+#include "../server/queries/BattleQueries.h"
+#include "../server/queries/QueriesProcessor.h"
+
+#include "../lib/CPlayerState.h"
+#include "../lib/CRandomGenerator.h"
+#include "../lib/TerrainHandler.h"
+#include "../lib/CStack.h"
+#include "../lib/StartInfo.h"
+#include "../lib/battle/BattleInfo.h"
+#include "../lib/battle/BattleLayout.h"
+#include "../lib/battle/CObstacleInstance.h"
+#include "../lib/battle/CPlayerBattleCallback.h"
+#include "../lib/gameState/CGameState.h"
+#include "../lib/gameState/TavernHeroesPool.h"
+#include "../lib/mapObjects/CGHeroInstance.h"
+#include "../lib/mapObjects/CGTownInstance.h"
+#include "../lib/mapping/CMap.h"
+#include "../lib/mapping/CMapInfo.h"
+#include "../lib/networkPacks/PacksForClient.h"
+#include "../lib/networkPacks/PacksForClientBattle.h"
+#include "../lib/networkPacks/StackLocation.h"
+
+#include <vcmi/HeroType.h>
+
+BattleSimulator::BattleSimulator(const std::string & mapName)
+	: server(std::make_unique<CVCMIServer>(0, false))
+	, gh(nullptr)
+{
+	auto mapInfo = std::make_shared<CMapInfo>();
+	mapInfo->mapInit(mapName);
+
+	// all players are controlled by AI, so battles are resolved without waiting for confirmation from players
+	server->si->mode = EStartMode::NEW_GAME;
+	server->updateStartInfoOnMapChange(mapInfo);
+	server->si->fileURI = mapInfo->fileURI;
+	server->si->startTime = std::time(nullptr);
+
+	server->gh = std::make_shared<CGameHandler>(server.get());
+	gh = server->gh.get();
+
+	Load::ProgressAccumulator progressTracking;
+	gh->init(server->si.get(), progressTracking);
+}
+
+BattleSimulator::~BattleSimulator() = default;
+
+CGameState * BattleSimulator::gameState() const
+{
+	return gh->gameState();
+}
+
+PlayerColor BattleSimulator::getPlayer(const BattleScenario & scenario, BattleSide side) const
+{
+	const auto & config = scenario.sides[side];
+
+	PlayerColor result = PlayerColor::NEUTRAL;
+
+	if(config.player)
+	{
+		result = *config.player;
+	}
+	else if(side == BattleSide::ATTACKER || config.hero)
+	{
+		std::vector<PlayerColor> players;
+		for(const auto & player : gameState()->players)
+			if(player.first.isValidPlayer())
+				players.push_back(player.first);
+
+		size_t index = side == BattleSide::ATTACKER ? 0 : 1;
+		if(players.size() <= index)
+			throw std::runtime_error("Map does not have enough players");
+		result = players[index];
+	}
+
+	if(result.isValidPlayer() && !gameState()->players.count(result))
+		throw std::runtime_error("Player " + result.toString() + " is not present on the map");
+
+	if(!result.isValidPlayer() && config.hero)
+		throw std::runtime_error("Hero can not be owned by neutral player");
+
+	return result;
+}
+
+int3 BattleSimulator::findFreeTile(const std::optional<TerrainId> & terrain, const std::set<int3> & excluded) const
+{
+	const CMap * map = gameState()->map;
+
+	// skip map border, so hero placed on tile always fits into the map
+	for(int z = 0; z < map->levels(); ++z)
+	{
+		for(int y = 1; y < map->height - 1; ++y)
+		{
+			for(int x = 1; x < map->width - 1; ++x)
+			{
+				int3 position(x, y, z);
+				const auto & tile = map->getTile(position);
+
+				if(tile.blocked() || tile.visitable() || !tile.isLand() || map->isCoastalTile(position))
+					continue;
+
+				if(terrain && tile.getTerrainID() != *terrain)
+					continue;
+
+				if(!excluded.count(position))
+					return position;
+			}
+		}
+	}
+
+	if(terrain)
+		throw std::runtime_error("Map has no free tile with terrain " + terrain->toEntity(VLC)->getJsonKey());
+	throw std::runtime_error("Map has no free tiles");
+}
+
+const CGTownInstance * BattleSimulator::findTown(FactionID faction) const
+{
+	for(const auto & town : gameState()->map->towns)
+	{
+		if(town->garrisonHero || town->visitingHero)
+			continue;
+
+		if(faction == FactionID::ANY || town->getFactionID() == faction)
+			return town;
+	}
+
+	throw std::runtime_error("Map has no suitable town for siege");
+}
+
+const CGHeroInstance * BattleSimulator::recruitHero(const BattleScenarioSide & side, PlayerColor player, const int3 & visitablePosition, const CGTownInstance * town)
+{
+	auto * heroesPool = gameState()->heroesPool.get();
+	HeroTypeID heroType = *side.hero;
+
+	if(!heroesPool->unusedHeroesFromPool().count(heroType))
+		throw std::runtime_error("Hero " + heroType.toEntity(VLC)->getJsonKey() + " is already present on the map");
+
+	// battle is fought by newly created hero that temporarily replaces hero from pool
+	replacedPoolHeroes[heroType] = heroesPool->takeHeroFromPool(heroType);
+
+	auto * hero = new CGHeroInstance(gh);
+
+	if(!side.secondarySkills.empty())
+		hero->secSkills = side.secondarySkills;
+
+	for(size_t i = 0; i < side.army.size(); ++i)
+		hero->putStack(SlotID(i), new CStackInstance(side.army[i].first, side.army[i].second));
+
+	hero->initHero(gh->getRandomGenerator(), heroType);
+
+	for(const auto & skill : side.primarySkills)
+		hero->setPrimarySkill(skill.first, skill.second, true);
+
+	heroesPool->addHeroToPool(hero);
+
+	HeroRecruited hr;
+	hr.hid = heroType;
+	hr.tid = town ? town->id : ObjectInstanceID::NONE;
+	hr.player = player;
+	hr.tile = hero->convertFromVisitablePos(visitablePosition);
+	gh->sendAndApply(hr);
+
+	for(const auto & artifact : side.artifacts)
+		gh->giveHeroNewArtifact(hero, artifact, ArtifactPosition::FIRST_AVAILABLE);
+
+	gh->setManaPoints(hero->id, hero->manaLimit());
+
+	return hero;
+}
+
+const CArmedInstance * BattleSimulator::createMonsters(const BattleScenarioSide & side, const int3 & visitablePosition)
+{
+	gh->createWanderingMonster(visitablePosition, side.army.front().first);
+
+	const auto * monster = dynamic_cast<const CArmedInstance *>(gameState()->map->objects.back().get());
+	assert(monster);
+
+	setGarrison(monster, side);
+	return monster;
+}
+
+void BattleSimulator::setGarrison(const CArmedInstance * army, const BattleScenarioSide & side)
+{
+	std::vector<SlotID> existingSlots;
+	for(const auto & slot : army->Slots())
+		existingSlots.push_back(slot.first);
+
+	for(const auto & slot : existingSlots)
+		gh->eraseStack(StackLocation(army, slot), true);
+
+	// heroes defending town bring their own army
+	if(side.hero)
+		return;
+
+	for(size_t i = 0; i < side.army.size(); ++i)
+		gh->insertNewStack(StackLocation(army, SlotID(i)), side.army[i].first.toCreature(), side.army[i].second);
+}
+
+void BattleSimulator::removeObstacles(const BattleID & battleID)
+{
+	BattleObstaclesChanged removedObstacles;
+	removedObstacles.battleID = battleID;
+
+	for(const auto & obstacle : gameState()->getBattle(battleID)->getAllObstacles())
+	{
+		if(obstacle->obstacleType == CObstacleInstance::USUAL || obstacle->obstacleType == CObstacleInstance::ABSOLUTE_OBSTACLE)
+			removedObstacles.changes.emplace_back(obstacle->uniqueID, ObstacleChanges::EOperation::REMOVE);
+	}
+
+	if(!removedObstacles.changes.empty())
+		gh->sendAndApply(removedObstacles);
+}
+
+void BattleSimulator::cancelBattle(const BattleID & battleID, const BattleSideArray<PlayerColor> & players)
+{
+	BattleCancelled bc;
+	bc.battleID = battleID;
+	gh->sendAndApply(bc);
+
+	// battle query has no result, so its removal does not trigger processing of battle results
+	for(const auto & player : players)
+	{
+		if(!player.isValidPlayer())
+			continue;
+
+		auto query = std::dynamic_pointer_cast<CBattleQuery>(gh->queries->topQuery(player));
+		if(query && query->battleID == battleID)
+			gh->queries->popQuery(query);
+	}
+}
+
+void BattleSimulator::answerQueries(const BattleSideArray<PlayerColor> & players)
+{
+	// level-ups and other dialogs that appear after battle are answered with first option
+	for(const auto & player : players)
+	{
+		if(!player.isValidPlayer())
+			continue;
+
+		for(auto query = gh->queries->topQuery(player); query && query->endsByPlayerAnswer(); query = gh->queries->topQuery(player))
+		{
+			if(!gh->queryReply(query->queryID, 0, player))
+				break;
+		}
+	}
+}
+
+void BattleSimulator::removeArmy(ObjectInstanceID army)
+{
+	const auto * object = gh->getObj(army, false);
+
+	if(!object || object->ID == Obj::TOWN)
+		return;
+
+	RemoveObject ro(army, PlayerColor::NEUTRAL);
+	gh->sendAndApply(ro);
+}
+
+void BattleSimulator::restorePoolHeroes()
+{
+	auto * heroesPool = gameState()->heroesPool.get();
+
+	for(const auto & [heroType, originalHero] : replacedPoolHeroes)
+	{
+		// defeated or removed hero is returned into pool by the game
+		CGHeroInstance * usedHero = heroesPool->takeHeroFromPool(heroType);
+		delete usedHero;
+
+		heroesPool->addHeroToPool(originalHero);
+	}
+	replacedPoolHeroes.clear();
+}
+
+ui64 BattleSimulator::getArmyStrength(ObjectInstanceID army) const
+{
+	const auto * object = dynamic_cast<const CArmedInstance *>(gh->getObj(army, false));
+	return object ? object->getArmyStrength() : 0;
+}
+
+BattleOutcome BattleSimulator::simulate(const BattleScenario & scenario, int repetition, int seed)
+{
+	using Clock = std::chrono::steady_clock;
+
+	BattleOutcome outcome;
+	outcome.scenario = scenario.name;
+	outcome.repetition = repetition;
+
+	auto timePoint = Clock::now();
+	const auto & measure = [&timePoint](BattleOutcome::Duration & target)
+	{
+		auto now = Clock::now();
+		target += now - timePoint;
+		timePoint = now;
+	};
+
+	gh->randomNumberGenerator->setSeed(seed);
+
+	const BattleScenarioSide & attacker = scenario.sides[BattleSide::ATTACKER];
+	const BattleScenarioSide & defender = scenario.sides[BattleSide::DEFENDER];
+
+	BattleSideArray<PlayerColor> players;
+	players[BattleSide::ATTACKER] = getPlayer(scenario, BattleSide::ATTACKER);
+	players[BattleSide::DEFENDER] = getPlayer(scenario, BattleSide::DEFENDER);
+
+	if(players[BattleSide::ATTACKER] == players[BattleSide::DEFENDER])
+		throw std::runtime_error("Both sides of the battle are owned by the same player");
+
+	BattleSideArray<ObjectInstanceID> armyIDs;
+	BattleID battleID = BattleID::NONE;
+
+	try
+	{
+		BattleSideArray<const CArmedInstance *> armies = {nullptr, nullptr};
+		BattleSideArray<const CGHeroInstance *> heroes = {nullptr, nullptr};
+
+		const CGTownInstance * town = scenario.siege ? findTown(*scenario.siege) : nullptr;
+		int3 battleTile;
+
+		if(town)
+		{
+			battleTile = town->getSightCenter();
+
+			if(town->getOwner() != players[BattleSide::DEFENDER])
+				gh->setOwner(town, players[BattleSide::DEFENDER]);
+
+			setGarrison(town, defender);
+			armies[BattleSide::DEFENDER] = town;
+
+			if(defender.hero)
+			{
+				heroes[BattleSide::DEFENDER] = recruitHero(defender, players[BattleSide::DEFENDER], town->visitablePos(), town);
+				armies[BattleSide::DEFENDER] = heroes[BattleSide::DEFENDER];
+
+				// same as in CGTownInstance::onHeroVisit - hero defends the town from its garrison
+				if(heroes[BattleSide::DEFENDER]->whereShouldBeAttachedOnSiege(false) == town)
+					gh->swapGarrisonOnSiege(town->id);
+			}
+		}
+		else
+		{
+			if(scenario.tile)
+			{
+				battleTile = *scenario.tile;
+				if(!gameState()->isInTheMap(battleTile) || gameState()->map->getTile(battleTile).blocked())
+					throw std::runtime_error("Battle tile " + battleTile.toString() + " is not free");
+			}
+			else
+			{
+				battleTile = findFreeTile(scenario.terrain, {});
+			}
+
+			if(defender.hero)
+			{
+				heroes[BattleSide::DEFENDER] = recruitHero(defender, players[BattleSide::DEFENDER], battleTile, nullptr);
+				armies[BattleSide::DEFENDER] = heroes[BattleSide::DEFENDER];
+			}
+			else
+			{
+				armies[BattleSide::DEFENDER] = createMonsters(defender, battleTile);
+			}
+		}
+		armyIDs[BattleSide::DEFENDER] = armies[BattleSide::DEFENDER]->id;
+
+		heroes[BattleSide::ATTACKER] = recruitHero(attacker, players[BattleSide::ATTACKER], findFreeTile(std::nullopt, {battleTile}), nullptr);
+		armies[BattleSide::ATTACKER] = heroes[BattleSide::ATTACKER];
+		armyIDs[BattleSide::ATTACKER] = armies[BattleSide::ATTACKER]->id;
+
+		for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+			outcome.initialStrength[side] = armies[side]->getArmyStrength();
+
+		measure(outcome.setupTime);
+
+		auto layout = BattleLayout::createDefaultLayout(gh, armies[BattleSide::ATTACKER], armies[BattleSide::DEFENDER]);
+		gh->battles->startBattle(armies[BattleSide::ATTACKER], armies[BattleSide::DEFENDER], battleTile, heroes[BattleSide::ATTACKER], heroes[BattleSide::DEFENDER], layout, town);
+
+		battleID = gameState()->getBattle(players[BattleSide::ATTACKER])->getBattleID();
+
+		if(!scenario.obstacles)
+			removeObstacles(battleID);
+
+		measure(outcome.startTime);
+
+		while(const auto * battle = gameState()->getBattle(battleID))
+		{
+			outcome.rounds = battle->round;
+
+			if(battle->round > scenario.maxRounds)
+			{
+				cancelBattle(battleID, players);
+				outcome.timedOut = true;
+				break;
+			}
+
+			const CStack * stack = nullptr;
+			BattleSide side = battle->tacticsSide;
+
+			if(!battle->tacticDistance)
+			{
+				stack = battle->battleGetStackByID(battle->getActiveStackID());
+				if(!stack)
+					throw std::runtime_error("Battle has no active stack");
+				side = stack->unitSide();
+			}
+
+			PlayerColor player = battle->getSidePlayer(side);
+			CPlayerBattleCallback callback(battle, player);
+			StupidAIPolicy policy(callback, gh->getRandomGenerator());
+
+			BattleAction action = stack ? policy.activeStack(stack) : policy.tacticPhase();
+			outcome.decisions++;
+			measure(outcome.decisionTime);
+
+			bool accepted = gh->battles->makePlayerBattleAction(battleID, player, action);
+
+			// server might reject action that policy considered possible, try to skip the turn instead
+			if(!accepted && stack && gameState()->getBattle(battleID))
+				accepted = gh->battles->makePlayerBattleAction(battleID, player, BattleAction::makeDefend(stack));
+
+			measure(outcome.actionTime);
+
+			if(!accepted)
+				throw std::runtime_error("Action of " + (stack ? stack->nodeName() : std::string("tactics phase")) + " was rejected by server");
+
+			answerQueries(players);
+			measure(outcome.finishTime);
+		}
+
+		for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+			outcome.finalStrength[side] = getArmyStrength(armyIDs[side]);
+
+		if(!outcome.timedOut)
+		{
+			bool attackerAlive = outcome.finalStrength[BattleSide::ATTACKER] != 0;
+			bool defenderAlive = outcome.finalStrength[BattleSide::DEFENDER] != 0;
+
+			if(attackerAlive && !defenderAlive)
+				outcome.winner = BattleSide::ATTACKER;
+			if(defenderAlive && !attackerAlive)
+				outcome.winner = BattleSide::DEFENDER;
+		}
+	}
+	catch(const std::exception & e)
+	{
+		outcome.error = e.what();
+
+		if(battleID != BattleID::NONE && gameState()->getBattle(battleID))
+			cancelBattle(battleID, players);
+	}
+
+	for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+		if(armyIDs[side] != ObjectInstanceID::NONE)
+			removeArmy(armyIDs[side]);
+
+	restorePoolHeroes();
+	measure(outcome.finishTime);
+
+	return outcome;
+}
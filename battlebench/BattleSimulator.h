@@ -0,0 +1,87 @@
+/*
+ * BattleSimulator.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "BattleScenario.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class CArmedInstance;
+class CGHeroInstance;
+class CGTownInstance;
+class CGameState;
+VCMI_LIB_NAMESPACE_END
+
+class CGameHandler;
+class CVCMIServer;
+
+/// Results of a single simulated battle
+struct BattleOutcome
+{
+	using Duration = std::chrono::steady_clock::duration;
+
+	std::string scenario;
+	int repetition = 0;
+
+	/// Winner of the battle, NONE if battle ended in a draw or was interrupted
+	BattleSide winner = BattleSide::NONE;
+	bool timedOut = false;
+	std::string error;
+
+	int rounds = 0;
+	int decisions = 0;
+
+	/// Total AI value of each army before and after the battle
+	BattleSideArray<ui64> initialStrength = {0, 0};
+	BattleSideArray<ui64> finalStrength = {0, 0};
+
+	Duration setupTime{}; // creation of armies
+	Duration startTime{}; // creation of battlefield
+	Duration decisionTime{}; // decision making of both sides
+	Duration actionTime{}; // processing of actions by server
+	Duration finishTime{}; // processing of battle results and removal of armies
+};
+
+/// Game instance, loaded from a map, that plays battles using server-side battle logic without any connected clients
+/// Battles are played one after another and every battle uses newly created armies, so battles do not affect each other
+/// Instances are independent from each other, but each instance must only be used by a single thread
+class BattleSimulator : boost::noncopyable
+{
+	std::unique_ptr<CVCMIServer> server;
+	CGameHandler * gh;
+
+	/// Heroes from heroes pool that are temporarily replaced by heroes taking part in battle
+	std::map<HeroTypeID, CGHeroInstance *> replacedPoolHeroes;
+
+	CGameState * gameState() const;
+
+	PlayerColor getPlayer(const BattleScenario & scenario, BattleSide side) const;
+	int3 findFreeTile(const std::optional<TerrainId> & terrain, const std::set<int3> & excluded) const;
+	const CGTownInstance * findTown(FactionID faction) const;
+
+	const CGHeroInstance * recruitHero(const BattleScenarioSide & side, PlayerColor player, const int3 & visitablePosition, const CGTownInstance * town);
+	const CArmedInstance * createMonsters(const BattleScenarioSide & side, const int3 & visitablePosition);
+	void setGarrison(const CArmedInstance * army, const BattleScenarioSide & side);
+
+	void removeObstacles(const BattleID & battleID);
+	void cancelBattle(const BattleID & battleID, const BattleSideArray<PlayerColor> & players);
+	void answerQueries(const BattleSideArray<PlayerColor> & players);
+	void removeArmy(ObjectInstanceID army);
+	void restorePoolHeroes();
+
+	ui64 getArmyStrength(ObjectInstanceID army) const;
+
+public:
+	explicit BattleSimulator(const std::string & mapName);
+	~BattleSimulator();
+
+	/// Plays the battle described by scenario with both sides controlled by StupidAIPolicy
+	/// Throws std::runtime_error if battle can not be set up on the loaded map
+	BattleOutcome simulate(const BattleScenario & scenario, int repetition, int seed);
+};
@@ -0,0 +1,126 @@
+/*
+ * EntryPoint.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "BattleBench.h"
+
+#include "../lib/CConsoleHandler.h"
+#include "../lib/logging/CBasicLogConfigurator.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/VCMIDirs.h"
+#include "../lib/VCMI_Lib.h"
+
+#include <boost/program_options.hpp>
+
+static void handleCommandOptions(int argc, const char * argv[], boost::program_options::variables_map & options)
+{
+	boost::program_options::options_description opts("Allowed options");
+	opts.add_options()
+	("help,h", "display help and exit")
+	("version,v", "display version information and exit")
+	("input", boost::program_options::value<std::string>(), "path to json file with list of battles to play")
+	("threads", boost::program_options::value<int>()->default_value(boost::thread::hardware_concurrency()), "number of battles to play in parallel")
+	("seed", boost::program_options::value<int>()->default_value(0), "seed for random number generator of first battle")
+	("output", boost::program_options::value<std::string>(), "path to json file to write results of all battles to");
+
+	boost::program_options::positional_options_description positional;
+	positional.add("input", 1);
+
+	try
+	{
+		boost::program_options::store(boost::program_options::command_line_parser(argc, argv).options(opts).positional(positional).run(), options);
+	}
+	catch(boost::program_options::error & e)
+	{
+		std::cerr << "Failure during parsing command-line options:\n" << e.what() << std::endl;
+		exit(1);
+	}
+
+	boost::program_options::notify(options);
+
+	if(options.count("help") || !options.count("input"))
+	{
+		printf("%s - headless battle benchmark\n", GameConstants::VCMI_VERSION.c_str());
+		printf("Usage: vcmibattlebench [options] battles.json\n");
+		printf("\n");
+		std::cout << opts;
+		exit(options.count("help") ? 0 : 1);
+	}
+
+	if(options.count("version"))
+	{
+		printf("%s\n", GameConstants::VCMI_VERSION.c_str());
+		std::cout << VCMIDirs::get().genHelpString();
+		exit(0);
+	}
+}
+
+static JsonNode loadConfig(const boost::filesystem::path & path)
+{
+	std::ifstream file(path.c_str(), std::ios::binary);
+	if(!file)
+		throw std::runtime_error("Failed to open " + path.string());
+
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return JsonNode(reinterpret_cast<const std::byte *>(data.data()), data.size(), path.string());
+}
+
+int main(int argc, const char * argv[])
+{
+	boost::program_options::variables_map opts;
+	handleCommandOptions(argc, argv, opts);
+
+	// paths given on command line are relative to original working directory
+	auto inputPath = boost::filesystem::absolute(opts["input"].as<std::string>());
+	std::optional<boost::filesystem::path> outputPath;
+	if(opts.count("output"))
+		outputPath = boost::filesystem::absolute(opts["output"].as<std::string>());
+
+	// Correct working dir executable folder (not bundle folder) so we can use executable relative paths
+	boost::filesystem::current_path(boost::filesystem::system_complete(argv[0]).parent_path());
+
+	console = new CConsoleHandler();
+	CBasicLogConfigurator logConfig(VCMIDirs::get().userLogsPath() / "VCMI_BattleBench_log.txt", console);
+	logConfig.configureDefault();
+
+	preinitDLL(console, false);
+	logConfig.configure();
+	loadDLLClasses();
+
+	int exitCode = 0;
+
+	try
+	{
+		BattleBench bench(loadConfig(inputPath));
+
+		auto results = bench.run(opts["threads"].as<int>(), opts["seed"].as<int>());
+		bench.printReport(results);
+
+		if(outputPath)
+		{
+			std::ofstream file(outputPath->c_str(), std::ofstream::trunc);
+			file << BattleBench::resultsToJson(results).toString();
+		}
+
+		for(const auto & result : results)
+			if(!result.error.empty())
+				exitCode = 1;
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Battle benchmark failed: %s", e.what());
+		exitCode = 1;
+	}
+
+	logConfig.deconfigure();
+	vstd::clear_pointer(VLC);
+
+	return exitCode;
+}
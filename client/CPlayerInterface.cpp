@@ -66,6 +66,7 @@
 #include "../CCallback.h"
 
 #include "../lib/CConfigHandler.h"
+#include "../lib/CCreatureHandler.h"
 #include "../lib/texts/CGeneralTextHandler.h"
 #include "../lib/CPlayerState.h"
 #include "../lib/CRandomGenerator.h"
@@ -628,6 +629,16 @@ void CPlayerInterface::battleStartBefore(const BattleID & battleID, const CCreat
 {
 	movementController->onBattleStarted();
 
+	// decode creature animations while remaining dialogs are closed and battle window is being set up
+	for (const auto * army : {army1, army2})
+	{
+		if (!army)
+			continue;
+
+		for (const auto & slot : army->Slots())
+			GH.renderHandler().prefetchAnimation(slot.second->getCreature()->animDefName, EImageBlitMode::WITH_SHADOW_AND_OVERLAY);
+	}
+
 	waitForAllDialogs();
 }
 
@@ -1162,14 +1173,14 @@ void CPlayerInterface::showMapObjectSelectDialog(QueryID askID, const Component
 	GH.windows().pushWindow(wnd);
 }
 
-void CPlayerInterface::tileRevealed(const std::unordered_set<int3> &pos)
+void CPlayerInterface::tileRevealed(const TileSpanSet &pos)
 {
 	EVENT_HANDLER_CALLED_BY_CLIENT;
 	//FIXME: wait for dialog? Magi hut/eye would benefit from this but may break other areas
 	adventureInt->onMapTilesChanged(pos);
 }
 
-void CPlayerInterface::tileHidden(const std::unordered_set<int3> &pos)
+void CPlayerInterface::tileHidden(const TileSpanSet &pos)
 {
 	EVENT_HANDLER_CALLED_BY_CLIENT;
 	adventureInt->onMapTilesChanged(pos);
@@ -1319,9 +1330,10 @@ void CPlayerInterface::objectPropertyChanged(const SetObjectProperty * sop)
 		}
 
 		//redraw minimap if owner changed
-		std::set<int3> pos = obj->getBlockedPos();
-		std::unordered_set<int3> upos(pos.begin(), pos.end());
-		adventureInt->onMapTilesChanged(upos);
+		TileSpanSet changedTiles;
+		for(const auto & tile : obj->getBlockedPos())
+			changedTiles.insert(tile);
+		adventureInt->onMapTilesChanged(changedTiles);
 
 		assert(cb->getTownsInfo().size() == localState->getOwnedTowns().size());
 	}
@@ -167,10 +167,9 @@ void HeroMovementController::onTryMoveHero(const CGHeroInstance * hero, const Tr
 		LOCPLINT->localState->hasPath(hero) &&
 		LOCPLINT->localState->getPath(hero).lastNode().coord == details.attackedFrom;
 
-	std::unordered_set<int3> changedTiles {
-		hero->convertToVisitablePos(details.start),
-		hero->convertToVisitablePos(details.end)
-	};
+	TileSpanSet changedTiles;
+	changedTiles.insert(hero->convertToVisitablePos(details.start));
+	changedTiles.insert(hero->convertToVisitablePos(details.end));
 	adventureInt->onMapTilesChanged(changedTiles);
 	adventureInt->onHeroMovementStarted(hero);
 
@@ -584,9 +584,13 @@ void ApplyClientNetPackVisitor::visitTryMoveHero(TryMoveHero & pack)
 
 	PlayerColor player = h->tempOwner;
 
-	for(auto &i : cl.playerint)
-		if(cl.getPlayerRelations(i.first, player) != PlayerRelations::ENEMIES)
-			i.second->tileRevealed(pack.fowRevealed);
+	// most moves do not reveal any new tiles, avoid refreshing map for every step of hero
+	if(!pack.fowRevealed.empty())
+	{
+		for(auto &i : cl.playerint)
+			if(cl.getPlayerRelations(i.first, player) != PlayerRelations::ENEMIES)
+				i.second->tileRevealed(pack.fowRevealed);
+	}
 
 	for(auto i=cl.playerint.begin(); i!=cl.playerint.end(); i++)
 	{
@@ -43,6 +43,7 @@
 #include "../../lib/IGameSettings.h"
 #include "../../lib/StartInfo.h"
 #include "../../lib/texts/CGeneralTextHandler.h"
+#include "../../lib/entities/building/CBuilding.h"
 #include "../../lib/spells/CSpellHandler.h"
 #include "../../lib/mapObjects/CGHeroInstance.h"
 #include "../../lib/mapObjects/CGTownInstance.h"
@@ -307,6 +308,21 @@ void AdventureMapInterface::keyPressed(EShortcut key)
 	GH.fakeMouseMove();
 }
 
+void AdventureMapInterface::prefetchTownScreen(const CGTownInstance * town)
+{
+	const auto & clientInfo = town->getTown()->clientInfo;
+
+	GH.renderHandler().prefetchImage(clientInfo.townBackground, EImageBlitMode::COLORKEY);
+
+	for(const CStructure * structure : clientInfo.structures)
+	{
+		if(structure->building && !town->hasBuilt(structure->building->bid))
+			continue;
+
+		GH.renderHandler().prefetchAnimation(structure->defName, EImageBlitMode::COLORKEY);
+	}
+}
+
 void AdventureMapInterface::onSelectionChanged(const CArmedInstance *sel)
 {
 	assert(sel);
@@ -323,6 +339,7 @@ void AdventureMapInterface::onSelectionChanged(const CArmedInstance *sel)
 		auto town = dynamic_cast<const CGTownInstance*>(sel);
 
 		widget->getInfoBar()->showTownSelection(town);
+		prefetchTownScreen(town);
 		widget->getTownList()->updateWidget();
 		widget->getTownList()->select(town);
 		widget->getHeroList()->select(nullptr);
@@ -355,7 +372,7 @@ void AdventureMapInterface::onHeroOrderChanged()
 	widget->getHeroList()->updateWidget();
 }
 
-void AdventureMapInterface::onMapTilesChanged(boost::optional<std::unordered_set<int3>> positions)
+void AdventureMapInterface::onMapTilesChanged(boost::optional<TileSpanSet> positions)
 {
 	if (positions)
 		widget->getMinimap()->updateTiles(*positions);
@@ -373,6 +390,8 @@ void AdventureMapInterface::onHotseatWaitStarted(PlayerColor playerID)
 
 void AdventureMapInterface::onEnemyTurnStarted(PlayerColor playerID, bool isHuman)
 {
+	widget->getMapView()->onEnemyTurnStarted();
+
 	if(settings["session"]["spectate"].Bool())
 		return;
 
@@ -456,7 +475,7 @@ void AdventureMapInterface::onPlayerTurnStarted(PlayerColor playerID)
 		widget->getInfoBar()->showDate();
 
 	onHeroChanged(nullptr);
-	Canvas canvas = Canvas::createFromSurface(screen, CanvasScalingPolicy::AUTO);
+	Canvas canvas = GH.windows().createScreenCanvas();
 	showAll(canvas);
 	mapAudio->onPlayerTurnStarted();
 
@@ -22,6 +22,7 @@ struct CGPathNode;
 struct ObjectPosInfo;
 struct Component;
 class int3;
+class TileSpanSet;
 
 VCMI_LIB_NAMESPACE_END
 
@@ -97,6 +98,9 @@ private:
 	/// dim interface if some windows opened
 	void dim(Canvas & to);
 
+	/// starts background loading of town screen images, since selected town is likely to be opened next
+	void prefetchTownScreen(const CGTownInstance * town);
+
 protected:
 	/// CIntObject interface implementation
 
@@ -134,7 +138,7 @@ public:
 	void onCurrentPlayerChanged(PlayerColor playerID);
 
 	/// Called by PlayerInterface when specific map tile changed and must be updated on minimap
-	void onMapTilesChanged(boost::optional<std::unordered_set<int3>> positions);
+	void onMapTilesChanged(boost::optional<TileSpanSet> positions);
 
 	/// Called by PlayerInterface when hero starts movement
 	void onHeroMovementStarted(const CGHeroInstance * hero);
@@ -56,41 +56,110 @@ ColorRGBA CMinimapInstance::getTileColor(const int3 & pos) const
 		return tile->getTerrain()->minimapUnblocked;
 }
 
-void CMinimapInstance::refreshTile(const int3 &tile)
+bool CMinimapInstance::refreshTileColor(LevelMinimap & minimap, const int3 & pos)
 {
-	if (level == tile.z)
-		minimap->drawPoint(Point(tile.x, tile.y), getTileColor(tile));
+	ColorRGBA color = getTileColor(pos);
+	ColorRGBA & cachedColor = minimap.tileColors[pos.y * LOCPLINT->cb->getMapSize().x + pos.x];
+
+	if (cachedColor == color)
+		return false;
+
+	cachedColor = color;
+	minimap.canvas->drawPoint(Point(pos.x, pos.y), color);
+	return true;
 }
 
-void CMinimapInstance::redrawMinimap()
+void CMinimapInstance::redrawLevel(int targetLevel)
 {
 	int3 mapSizes = LOCPLINT->cb->getMapSize();
+	auto & minimap = levels.at(targetLevel);
+
+	minimap.canvas = std::make_unique<Canvas>(Point(mapSizes.x, mapSizes.y), CanvasScalingPolicy::IGNORE);
+	minimap.tileColors.assign(mapSizes.x * mapSizes.y, Colors::BLACK);
 
 	for (int y = 0; y < mapSizes.y; ++y)
 		for (int x = 0; x < mapSizes.x; ++x)
-			minimap->drawPoint(Point(x, y), getTileColor(int3(x, y, level)));
+			minimap.canvas->drawPoint(Point(x, y), minimap.tileColors[y * mapSizes.x + x] = getTileColor(int3(x, y, targetLevel)));
+}
+
+void CMinimapInstance::applyPendingChanges()
+{
+	if (pendingFullRedraw)
+	{
+		// other levels will be redrawn once they are shown
+		for (auto & minimap : levels)
+			minimap.canvas.reset();
+
+		pendingTiles.clear();
+		pendingFullRedraw = false;
+	}
+
+	for (const auto & span : pendingTiles.getSpans())
+	{
+		auto & minimap = levels.at(span.start.z);
+		if (!minimap.canvas)
+			continue;
+
+		for (int3 tile = span.start; tile.x <= span.lastX(); ++tile.x)
+			if (refreshTileColor(minimap, tile) && tile.z == level)
+				scaledMinimapOutdated = true;
+	}
+	pendingTiles.clear();
+
+	if (!levels.at(level).canvas)
+	{
+		redrawLevel(level);
+		scaledMinimapOutdated = true;
+	}
+
+	if (scaledMinimapOutdated)
+	{
+		scaledMinimap->drawScaled(*levels.at(level).canvas, Point(0, 0), pos.dimensions());
+		scaledMinimapOutdated = false;
+	}
+}
+
+void CMinimapInstance::refreshTiles(const TileSpanSet & tiles)
+{
+	pendingTiles.insert(tiles);
+}
+
+void CMinimapInstance::refreshAll()
+{
+	pendingFullRedraw = true;
+}
+
+void CMinimapInstance::setLevel(int newLevel)
+{
+	if (level == newLevel)
+		return;
+
+	level = newLevel;
+	scaledMinimapOutdated = true;
 }
 
 CMinimapInstance::CMinimapInstance(const Point & position, const Point & dimensions, int Level):
-	minimap(new Canvas(Point(LOCPLINT->cb->getMapSize().x, LOCPLINT->cb->getMapSize().y), CanvasScalingPolicy::IGNORE)),
+	levels(LOCPLINT->cb->getMapSize().z),
+	scaledMinimap(new Canvas(dimensions, CanvasScalingPolicy::AUTO)),
 	level(Level)
 {
 	pos += position;
 	pos.w = dimensions.x;
 	pos.h = dimensions.y;
-	redrawMinimap();
 }
 
 CMinimapInstance::~CMinimapInstance() = default;
 
 void CMinimapInstance::showAll(Canvas & to)
 {
-	to.drawScaled(*minimap, pos.topLeft(), pos.dimensions());
+	applyPendingChanges();
+	to.draw(*scaledMinimap, pos.topLeft());
 }
 
 CMinimap::CMinimap(const Rect & position)
-	: CIntObject(LCLICK | SHOW_POPUP | DRAG | MOVE | GESTURE, position.topLeft()),
-	level(0)
+	: CIntObject(LCLICK | SHOW_POPUP | DRAG | MOVE | GESTURE | TIME, position.topLeft()),
+	level(0),
+	redrawRequested(false)
 {
 	OBJECT_CONSTRUCTION;
 
@@ -176,12 +245,22 @@ void CMinimap::mouseDragged(const Point & cursorPosition, const Point & lastUpda
 	moveAdvMapSelection(cursorPosition);
 }
 
+void CMinimap::tick(uint32_t msPassed)
+{
+	// all map changes received since last frame are drawn at once
+	if(redrawRequested)
+	{
+		redrawRequested = false;
+		redraw();
+	}
+}
+
 void CMinimap::showAll(Canvas & to)
 {
 	CSDL_Ext::CClipRectGuard guard(to.getInternalSurface(), aiShield->pos);
 	CIntObject::showAll(to);
 
-	if(minimap)
+	if(minimap && !isAIRadarActive())
 	{
 		int3 mapSizes = LOCPLINT->cb->getMapSize();
 
@@ -199,14 +278,29 @@ void CMinimap::showAll(Canvas & to)
 	}
 }
 
+bool CMinimap::isAIRadarActive() const
+{
+	return aiShield->recActions & UPDATE;
+}
+
 void CMinimap::update()
 {
-	if(aiShield->recActions & UPDATE) //AI turn is going on. There is no need to update minimap
-		return;
+	if(minimap)
+	{
+		minimap->refreshAll();
+	}
+	else
+	{
+		OBJECT_CONSTRUCTION;
+		minimap = std::make_shared<CMinimapInstance>(Point(0,0), pos.dimensions(), level);
 
-	OBJECT_CONSTRUCTION;
-	minimap = std::make_shared<CMinimapInstance>(Point(0,0), pos.dimensions(), level);
-	redraw();
+		//AI turn is going on. Minimap stays hidden, but keeps track of changes
+		if(isAIRadarActive())
+			minimap->disable();
+	}
+
+	if(!isAIRadarActive())
+		redrawRequested = true;
 }
 
 void CMinimap::onMapViewMoved(const Rect & visibleArea, int mapLevel)
@@ -219,10 +313,11 @@ void CMinimap::onMapViewMoved(const Rect & visibleArea, int mapLevel)
 	if(level != mapLevel)
 	{
 		level = mapLevel;
-		update();
+		if(minimap)
+			minimap->setLevel(level);
 	}
-	else
-		redraw();
+
+	redraw();
 }
 
 void CMinimap::setAIRadar(bool on)
@@ -230,22 +325,26 @@ void CMinimap::setAIRadar(bool on)
 	if(on)
 	{
 		aiShield->enable();
-		minimap.reset();
+		if(minimap)
+			minimap->disable();
 	}
 	else
 	{
 		aiShield->disable();
-		update();
+		if(minimap)
+			minimap->enable();
+		else
+			update();
 	}
 	redraw();
 }
 
-void CMinimap::updateTiles(const std::unordered_set<int3> & positions)
+void CMinimap::updateTiles(const TileSpanSet & positions)
 {
 	if(minimap)
-	{
-		for (auto const & tile : positions)
-			minimap->refreshTile(tile);
-	}
-	redraw();
+		minimap->refreshTiles(positions);
+
+	//changes are applied once minimap is shown after AI turn
+	if(!isAIRadarActive())
+		redrawRequested = true;
 }
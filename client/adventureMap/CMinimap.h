@@ -11,28 +11,51 @@
 
 #include "../gui/CIntObject.h"
 
-VCMI_LIB_NAMESPACE_BEGIN
-class ColorRGBA;
-VCMI_LIB_NAMESPACE_END
+#include "../../lib/Color.h"
+#include "../../lib/gameState/TileSpanSet.h"
 
 class Canvas;
 class CMinimap;
 
 class CMinimapInstance : public CIntObject
 {
-	std::unique_ptr<Canvas> minimap;
+	/// Minimap of a single map level, with one pixel per tile
+	struct LevelMinimap
+	{
+		std::unique_ptr<Canvas> canvas;
+		std::vector<ColorRGBA> tileColors;
+	};
+
+	/// Minimaps of all map levels, each one is drawn on first use
+	std::vector<LevelMinimap> levels;
+	/// Minimap of current level scaled to size of widget, rescaled only when minimap changes
+	std::unique_ptr<Canvas> scaledMinimap;
+	bool scaledMinimapOutdated = true;
 	int level;
 
+	/// Changes since last rendering, applied in a batch once minimap is shown
+	TileSpanSet pendingTiles;
+	bool pendingFullRedraw = false;
+
 	//get color of selected tile on minimap
 	ColorRGBA getTileColor(const int3 & pos) const;
 
-	void redrawMinimap();
+	/// Returns true if color of tile has changed
+	bool refreshTileColor(LevelMinimap & minimap, const int3 & pos);
+	void redrawLevel(int level);
+	void applyPendingChanges();
+
 public:
 	CMinimapInstance(const Point & position, const Point & dimensions, int level);
 	~CMinimapInstance();
 
 	void showAll(Canvas & to) override;
-	void refreshTile(const int3 & pos);
+	void setLevel(int level);
+
+	/// Schedules redraw of specified tiles
+	void refreshTiles(const TileSpanSet & tiles);
+	/// Schedules redraw of the whole map
+	void refreshAll();
 };
 
 /// Minimap which is displayed at the right upper corner of adventure map
@@ -43,6 +66,9 @@ class CMinimap : public CIntObject
 	Rect screenArea;
 	int level;
 
+	/// minimap was changed and should be redrawn on next frame
+	bool redrawRequested;
+
 	void gesturePanning(const Point & initialPosition, const Point & currentPosition, const Point & lastUpdateDistance) override;
 	void clickPressed(const Point & cursorPosition) override;
 	void showPopupWindow(const Point & cursorPosition) override;
@@ -52,6 +78,9 @@ class CMinimap : public CIntObject
 	/// relocates center of adventure map screen to currently hovered tile
 	void moveAdvMapSelection(const Point & positionGlobal);
 
+	/// returns true if minimap is replaced with shield during turn of other player
+	bool isAIRadarActive() const;
+
 protected:
 	/// computes coordinates of tile below cursor pos
 	int3 pixelToTile(const Point & cursorPos) const;
@@ -66,8 +95,9 @@ public:
 	void update();
 	void setAIRadar(bool on);
 
+	void tick(uint32_t msPassed) override;
 	void showAll(Canvas & to) override;
 
-	void updateTiles(const std::unordered_set<int3> & positions);
+	void updateTiles(const TileSpanSet & positions);
 };
 
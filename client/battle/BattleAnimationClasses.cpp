@@ -124,7 +124,7 @@ void StackActionAnimation::setSound( const AudioPath & sound )
 bool StackActionAnimation::init()
 {
 	if (!sound.empty())
-		CCS->soundh->playSound(sound);
+		CCS->soundh->playSound(sound, 0, true);
 
 	if (myAnim->framesInGroup(currGroup) > 0)
 	{
@@ -358,7 +358,7 @@ bool MovementAnimation::init()
 
 	if (moveSoundHandler == -1)
 	{
-		moveSoundHandler = CCS->soundh->playSound(stack->unitType()->sounds.move, -1);
+		moveSoundHandler = CCS->soundh->playSound(stack->unitType()->sounds.move, -1, true);
 	}
 
 	Point begPosition = owner.stacksController->getStackPositionAtHex(prevHex, stack);
@@ -455,7 +455,7 @@ bool MovementEndAnimation::init()
 	logAnim->debug("CMovementEndAnimation::init: stack %s", stack->getName());
 	myAnim->pos.moveTo(owner.stacksController->getStackPositionAtHex(nextHex, stack));
 
-	CCS->soundh->playSound(stack->unitType()->sounds.endMoving);
+	CCS->soundh->playSound(stack->unitType()->sounds.endMoving, 0, true);
 
 	if(!myAnim->framesInGroup(ECreatureAnimType::MOVE_END))
 	{
@@ -496,7 +496,7 @@ bool MovementStartAnimation::init()
 	}
 
 	logAnim->debug("CMovementStartAnimation::init: stack %s", stack->getName());
-	CCS->soundh->playSound(stack->unitType()->sounds.startMoving);
+	CCS->soundh->playSound(stack->unitType()->sounds.startMoving, 0, true);
 
 	if(!myAnim->framesInGroup(ECreatureAnimType::MOVE_START))
 	{
@@ -851,6 +851,7 @@ void BattleFieldController::tick(uint32_t msPassed)
 	owner.stacksController->tick(msPassed);
 	owner.obstacleController->tick(msPassed);
 	owner.projectilesController->tick(msPassed);
+	owner.preloadCreatureSounds();
 }
 
 void BattleFieldController::show(Canvas & to)
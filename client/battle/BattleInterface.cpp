@@ -37,6 +37,7 @@
 #include "../../CCallback.h"
 #include "../../lib/BattleFieldHandler.h"
 #include "../../lib/CStack.h"
+#include "../../lib/CCreatureHandler.h"
 #include "../../lib/CConfigHandler.h"
 #include "../../lib/texts/CGeneralTextHandler.h"
 #include "../../lib/gameState/InfoAboutArmy.h"
@@ -101,9 +102,30 @@ BattleInterface::BattleInterface(const BattleID & battleID, const CCreatureSet *
 	windowObject->blockUI(true);
 	windowObject->updateQueue();
 
+	std::set<const CCreature *> creatures;
+	for(const CStack * stack : getBattle()->battleGetAllStacks(true))
+		creatures.insert(stack->unitType());
+
+	for(const CCreature * creature : creatures)
+	{
+		const auto & sounds = creature->sounds;
+		for(const auto & sound : { sounds.attack, sounds.defend, sounds.killed, sounds.move, sounds.shoot, sounds.wince, sounds.startMoving, sounds.endMoving })
+			if(!sound.empty())
+				creatureSoundsToPreload.push_back(sound);
+	}
+
 	playIntroSoundAndUnlockInterface();
 }
 
+void BattleInterface::preloadCreatureSounds()
+{
+	if(creatureSoundsToPreload.empty())
+		return;
+
+	CCS->soundh->preloadSound(creatureSoundsToPreload.back());
+	creatureSoundsToPreload.pop_back();
+}
+
 void BattleInterface::playIntroSoundAndUnlockInterface()
 {
 	auto onIntroPlayed = [this]()
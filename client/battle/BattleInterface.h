@@ -120,7 +120,12 @@ class BattleInterface
 
 	void playIntroSoundAndUnlockInterface();
 	void onIntroSoundPlayed();
+	/// sounds of creatures in battle that are not loaded yet
+	std::vector<AudioPath> creatureSoundsToPreload;
 public:
+	/// loads one sound of creatures in battle per call, so sounds are loaded over several frames
+	/// while intro sound is playing, to avoid delays on first action of every creature
+	void preloadCreatureSounds();
 	/// copy of initial armies (for result window)
 	const CCreatureSet *army1;
 	const CCreatureSet *army2;
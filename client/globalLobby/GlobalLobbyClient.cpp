@@ -66,6 +66,18 @@ void GlobalLobbyClient::onPacketReceived(const std::shared_ptr<INetworkConnectio
 	if(json["type"].String() == "activeGameRooms")
 		return receiveActiveGameRooms(json);
 
+	if(json["type"].String() == "accountJoined")
+		return receiveAccountJoined(json);
+
+	if(json["type"].String() == "accountLeft")
+		return receiveAccountLeft(json);
+
+	if(json["type"].String() == "gameRoomChanged")
+		return receiveGameRoomChanged(json);
+
+	if(json["type"].String() == "gameRoomRemoved")
+		return receiveGameRoomRemoved(json);
+
 	if(json["type"].String() == "joinRoomSuccess")
 		return receiveJoinRoomSuccess(json);
 
@@ -111,6 +123,11 @@ void GlobalLobbyClient::receiveClientLoginSuccess(const JsonNode & json)
 	setAccountDisplayName(json["displayName"].String());
 	setAccountCookie(json["accountCookie"].String());
 
+	// full lists of accounts and rooms will follow, after that lobby only needs to send changes
+	JsonNode toSend;
+	toSend["type"].String() = "enableIncrementalUpdates";
+	sendMessage(toSend);
+
 	auto loginWindowPtr = loginWindow.lock();
 
 	if(!loginWindowPtr || !GH.windows().topWindow<GlobalLobbyLoginWindow>())
@@ -176,21 +193,86 @@ void GlobalLobbyClient::receiveChatMessage(const JsonNode & json)
 	}
 }
 
+static GlobalLobbyAccount loadActiveAccount(const JsonNode & jsonEntry)
+{
+	GlobalLobbyAccount account;
+
+	account.accountID = jsonEntry["accountID"].String();
+	account.displayName = jsonEntry["displayName"].String();
+	account.status = jsonEntry["status"].String();
+
+	return account;
+}
+
+static GlobalLobbyRoom loadActiveGameRoom(const JsonNode & jsonEntry)
+{
+	GlobalLobbyRoom room;
+
+	room.gameRoomID = jsonEntry["gameRoomID"].String();
+	room.hostAccountID = jsonEntry["hostAccountID"].String();
+	room.hostAccountDisplayName = jsonEntry["hostAccountDisplayName"].String();
+	room.description = jsonEntry["description"].String();
+	room.statusID = jsonEntry["status"].String();
+	room.gameVersion = jsonEntry["version"].String();
+	room.modList = ModVerificationInfo::jsonDeserializeList(jsonEntry["mods"]);
+	std::chrono::seconds ageSeconds (jsonEntry["ageSeconds"].Integer());
+	room.startDateFormatted = TextOperations::getCurrentFormattedDateTimeLocal(-ageSeconds);
+
+	for(const auto & jsonParticipant : jsonEntry["participants"].Vector())
+	{
+		GlobalLobbyAccount account;
+		account.accountID =  jsonParticipant["accountID"].String();
+		account.displayName =  jsonParticipant["displayName"].String();
+		room.participants.push_back(account);
+	}
+
+	for(const auto & jsonParticipant : jsonEntry["invited"].Vector())
+	{
+		GlobalLobbyAccount account;
+		account.accountID =  jsonParticipant["accountID"].String();
+		account.displayName =  jsonParticipant["displayName"].String();
+		room.invited.push_back(account);
+	}
+
+	room.playerLimit = jsonEntry["playerLimit"].Integer();
+
+	return room;
+}
+
 void GlobalLobbyClient::receiveActiveAccounts(const JsonNode & json)
 {
 	activeAccounts.clear();
 
 	for(const auto & jsonEntry : json["accounts"].Vector())
-	{
-		GlobalLobbyAccount account;
+		activeAccounts.push_back(loadActiveAccount(jsonEntry));
 
-		account.accountID = jsonEntry["accountID"].String();
-		account.displayName = jsonEntry["displayName"].String();
-		account.status = jsonEntry["status"].String();
+	onActiveAccountsChanged();
+}
 
+void GlobalLobbyClient::receiveAccountJoined(const JsonNode & json)
+{
+	GlobalLobbyAccount account = loadActiveAccount(json["account"]);
+
+	auto existing = boost::range::find_if(activeAccounts, [&](const GlobalLobbyAccount & entry){ return entry.accountID == account.accountID; });
+	if(existing != activeAccounts.end())
+		*existing = account;
+	else
 		activeAccounts.push_back(account);
-	}
 
+	onActiveAccountsChanged();
+}
+
+void GlobalLobbyClient::receiveAccountLeft(const JsonNode & json)
+{
+	std::string accountID = json["accountID"].String();
+
+	vstd::erase_if(activeAccounts, [&](const GlobalLobbyAccount & entry){ return entry.accountID == accountID; });
+
+	onActiveAccountsChanged();
+}
+
+void GlobalLobbyClient::onActiveAccountsChanged()
+{
 	auto lobbyWindowPtr = lobbyWindow.lock();
 	if(lobbyWindowPtr)
 		lobbyWindowPtr->onActiveAccounts(activeAccounts);
@@ -204,40 +286,35 @@ void GlobalLobbyClient::receiveActiveGameRooms(const JsonNode & json)
 	activeRooms.clear();
 
 	for(const auto & jsonEntry : json["gameRooms"].Vector())
-	{
-		GlobalLobbyRoom room;
+		activeRooms.push_back(loadActiveGameRoom(jsonEntry));
 
-		room.gameRoomID = jsonEntry["gameRoomID"].String();
-		room.hostAccountID = jsonEntry["hostAccountID"].String();
-		room.hostAccountDisplayName = jsonEntry["hostAccountDisplayName"].String();
-		room.description = jsonEntry["description"].String();
-		room.statusID = jsonEntry["status"].String();
-		room.gameVersion = jsonEntry["version"].String();
-		room.modList = ModVerificationInfo::jsonDeserializeList(jsonEntry["mods"]);
-		std::chrono::seconds ageSeconds (jsonEntry["ageSeconds"].Integer());
-		room.startDateFormatted = TextOperations::getCurrentFormattedDateTimeLocal(-ageSeconds);
+	onActiveGameRoomsChanged();
+}
 
-		for(const auto & jsonParticipant : jsonEntry["participants"].Vector())
-		{
-			GlobalLobbyAccount account;
-			account.accountID =  jsonParticipant["accountID"].String();
-			account.displayName =  jsonParticipant["displayName"].String();
-			room.participants.push_back(account);
-		}
+void GlobalLobbyClient::receiveGameRoomChanged(const JsonNode & json)
+{
+	GlobalLobbyRoom room = loadActiveGameRoom(json["gameRoom"]);
 
-		for(const auto & jsonParticipant : jsonEntry["invited"].Vector())
-		{
-			GlobalLobbyAccount account;
-			account.accountID =  jsonParticipant["accountID"].String();
-			account.displayName =  jsonParticipant["displayName"].String();
-			room.invited.push_back(account);
-		}
+	auto existing = boost::range::find_if(activeRooms, [&](const GlobalLobbyRoom & entry){ return entry.gameRoomID == room.gameRoomID; });
+	if(existing != activeRooms.end())
+		*existing = room;
+	else
+		activeRooms.insert(activeRooms.begin(), room); // list is sorted from newest to oldest room
 
-		room.playerLimit = jsonEntry["playerLimit"].Integer();
+	onActiveGameRoomsChanged();
+}
 
-		activeRooms.push_back(room);
-	}
+void GlobalLobbyClient::receiveGameRoomRemoved(const JsonNode & json)
+{
+	std::string gameRoomID = json["gameRoomID"].String();
 
+	vstd::erase_if(activeRooms, [&](const GlobalLobbyRoom & entry){ return entry.gameRoomID == gameRoomID; });
+
+	onActiveGameRoomsChanged();
+}
+
+void GlobalLobbyClient::onActiveGameRoomsChanged()
+{
 	auto lobbyWindowPtr = lobbyWindow.lock();
 	if(lobbyWindowPtr)
 		lobbyWindowPtr->onActiveGameRooms(activeRooms);
@@ -52,10 +52,17 @@ class GlobalLobbyClient final : public INetworkClientListener, boost::noncopyabl
 	void receiveChatMessage(const JsonNode & json);
 	void receiveActiveAccounts(const JsonNode & json);
 	void receiveActiveGameRooms(const JsonNode & json);
+	void receiveAccountJoined(const JsonNode & json);
+	void receiveAccountLeft(const JsonNode & json);
+	void receiveGameRoomChanged(const JsonNode & json);
+	void receiveGameRoomRemoved(const JsonNode & json);
 	void receiveMatchesHistory(const JsonNode & json);
 	void receiveJoinRoomSuccess(const JsonNode & json);
 	void receiveInviteReceived(const JsonNode & json);
 
+	void onActiveAccountsChanged();
+	void onActiveGameRoomsChanged();
+
 	std::shared_ptr<GlobalLobbyLoginWindow> createLoginWindow();
 	std::shared_ptr<GlobalLobbyWindow> createLobbyWindow();
 
@@ -21,11 +21,13 @@
 #include "../CGameInfo.h"
 #include "../adventureMap/AdventureMapInterface.h"
 #include "../render/Colors.h"
+#include "../render/DirtyRegion.h"
 #include "../render/Graphics.h"
 #include "../render/IFont.h"
 #include "../render/EFont.h"
 #include "../renderSDL/ScreenHandler.h"
 #include "../renderSDL/RenderHandler.h"
+#include "../renderSDL/SDL_Extensions.h"
 #include "../CMT.h"
 #include "../CPlayerInterface.h"
 #include "../battle/BattleInterface.h"
@@ -101,21 +103,41 @@ void CGuiHandler::renderFrame()
 		if (nullptr != curInt)
 			curInt->update();
 
+		if (settings["video"]["showRedrawStats"].Bool())
+			drawRedrawStats();
+
 		if (settings["video"]["showfps"].Bool())
 			drawFPSCounter();
 
-		SDL_UpdateTexture(screenTexture, nullptr, screen->pixels, screen->pitch);
+		// only upload parts of screen that were changed during this frame
+		Rect screenArea(0, 0, screen->w, screen->h);
+		for (const auto & area : windows().getScreenChanges().getAreas())
+		{
+			SDL_Rect sdlArea = CSDL_Ext::toSDL(area.intersect(screenArea));
+			const auto * pixels = static_cast<const uint8_t *>(screen->pixels) + sdlArea.y * screen->pitch + sdlArea.x * screen->format->BytesPerPixel;
+
+			if (sdlArea.w > 0 && sdlArea.h > 0)
+				SDL_UpdateTexture(screenTexture, &sdlArea, pixels, screen->pitch);
+		}
+
+		// dirty region must be reset while still holding the lock, otherwise changes drawn
+		// by other threads between upload and reset would never reach the screen
+		windows().onFrameRendered();
 	}
 
 	SDL_RenderClear(mainRenderer);
+
+	{
+		boost::mutex::scoped_lock interfaceLock(GH.interfaceMutex);
+		screenHandler().renderUnderlays();
+	}
+
 	SDL_RenderCopy(mainRenderer, screenTexture, nullptr, nullptr);
 
 	{
 		boost::mutex::scoped_lock interfaceLock(GH.interfaceMutex);
 
 		CCS->curh->render();
-
-		windows().onFrameRendered();
 	}
 
 	SDL_RenderPresent(mainRenderer);
@@ -194,6 +216,29 @@ void CGuiHandler::drawFPSCounter()
 
 	const auto & font = GH.renderHandler().loadFont(FONT_SMALL);
 	font->renderTextLeft(screen, fps, Colors::WHITE, Point(8 * scaling, screen->h-22 * scaling));
+	windows().invalidateScreenArea(Rect(overlay.x, overlay.y, overlay.w, overlay.h));
+}
+
+void CGuiHandler::drawRedrawStats()
+{
+	// measured before overlays are drawn, so only changes made by windows are counted
+	double screenArea = static_cast<double>(screen->w) * screen->h;
+	double redrawnArea = windows().getScreenChanges().getTotalArea();
+
+	int scaling = screenHandlerInstance->getScalingFactor();
+	int x = 57 * scaling;
+	int y = screen->h-20 * scaling;
+	int widthIncludingPadding = 90 * scaling;
+	int heightIncludingPadding = 11 * scaling;
+	SDL_Rect overlay = { x, y, widthIncludingPadding, heightIncludingPadding};
+	uint32_t black = SDL_MapRGB(screen->format, 10, 10, 10);
+	SDL_FillRect(screen, &overlay, black);
+
+	std::string text = "Redrawn: " + std::to_string(static_cast<int>(std::round(100 * redrawnArea / screenArea))) + "%";
+
+	const auto & font = GH.renderHandler().loadFont(FONT_SMALL);
+	font->renderTextLeft(screen, text, Colors::WHITE, Point(58 * scaling, screen->h-22 * scaling));
+	windows().invalidateScreenArea(Rect(overlay.x, overlay.y, overlay.w, overlay.h));
 }
 
 bool CGuiHandler::amIGuiThread()
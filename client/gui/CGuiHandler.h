@@ -104,6 +104,7 @@ public:
 	void handleEvents(); //takes events from queue and calls interested objects
 	void fakeMouseMove();
 	void drawFPSCounter(); // draws the FPS to the upper left corner of the screen
+	void drawRedrawStats(); // draws percentage of screen area that was changed on this frame next to FPS counter
 
 	bool amIGuiThread();
 
@@ -238,15 +238,15 @@ void CIntObject::redraw()
 		}
 		else
 		{
-			Canvas buffer = Canvas::createFromSurface(screenBuf, CanvasScalingPolicy::AUTO);
-
-			showAll(buffer);
 			if(screenBuf != screen)
 			{
-				Canvas screenBuffer = Canvas::createFromSurface(screen, CanvasScalingPolicy::AUTO);
+				Canvas buffer = Canvas::createFromSurface(screenBuf, CanvasScalingPolicy::AUTO);
 
-				showAll(screenBuffer);
+				showAll(buffer);
 			}
+
+			Canvas screenBuffer = GH.windows().createScreenCanvas();
+			showAll(screenBuffer);
 		}
 	}
 }
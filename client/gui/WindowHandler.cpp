@@ -116,6 +116,7 @@ void WindowHandler::totalRedrawImpl()
 	for(auto & elem : windowsStack)
 		elem->showAll(target);
 	CSDL_Ext::blitAt(screen2, 0, 0, screen);
+	invalidateScreenArea(Rect(0, 0, screen->w, screen->h));
 }
 
 void WindowHandler::simpleRedraw()
@@ -131,10 +132,15 @@ void WindowHandler::simpleRedraw()
 void WindowHandler::simpleRedrawImpl()
 {
 	//update only top interface and draw background
+	//top window may only change areas that were modified on previous frame, so background only needs to be restored there
 	if(windowsStack.size() > 1)
-		CSDL_Ext::blitAt(screen2, 0, 0, screen); //blit background
+	{
+		for(const auto & area : previousFrameChanges.getAreas())
+			CSDL_Ext::blitSurface(screen2, area, screen, area.topLeft());
+		currentFrameChanges.add(previousFrameChanges);
+	}
 
-	Canvas target = Canvas::createFromSurface(screen, CanvasScalingPolicy::AUTO);
+	Canvas target = createScreenCanvas();
 
 	if(!windowsStack.empty())
 		windowsStack.back()->show(target); //blit active interface/window
@@ -148,9 +154,29 @@ void WindowHandler::onScreenResize()
 	totalRedraw();
 }
 
+Canvas WindowHandler::createScreenCanvas()
+{
+	Canvas result = Canvas::createFromSurface(screen, CanvasScalingPolicy::AUTO);
+	result.trackChanges(&currentFrameChanges);
+	return result;
+}
+
+void WindowHandler::invalidateScreenArea(const Rect & area)
+{
+	currentFrameChanges.add(area);
+}
+
+const DirtyRegion & WindowHandler::getScreenChanges() const
+{
+	return currentFrameChanges;
+}
+
 void WindowHandler::onFrameRendered()
 {
 	disposed.clear();
+
+	std::swap(previousFrameChanges, currentFrameChanges);
+	currentFrameChanges.clear();
 }
 
 size_t WindowHandler::count() const
@@ -9,7 +9,10 @@
  */
 #pragma once
 
+#include "../render/DirtyRegion.h"
+
 class IShowActivatable;
+class Canvas;
 
 class WindowHandler
 {
@@ -22,6 +25,12 @@ class WindowHandler
 
 	bool totalRedrawRequested = false;
 
+	/// Areas of screen that were modified during current frame and must be presented
+	DirtyRegion currentFrameChanges;
+
+	/// Areas of screen that were modified during previous frame. Must be restored from background before top window is updated
+	DirtyRegion previousFrameChanges;
+
 	/// returns top windows
 	std::shared_ptr<IShowActivatable> topWindowImpl() const;
 
@@ -65,7 +74,16 @@ public:
 	template <typename T>
 	std::shared_ptr<T> topWindow() const;
 
-	/// should be called after frame has been rendered to screen
+	/// returns canvas for drawing onto screen. All changes made via this canvas will be presented on next frame
+	Canvas createScreenCanvas();
+
+	/// marks area of screen, in screen pixels, that was modified without using screen canvas
+	void invalidateScreenArea(const Rect & area);
+
+	/// returns areas of screen, in screen pixels, that were modified during current frame
+	const DirtyRegion & getScreenChanges() const;
+
+	/// should be called once changes of current frame were taken for presenting, under the same interface lock
 	void onFrameRendered();
 
 	/// returns current number of windows in the stack
@@ -0,0 +1,267 @@
+/*
+ * MapInfoIndex.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "MapInfoIndex.h"
+
+#include "SelectionTab.h"
+
+#include "../../lib/StartInfo.h"
+#include "../../lib/campaign/CampaignState.h"
+#include "../../lib/filesystem/Filesystem.h"
+#include "../../lib/mapping/CMapHeader.h"
+#include "../../lib/rmg/CMapGenOptions.h"
+#include "../../lib/serializer/CLoadFile.h"
+#include "../../lib/serializer/CSaveFile.h"
+#include "../../lib/texts/CGeneralTextHandler.h"
+#include "../../lib/VCMIDirs.h"
+
+#include <tbb/parallel_for_each.h>
+
+static const std::string INDEX_MAGIC = "VCMIMAPINDEX3";
+
+namespace
+{
+/// Serialized header of a single file. Each header is stored in index as a separate blob,
+/// so damaged entry can be skipped without discarding the rest of index
+class EntryData final : public IBinaryReader, public IBinaryWriter
+{
+	std::string & data;
+	size_t readPos = 0;
+
+public:
+	explicit EntryData(std::string & data)
+		: data(data)
+	{
+	}
+
+	int read(std::byte * destination, unsigned size) override
+	{
+		if(data.size() < readPos + size)
+			throw std::runtime_error("Unexpected end of map header data");
+
+		std::copy_n(reinterpret_cast<const std::byte *>(data.data()) + readPos, size, destination);
+		readPos += size;
+		return size;
+	}
+
+	int write(const std::byte * source, unsigned size) override
+	{
+		data.append(reinterpret_cast<const char *>(source), size);
+		return size;
+	}
+};
+
+std::string serializeInfo(const ElementInfo & info)
+{
+	std::string data;
+	EntryData entryData(data);
+	BinarySerializer serializer(&entryData);
+
+	int64_t lastWrite = info.lastWrite;
+	serializer & info.originalFileURI & info.fullFileURI & lastWrite;
+	serializer & static_cast<const CMapInfo &>(info);
+	return data;
+}
+
+std::shared_ptr<ElementInfo> deserializeInfo(std::string & data)
+{
+	EntryData entryData(data);
+	BinaryDeserializer deserializer(&entryData);
+	deserializer.version = ESerializationVersion::CURRENT;
+
+	auto info = std::make_shared<ElementInfo>();
+	int64_t lastWrite = 0;
+	deserializer & info->originalFileURI & info->fullFileURI & lastWrite;
+	deserializer & static_cast<CMapInfo &>(*info);
+	info->lastWrite = lastWrite;
+	info->name = info->getNameForList();
+	return info;
+}
+}
+
+MapInfoIndex::MapInfoIndex()
+	: indexPath(VCMIDirs::get().userCachePath() / "mapInfoIndex.bin")
+{
+}
+
+MapInfoIndex & MapInfoIndex::get()
+{
+	static MapInfoIndex instance;
+	return instance;
+}
+
+void MapInfoIndex::loadIndex()
+{
+	loaded = true;
+
+	if(!boost::filesystem::exists(indexPath))
+		return;
+
+	try
+	{
+		CLoadFile file(indexPath);
+		file.checkMagicBytes(INDEX_MAGIC);
+
+		// translated names are stored in index, so it is only valid for language that was used to create it
+		std::string language;
+		file >> language;
+		if(language != CGeneralTextHandler::getPreferredLanguage())
+			return;
+
+		uint32_t size = 0;
+		file >> size;
+
+		for(uint32_t i = 0; i < size; ++i)
+		{
+			std::string key;
+			Entry entry;
+
+			file >> key >> entry.fileSize >> entry.lastWrite >> entry.data;
+
+			// file was removed since index was written
+			boost::system::error_code ec;
+			if(!boost::filesystem::exists(key, ec))
+			{
+				modified = true;
+				continue;
+			}
+
+			entries[key] = std::move(entry);
+		}
+	}
+	catch(const std::exception & e)
+	{
+		// entries that were read successfully before the failure are kept
+		logGlobal->warn("Failed to read index of map headers: %s", e.what());
+		modified = true;
+	}
+}
+
+void MapInfoIndex::saveIndex()
+{
+	if(!modified)
+		return;
+
+	// write into temporary file first, so other running game instances will never see partially written index
+	const auto temporaryPath = boost::filesystem::path(indexPath).replace_extension(".tmp");
+	boost::system::error_code ec;
+
+	try
+	{
+		CSaveFile file(temporaryPath);
+		file.putMagicBytes(INDEX_MAGIC);
+
+		file << CGeneralTextHandler::getPreferredLanguage();
+		file << static_cast<uint32_t>(entries.size());
+
+		for(const auto & [key, entry] : entries)
+			file << key << entry.fileSize << entry.lastWrite << entry.data;
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->warn("Failed to save index of map headers: %s", e.what());
+		boost::filesystem::remove(temporaryPath, ec);
+		return;
+	}
+
+	boost::filesystem::rename(temporaryPath, indexPath, ec);
+	if(ec)
+		boost::filesystem::remove(temporaryPath, ec);
+
+	modified = false;
+}
+
+void MapInfoIndex::scan(const std::unordered_set<ResourcePath> & files, const Initializer & initializer, const Receiver & receiver, const std::atomic<bool> & cancelled)
+{
+	std::lock_guard scanLock(scanMutex);
+
+	if(!loaded)
+		loadIndex();
+
+	std::vector<std::pair<ResourcePath, std::string>> outdatedFiles;
+
+	for(const auto & file : files)
+	{
+		if(cancelled)
+			return;
+
+		auto physicalPath = CResourceHandler::get()->getResourceName(file);
+		if(!physicalPath)
+			continue;
+
+		std::string key = physicalPath->string();
+		boost::system::error_code ec;
+		int64_t fileSize = boost::filesystem::file_size(*physicalPath, ec);
+		int64_t lastWrite = boost::filesystem::last_write_time(*physicalPath, ec);
+
+		auto it = entries.find(key);
+		if(ec || it == entries.end() || it->second.fileSize != fileSize || it->second.lastWrite != lastWrite)
+		{
+			outdatedFiles.emplace_back(file, key);
+			continue;
+		}
+
+		// every call gets its own copy of header, receivers are free to modify it
+		try
+		{
+			receiver(deserializeInfo(it->second.data));
+		}
+		catch(const std::exception & e)
+		{
+			logGlobal->warn("Discarding indexed header of %s: %s", key, e.what());
+			outdatedFiles.emplace_back(file, key);
+		}
+	}
+
+	if(outdatedFiles.empty())
+	{
+		saveIndex();
+		return;
+	}
+
+	logGlobal->debug("Loading %d headers, %d taken from index", outdatedFiles.size(), files.size() - outdatedFiles.size());
+
+	tbb::parallel_for_each(outdatedFiles.begin(), outdatedFiles.end(), [&](const std::pair<ResourcePath, std::string> & file)
+	{
+		if(cancelled)
+			return;
+
+		auto info = std::make_shared<ElementInfo>();
+
+		try
+		{
+			initializer(*info, file.first);
+		}
+		catch(const std::exception & e)
+		{
+			logGlobal->error("Failed to process %s: %s", file.first.getName(), e.what());
+			return;
+		}
+
+		// header must be serialized before receiver gets it, since receiver may modify it
+		Entry entry;
+		entry.data = serializeInfo(*info);
+		receiver(info);
+
+		boost::system::error_code ec;
+		entry.fileSize = boost::filesystem::file_size(file.second, ec);
+		entry.lastWrite = boost::filesystem::last_write_time(file.second, ec);
+
+		if(!ec)
+		{
+			std::lock_guard lock(entriesMutex);
+			entries[file.second] = std::move(entry);
+			modified = true;
+		}
+	});
+
+	// headers loaded before cancellation are still stored
+	saveIndex();
+}
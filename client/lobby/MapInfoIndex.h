@@ -0,0 +1,54 @@
+/*
+ * MapInfoIndex.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+class ResourcePath;
+VCMI_LIB_NAMESPACE_END
+
+class ElementInfo;
+
+/// Persistent index of map, campaign and saved game headers shown in scenario selection, stored in user cache directory
+/// Entries are keyed by path to file and discarded once size or modification time of the file changes,
+/// entries of files that no longer exist are removed from index when it is loaded
+class MapInfoIndex : boost::noncopyable
+{
+	struct Entry
+	{
+		int64_t fileSize = 0;
+		int64_t lastWrite = 0;
+		/// Serialized header, every scan creates new header from it
+		std::string data;
+	};
+
+	boost::filesystem::path indexPath;
+	std::map<std::string, Entry> entries;
+	std::mutex entriesMutex;
+	std::mutex scanMutex;
+
+	bool loaded = false;
+	bool modified = false;
+
+	void loadIndex();
+	void saveIndex();
+
+	MapInfoIndex();
+public:
+	using Initializer = std::function<void(ElementInfo & info, const ResourcePath & file)>;
+	using Receiver = std::function<void(const std::shared_ptr<ElementInfo> & info)>;
+
+	static MapInfoIndex & get();
+
+	/// Passes headers of all provided files to receiver as soon as each of them is available. Headers from index are
+	/// passed first, headers that are missing from index or outdated are loaded in parallel using provided initializer.
+	/// Files that failed to load are skipped. Every header is passed as a new object that is not shared with index.
+	/// May be called from any thread, loading stops once cancelled is set
+	void scan(const std::unordered_set<ResourcePath> & files, const Initializer & initializer, const Receiver & receiver, const std::atomic<bool> & cancelled);
+};
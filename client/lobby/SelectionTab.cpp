@@ -12,6 +12,7 @@
 #include "SelectionTab.h"
 #include "CSelectionBase.h"
 #include "CLobbyScreen.h"
+#include "MapInfoIndex.h"
 
 #include "../CGameInfo.h"
 #include "../CPlayerInterface.h"
@@ -36,6 +37,7 @@
 #include "../../CCallback.h"
 
 #include "../../lib/CConfigHandler.h"
+#include "../../lib/CThreadHelper.h"
 #include "../../lib/IGameSettings.h"
 #include "../../lib/filesystem/Filesystem.h"
 #include "../../lib/campaign/CampaignState.h"
@@ -154,7 +156,7 @@ static ESortBy getSortBySelectionScreen(ESelectionScreen Type)
 }
 
 SelectionTab::SelectionTab(ESelectionScreen Type)
-	: CIntObject(LCLICK | SHOW_POPUP | KEYBOARD | DOUBLECLICK), callOnSelect(nullptr), tabType(Type), selectionPos(0), sortModeAscending(true), inputNameRect{32, 539, 350, 20}, curFolder(""), currentMapSizeFilter(0), showRandom(false), deleteMode(false)
+	: CIntObject(LCLICK | SHOW_POPUP | KEYBOARD | DOUBLECLICK | TIME), callOnSelect(nullptr), tabType(Type), selectionPos(0), sortModeAscending(true), inputNameRect{32, 539, 350, 20}, curFolder(""), currentMapSizeFilter(0), showRandom(false), deleteMode(false)
 {
 	OBJECT_CONSTRUCTION;
 		
@@ -259,8 +261,14 @@ SelectionTab::SelectionTab(ESelectionScreen Type)
 	filter(0);
 }
 
+SelectionTab::~SelectionTab()
+{
+	stopScan();
+}
+
 void SelectionTab::toggleMode()
 {
+	stopScan();
 	allItems.clear();
 	curItems.clear();
 	if(CSH->isGuest())
@@ -284,8 +292,7 @@ void SelectionTab::toggleMode()
 		case ESelectionScreen::loadGame:
 			{
 				inputName->disable();
-				auto unsupported = parseSaves(getFiles("Saves/", EResType::SAVEGAME));
-				handleUnsupportedSavegames(unsupported);
+				parseSaves(getFiles("Saves/", EResType::SAVEGAME));
 				break;
 			}
 
@@ -293,7 +300,6 @@ void SelectionTab::toggleMode()
 			parseSaves(getFiles("Saves/", EResType::SAVEGAME));
 			inputName->enable();
 			inputName->activate();
-			restoreLastSelection();
 			break;
 
 		case ESelectionScreen::campaignList:
@@ -315,6 +321,10 @@ void SelectionTab::toggleMode()
 			CSH->setCampaignState(CSH->campaignStateToSend);
 			CSH->campaignStateToSend.reset();
 		}
+		else if(scanThread.joinable())
+		{
+			restoreSelectionAfterScan = true;
+		}
 		else
 		{
 			restoreLastSelection();
@@ -630,6 +640,8 @@ void SelectionTab::select(int position)
 	if(!curItems.size())
 		return;
 
+	restoreSelectionAfterScan = false;
+
 	// New selection. py is the index in curItems.
 	int py = position + slider->getValue();
 	vstd::amax(py, 0);
@@ -860,79 +872,67 @@ bool SelectionTab::isMapSupported(const CMapInfo & info)
 void SelectionTab::parseMaps(const std::unordered_set<ResourcePath> & files)
 {
 	logGlobal->debug("Parsing %d maps", files.size());
-	allItems.clear();
-	for(auto & file : files)
-	{
-		try
-		{
-			auto mapInfo = std::make_shared<ElementInfo>();
-			mapInfo->mapInit(file.getOriginalName());
-			mapInfo->name = mapInfo->getNameForList();
 
-			if (isMapSupported(*mapInfo))
-				allItems.push_back(mapInfo);
-		}
-		catch(std::exception & e)
-		{
-			logGlobal->error("Map %s is invalid. Message: %s", file.getName(), e.what());
-		}
-	}
+	startScan(files, [](ElementInfo & info, const ResourcePath & file)
+	{
+		info.mapInit(file.getOriginalName());
+		info.name = info.getNameForList();
+	}, [this](ElementInfo & info)
+	{
+		return isMapSupported(info);
+	});
 }
 
-std::vector<ResourcePath> SelectionTab::parseSaves(const std::unordered_set<ResourcePath> & files)
+void SelectionTab::parseSaves(const std::unordered_set<ResourcePath> & files)
 {
-	std::vector<ResourcePath> unsupported;
-
-	for(auto & file : files)
+	startScan(files, [this](ElementInfo & info, const ResourcePath & file)
 	{
 		try
 		{
-			auto mapInfo = std::make_shared<ElementInfo>();
-			mapInfo->saveInit(file);
-			mapInfo->name = mapInfo->getNameForList();
-
-			// Filter out other game modes
-			bool isCampaign = mapInfo->scenarioOptionsOfSave->mode == EStartMode::CAMPAIGN;
-			bool isMultiplayer = mapInfo->amountOfHumanPlayersInSave > 1;
-			bool isTutorial = boost::to_upper_copy(mapInfo->scenarioOptionsOfSave->mapname) == "MAPS/TUTORIAL";
-			switch(CSH->getLoadMode())
-			{
-			case ELoadMode::SINGLE:
-				if(isCampaign || isTutorial)
-					mapInfo->mapHeader.reset();
-				break;
-			case ELoadMode::CAMPAIGN:
-				if(!isCampaign)
-					mapInfo->mapHeader.reset();
-				break;
-			case ELoadMode::TUTORIAL:
-				if(!isTutorial)
-					mapInfo->mapHeader.reset();
-				break;
-			case ELoadMode::MULTI:
-				if(!isMultiplayer)
-					mapInfo->mapHeader.reset();
-				break;
-			default:
-				assert(0);
-				mapInfo->mapHeader.reset();
-				break;
-			}
-
-			allItems.push_back(mapInfo);
+			info.saveInit(file);
+			info.name = info.getNameForList();
 		}
-		catch(const IdentifierResolutionException & e)
+		catch(const IdentifierResolutionException &)
 		{
-			logGlobal->error("Error: Failed to process %s: %s", file.getName(), e.what());
+			throw; // not relevant -> not ask to delete, when mods are disabled
 		}
-		catch(const std::exception & e)
+		catch(const std::exception &)
 		{
-			unsupported.push_back(file); // IdentifierResolutionException is not relevant -> not ask to delete, when mods are disabled
-			logGlobal->error("Error: Failed to process %s: %s", file.getName(), e.what());
+			std::lock_guard lock(scannedItemsMutex);
+			unsupportedSaves.push_back(file);
+			throw;
 		}
-	}
-
-	return unsupported;
+	}, [](ElementInfo & info)
+	{
+		// Filter out other game modes
+		bool isCampaign = info.scenarioOptionsOfSave->mode == EStartMode::CAMPAIGN;
+		bool isMultiplayer = info.amountOfHumanPlayersInSave > 1;
+		bool isTutorial = boost::to_upper_copy(info.scenarioOptionsOfSave->mapname) == "MAPS/TUTORIAL";
+		switch(CSH->getLoadMode())
+		{
+		case ELoadMode::SINGLE:
+			if(isCampaign || isTutorial)
+				info.mapHeader.reset();
+			break;
+		case ELoadMode::CAMPAIGN:
+			if(!isCampaign)
+				info.mapHeader.reset();
+			break;
+		case ELoadMode::TUTORIAL:
+			if(!isTutorial)
+				info.mapHeader.reset();
+			break;
+		case ELoadMode::MULTI:
+			if(!isMultiplayer)
+				info.mapHeader.reset();
+			break;
+		default:
+			assert(0);
+			info.mapHeader.reset();
+			break;
+		}
+		return true;
+	});
 }
 
 void SelectionTab::handleUnsupportedSavegames(const std::vector<ResourcePath> & files)
@@ -958,36 +958,158 @@ void SelectionTab::parseCampaigns(const std::unordered_set<ResourcePath> & files
 	auto campaignSets = JsonNode(JsonPath::builtin("config/campaignSets.json"));
 	auto mainmenu = JsonNode(JsonPath::builtin("config/mainmenu.json"));
 
-	allItems.reserve(files.size());
-	for(auto & file : files)
+	startScan(files, [](ElementInfo & info, const ResourcePath & file)
+	{
+		info.fileURI = file.getOriginalName();
+		info.campaignInit();
+		info.name = info.getNameForList();
+	}, [campaignSets, mainmenu](ElementInfo & info)
+	{
+		if(!info.campaign)
+			return false;
+
+		ResourcePath file(info.fileURI, EResType::CAMPAIGN);
+
+		// skip campaigns organized in sets
+		std::string foundInSet = "";
+		for (auto const & set : campaignSets.Struct())
+			for (auto const & item : set.second["items"].Vector())
+				if(file.getName() == ResourcePath(item["file"].String()).getName())
+					foundInSet = set.first;
+
+		// set has to be used in main menu
+		bool setInMainmenu = false;
+		if(!foundInSet.empty())
+			for (auto const & item : mainmenu["window"]["items"].Vector())
+				if(item["name"].String() == "campaign")
+					for (auto const & button : item["buttons"].Vector())
+						if(boost::algorithm::ends_with(boost::algorithm::to_lower_copy(button["command"].String()), boost::algorithm::to_lower_copy(foundInSet)))
+							setInMainmenu = true;
+
+		return !setInMainmenu;
+	});
+}
+
+void SelectionTab::startScan(const std::unordered_set<ResourcePath> & files, const std::function<void(ElementInfo &, const ResourcePath &)> & initializer, const std::function<bool(ElementInfo &)> & itemsFilter)
+{
+	scannedItemsFilter = itemsFilter;
+	timeSinceScanUpdate = 0;
+	scanFinished = false;
+
+	scanThread = boost::thread([this, files, initializer]()
 	{
-		auto info = std::make_shared<ElementInfo>();
-		info->fileURI = file.getOriginalName();
-		info->campaignInit();
-		info->name = info->getNameForList();
-				
-		if(info->campaign)
+		setThreadName("mapHeadersScan");
+
+		MapInfoIndex::get().scan(files, initializer, [this](const std::shared_ptr<ElementInfo> & info)
 		{
-			// skip campaigns organized in sets
-			std::string foundInSet = "";
-			for (auto const & set : campaignSets.Struct())
-				for (auto const & item : set.second["items"].Vector())
-					if(file.getName() == ResourcePath(item["file"].String()).getName())
-						foundInSet = set.first;
-			
-			// set has to be used in main menu
-			bool setInMainmenu = false;
-			if(!foundInSet.empty())
-				for (auto const & item : mainmenu["window"]["items"].Vector())
-					if(item["name"].String() == "campaign")
-						for (auto const & button : item["buttons"].Vector())
-							if(boost::algorithm::ends_with(boost::algorithm::to_lower_copy(button["command"].String()), boost::algorithm::to_lower_copy(foundInSet)))
-								setInMainmenu = true;
-
-			if(!setInMainmenu)
-				allItems.push_back(info);
-		}
+			std::lock_guard lock(scannedItemsMutex);
+			scannedItems.push_back(info);
+		}, scanCancelled);
+
+		scanFinished = true;
+	});
+}
+
+void SelectionTab::stopScan()
+{
+	scanCancelled = true;
+	if(scanThread.joinable())
+		scanThread.join();
+	scanCancelled = false;
+	scanFinished = true;
+	restoreSelectionAfterScan = false;
+
+	std::lock_guard lock(scannedItemsMutex);
+	scannedItems.clear();
+	unsupportedSaves.clear();
+}
+
+void SelectionTab::tick(uint32_t msPassed)
+{
+	// list is sorted again on every update, so new items are added in intervals and not on every frame
+	constexpr uint32_t scanUpdateInterval = 250;
+
+	if(!scanThread.joinable())
+		return;
+
+	bool finished = scanFinished;
+	timeSinceScanUpdate += msPassed;
+	if(!finished && timeSinceScanUpdate < scanUpdateInterval)
+		return;
+
+	timeSinceScanUpdate = 0;
+	addScannedItems();
+
+	if(finished)
+	{
+		scanThread.join();
+		if(restoreSelectionAfterScan)
+			restoreLastSelection();
+
+		std::vector<ResourcePath> unsupported;
+		std::swap(unsupported, unsupportedSaves);
+		if(tabType == ESelectionScreen::loadGame)
+			handleUnsupportedSavegames(unsupported);
+	}
+}
+
+void SelectionTab::addScannedItems()
+{
+	std::vector<std::shared_ptr<ElementInfo>> newItems;
+	{
+		std::lock_guard lock(scannedItemsMutex);
+		std::swap(newItems, scannedItems);
+	}
+
+	// newest save can only be selected once all saves are known
+	std::string lastSelection;
+	if(tabType == ESelectionScreen::newGame)
+		lastSelection = boost::to_upper_copy(settings["general"]["lastMap"].String());
+	if(tabType == ESelectionScreen::campaignList)
+		lastSelection = boost::to_upper_copy(settings["general"]["lastCampaign"].String());
+	if(tabType == ESelectionScreen::saveGame)
+		lastSelection = boost::to_upper_copy(settings["general"]["lastSave"].String());
+
+	bool lastSelectionFound = false;
+	size_t oldItemsCount = allItems.size();
+
+	for(auto & item : newItems)
+	{
+		if(!scannedItemsFilter(*item))
+			continue;
+
+		allItems.push_back(item);
+		if(!lastSelection.empty() && boost::to_upper_copy(item->fileURI) == lastSelection)
+			lastSelectionFound = true;
+	}
+
+	if(allItems.size() == oldItemsCount)
+		return;
+
+	if(restoreSelectionAfterScan && lastSelectionFound)
+	{
+		restoreLastSelection();
+		return;
 	}
+
+	// keep selection on the same item, without selecting it again
+	auto selected = curItems.empty() ? nullptr : curItems[selectionPos];
+	filter(-1);
+
+	if(!selected || curItems.empty())
+		return;
+
+	auto it = boost::range::find_if(curItems, [&selected](const std::shared_ptr<ElementInfo> & e)
+	{
+		return e == selected || (e->isFolder && selected->isFolder && e->folderName == selected->folderName);
+	});
+	if(it != curItems.end())
+		selectionPos = it - curItems.begin();
+	else
+		vstd::amin(selectionPos, curItems.size() - 1);
+
+	updateListItems();
+	redraw();
 }
 
 std::unordered_set<ResourcePath> SelectionTab::getFiles(std::string dirURI, EResType resType)
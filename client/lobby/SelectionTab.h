@@ -90,12 +90,14 @@ public:
 	std::shared_ptr<CTextInput> inputName;
 
 	SelectionTab(ESelectionScreen Type);
+	~SelectionTab();
 	void toggleMode();
 
 	void clickReleased(const Point & cursorPosition) override;
 	void keyPressed(EShortcut key) override;
 	void clickDouble(const Point & cursorPosition) override;
 	void showPopupWindow(const Point & cursorPosition) override;
+	void tick(uint32_t msPassed) override;
 	bool receiveEvent(const Point & position, int eventType) const override;
 
 	void filter(int size, bool selectFirst = false); //0 - all
@@ -125,11 +127,27 @@ private:
 	std::shared_ptr<CButton> buttonDeleteMode;
 	bool deleteMode;
 
+	/// Headers of maps, campaigns and saves are loaded by background thread and added to list as they arrive
+	boost::thread scanThread;
+	std::atomic<bool> scanCancelled = false;
+	std::atomic<bool> scanFinished = true;
+	std::mutex scannedItemsMutex;
+	std::vector<std::shared_ptr<ElementInfo>> scannedItems;
+	std::vector<ResourcePath> unsupportedSaves;
+	/// Decides whether scanned item is added to list, may adjust item for this tab
+	std::function<bool(ElementInfo &)> scannedItemsFilter;
+	uint32_t timeSinceScanUpdate = 0;
+	bool restoreSelectionAfterScan = false;
+
+	void startScan(const std::unordered_set<ResourcePath> & files, const std::function<void(ElementInfo &, const ResourcePath &)> & initializer, const std::function<bool(ElementInfo &)> & itemsFilter);
+	void stopScan();
+	void addScannedItems();
+
 	auto checkSubfolder(std::string path);
 
 	bool isMapSupported(const CMapInfo & info);
 	void parseMaps(const std::unordered_set<ResourcePath> & files);
-	std::vector<ResourcePath> parseSaves(const std::unordered_set<ResourcePath> & files);
+	void parseSaves(const std::unordered_set<ResourcePath> & files);
 	void parseCampaigns(const std::unordered_set<ResourcePath> & files);
 	std::unordered_set<ResourcePath> getFiles(std::string dirURI, EResType resType);
 
@@ -214,6 +214,11 @@ void MapView::onViewMapActivated()
 	controller->setTileSize(Point(32, 32));
 }
 
+void MapView::onEnemyTurnStarted()
+{
+	controller->resetEnemyAnimationBudget();
+}
+
 PuzzleMapView::PuzzleMapView(const Point & offset, const Point & dimensions, const int3 & tileToCenter)
 	: BasicMapView(offset, dimensions)
 {
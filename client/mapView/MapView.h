@@ -91,6 +91,9 @@ public:
 
 	/// Switches view from View World mode back to standard view
 	void onViewMapActivated();
+
+	/// Resets time limit for animations of other player actions
+	void onEnemyTurnStarted();
 };
 
 /// Main class that represents map view for puzzle map
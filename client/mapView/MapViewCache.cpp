@@ -21,14 +21,23 @@
 #include "../render/IFont.h"
 #include "../render/IRenderHandler.h"
 #include "../render/Graphics.h"
+#include "../render/Colors.h"
+#include "../render/IScreenHandler.h"
+#include "../renderSDL/TextureAtlas.h"
 
 #include "../gui/CGuiHandler.h"
 #include "../widgets/TextControls.h"
+#include "../CMT.h"
 
+#include "../../lib/CConfigHandler.h"
 #include "../../lib/mapObjects/CObjectHandler.h"
 #include "../../lib/int3.h"
 
-MapViewCache::~MapViewCache() = default;
+MapViewCache::~MapViewCache()
+{
+	if(terrainAtlas)
+		GH.screenHandler().removeUnderlay(terrainAtlas.get());
+}
 
 MapViewCache::MapViewCache(const std::shared_ptr<MapViewModel> & model)
 	: model(model)
@@ -43,6 +52,14 @@ MapViewCache::MapViewCache(const std::shared_ptr<MapViewModel> & model)
 	Point visibleSize = model->getTilesVisibleDimensions();
 	terrainChecksum.resize(boost::extents[visibleSize.x][visibleSize.y]);
 	tilesUpToDate.resize(boost::extents[visibleSize.x][visibleSize.y]);
+
+	if(settings["video"]["hardwareMapRendering"].Bool())
+	{
+		terrainAtlas = std::make_unique<TextureAtlas>(model->getCacheDimensionsPixels() * GH.screenHandler().getScalingFactor());
+
+		if(!terrainAtlas->isValid() || !GH.screenHandler().addUnderlay(terrainAtlas.get()))
+			terrainAtlas.reset();
+	}
 }
 
 Canvas MapViewCache::getTile(const int3 & coordinates)
@@ -105,6 +122,9 @@ void MapViewCache::updateTile(const std::shared_ptr<IMapRendererContext> & conte
 	if(context->filterGrayscale())
 		target.applyGrayscale();
 
+	if(terrainAtlas)
+		terrainAtlas->upload(terrain->getInternalSurface(), target.getRenderArea());
+
 	oldCacheEntry = newCacheEntry;
 	tilesUpToDate[cacheX][cacheY] = false;
 }
@@ -147,6 +167,13 @@ void MapViewCache::render(const std::shared_ptr<IMapRendererContext> & context,
 
 	Rect dimensions = model->getTilesTotalRect();
 
+	// snapshots for view transitions are rendered into separate canvas and must contain actual pixels
+	bool hardwareRendering = terrainAtlas && target.getInternalSurface() == screen;
+	Rect visibleArea(Point(0, 0), target.getRenderArea().dimensions() / target.getScalingFactor());
+
+	if(hardwareRendering)
+		terrainAtlas->resetQueue(target.getRenderArea());
+
 	for(int y = dimensions.top(); y < dimensions.bottom(); ++y)
 	{
 		for(int x = dimensions.left(); x < dimensions.right(); ++x)
@@ -154,13 +181,18 @@ void MapViewCache::render(const std::shared_ptr<IMapRendererContext> & context,
 			int cacheX = (terrainChecksum.shape()[0] + x) % terrainChecksum.shape()[0];
 			int cacheY = (terrainChecksum.shape()[1] + y) % terrainChecksum.shape()[1];
 			int3 tile(x, y, model->getLevel());
+			Rect targetRect = model->getTargetTileArea(tile);
+
+			if(hardwareRendering)
+				terrainAtlas->queueQuad(getTile(tile).getRenderArea(), targetRect * target.getScalingFactor() + target.getRenderArea().topLeft());
 
 			if(lazyUpdate && tilesUpToDate[cacheX][cacheY])
 				continue;
 
-			Canvas source = getTile(tile);
-			Rect targetRect = model->getTargetTileArea(tile);
-			target.draw(source, targetRect.topLeft());
+			if(hardwareRendering)
+				target.drawColor(targetRect.intersect(visibleArea), Colors::TRANSPARENCY);
+			else
+				target.draw(getTile(tile), targetRect.topLeft());
 
 			if (!fullRedraw)
 				tilesUpToDate[cacheX][cacheY] = true;
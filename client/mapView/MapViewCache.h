@@ -21,6 +21,7 @@ class Canvas;
 class MapRenderer;
 class IMapRendererContext;
 class MapViewModel;
+class TextureAtlas;
 
 /// Class responsible for rendering of entire map view
 /// uses rendering parameters provided by owner class
@@ -53,6 +54,10 @@ class MapViewCache
 	std::unique_ptr<Canvas> intermediate;
 	std::unique_ptr<MapRenderer> mapRenderer;
 
+	/// Copy of terrain cache in video memory, exists only if hardware rendering of map is enabled and supported
+	/// Map view is then composed by GPU from this atlas, and map area of screen surface is kept transparent
+	std::unique_ptr<TextureAtlas> terrainAtlas;
+
 	std::shared_ptr<CAnimation> iconsStorage;
 
 	Canvas getTile(const int3 & coordinates);
@@ -210,6 +210,9 @@ void MapViewController::tick(uint32_t timeDelta)
 	if (adventureContext)
 		adventureContext->animationTime += timeDelta;
 
+	if (hasOngoingAnimations() && !LOCPLINT->makingTurn)
+		enemyAnimationTime += timeDelta;
+
 	updateState();
 }
 
@@ -274,11 +277,30 @@ void MapViewController::afterRender()
 	}
 }
 
+void MapViewController::resetEnemyAnimationBudget()
+{
+	enemyAnimationTime = 0;
+}
+
+bool MapViewController::isEnemyAnimationBudgetExhausted(const PlayerColor & initiator) const
+{
+	if(initiator == LOCPLINT->playerID)
+		return false;
+
+	double budget = settings["adventure"]["enemyMoveBudget"].Float();
+
+	// zero or negative values mean that there is no limit
+	return budget > 0 && enemyAnimationTime >= budget;
+}
+
 bool MapViewController::isEventInstant(const CGObjectInstance * obj, const PlayerColor & initiator)
 {
 	if(settings["gameTweaks"]["skipAdventureMapAnimations"].Bool())
 		return true;
 
+	if(isEnemyAnimationBudgetExhausted(initiator))
+		return true; // long turn of other player, remaining actions are displayed instantly
+
 	if (!isEventVisible(obj, initiator))
 		return true;
 
@@ -546,7 +568,7 @@ void MapViewController::onHeroMoved(const CGHeroInstance * obj, const int3 & fro
 		settings["adventure"]["heroMoveTime"].Float() :
 		settings["adventure"]["enemyMoveTime"].Float();
 
-	if(movementTime > 1)
+	if(movementTime > 1 && !isEnemyAnimationBudgetExhausted(obj->tempOwner))
 	{
 		animationWait.setBusy();
 		logGlobal->debug("Starting movement animation");
@@ -59,6 +59,12 @@ private:
 	Point targetTileSize = Point(32, 32);
 	bool wasInDeadZone = true;
 
+	/// Total duration of animations of other players actions since start of their turn, in milliseconds
+	double enemyAnimationTime = 0;
+
+	/// Returns true if actions of this player should no longer be animated since time limit set by player was reached
+	bool isEnemyAnimationBudgetExhausted(const PlayerColor & initiator) const;
+
 	bool isEventInstant(const CGObjectInstance * obj, const PlayerColor & initiator);
 	bool isEventVisible(const CGObjectInstance * obj, const PlayerColor & initiator);
 	bool isEventVisible(const CGHeroInstance * obj, const int3 & from, const int3 & dest);
@@ -100,6 +106,7 @@ public:
 	void modifyTileSize(int stepsChange, bool useDeadZone);
 	void tick(uint32_t timePassed);
 	void afterRender();
+	void resetEnemyAnimationBudget();
 
 	void activateAdventureContext(uint32_t animationTime);
 	void activateAdventureContext();
@@ -25,4 +25,10 @@ public:
 	{
 		return {nullptr, 0};
 	};
+
+	/// Extracts audio data from provided video in background
+	void getAudioAsync(const VideoPath & videoToOpen, std::function<void(std::pair<std::unique_ptr<ui8[]>, si64>)> onLoaded) override
+	{
+		onLoaded({nullptr, 0});
+	};
 };
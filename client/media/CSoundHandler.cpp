@@ -37,6 +37,7 @@ void CSoundHandler::onVolumeChange(const JsonNode & volumeNode)
 
 CSoundHandler::CSoundHandler():
 	listener(settings.listen["general"]["sound"]),
+	cacheMemoryLimit(settings["general"]["soundCacheSize"].Integer() * 1024 * 1024),
 	ambientConfig(JsonPath::builtin("config/ambientSounds.json"))
 {
 	listener(std::bind(&CSoundHandler::onVolumeChange, this, _1));
@@ -62,30 +63,80 @@ CSoundHandler::~CSoundHandler()
 	{
 		Mix_HaltChannel(-1);
 
-		for(auto & chunk : soundChunks)
+		for(auto & entry : cachedChunks)
 		{
-			if(chunk.second.first)
-				Mix_FreeChunk(chunk.second.first);
+			if(entry.chunk)
+				Mix_FreeChunk(entry.chunk);
 		}
 	}
 }
 
-// Allocate an SDL chunk and cache it.
-Mix_Chunk * CSoundHandler::GetSoundChunk(const AudioPath & sound, bool cache)
+Mix_Chunk * CSoundHandler::touchCachedChunk(std::list<CachedChunk>::iterator iter)
 {
-	try
+	cachedChunks.splice(cachedChunks.begin(), cachedChunks, iter);
+	return iter->chunk;
+}
+
+void CSoundHandler::addCachedChunk(Mix_Chunk * chunk, const AudioPath & sound, const ContentKey & contentKey)
+{
+	size_t memoryUsage = chunk ? sizeof(Mix_Chunk) + chunk->alen : 0;
+
+	cachedChunks.push_front({chunk, memoryUsage, sound, contentKey});
+	cacheMemoryUsage += memoryUsage;
+
+	if(sound.empty())
+		chunksByContent[contentKey] = cachedChunks.begin();
+	else
+		chunksBySound[sound] = cachedChunks.begin();
+
+	evictCachedChunks();
+}
+
+void CSoundHandler::evictCachedChunks()
+{
+	// never evict most recently used chunk - it is about to be played
+	auto iter = cachedChunks.end();
+	while(cacheMemoryUsage > cacheMemoryLimit && iter != cachedChunks.begin() && std::prev(iter) != cachedChunks.begin())
 	{
-		if(cache && soundChunks.find(sound) != soundChunks.end())
-			return soundChunks[sound].first;
+		--iter;
 
-		auto data = CResourceHandler::get()->load(sound.addPrefix("SOUNDS/"))->readAll();
-		SDL_RWops * ops = SDL_RWFromMem(data.first.get(), data.second);
-		Mix_Chunk * chunk = Mix_LoadWAV_RW(ops, 1); // will free ops
+		if(isChunkPlaying(iter->chunk))
+			continue;
 
-		if(cache)
-			soundChunks.insert({sound, std::make_pair(chunk, std::move(data.first))});
+		if(iter->sound.empty())
+			chunksByContent.erase(iter->contentKey);
+		else
+			chunksBySound.erase(iter->sound);
 
-		return chunk;
+		if(iter->chunk)
+			Mix_FreeChunk(iter->chunk);
+
+		cacheMemoryUsage -= iter->memoryUsage;
+		iter = cachedChunks.erase(iter);
+	}
+}
+
+bool CSoundHandler::isChunkPlaying(Mix_Chunk * chunk) const
+{
+	if(!chunk)
+		return false;
+
+	// note: paused channels are also reported as playing
+	int channelsCount = Mix_AllocateChannels(-1);
+	for(int channel = 0; channel < channelsCount; ++channel)
+		if(Mix_Playing(channel) && Mix_GetChunk(channel) == chunk)
+			return true;
+
+	return false;
+}
+
+Mix_Chunk * CSoundHandler::loadSoundChunk(const AudioPath & sound)
+{
+	try
+	{
+		auto data = CResourceHandler::get()->load(sound.addPrefix("SOUNDS/"))->readAll();
+		SDL_RWops * ops = SDL_RWFromMem(data.first.get(), data.second);
+		return Mix_LoadWAV_RW(ops, 1); // will free ops
 	}
 	catch(std::exception & e)
 	{
@@ -94,30 +145,70 @@ Mix_Chunk * CSoundHandler::GetSoundChunk(const AudioPath & sound, bool cache)
 	}
 }
 
-Mix_Chunk * CSoundHandler::GetSoundChunk(std::pair<std::unique_ptr<ui8[]>, si64> & data, bool cache)
+// Allocate an SDL chunk and cache it.
+Mix_Chunk * CSoundHandler::GetSoundChunk(const AudioPath & sound, bool cache, bool & isCached)
+{
+	auto iter = chunksBySound.find(sound);
+	if(iter != chunksBySound.end())
+	{
+		isCached = true;
+		return touchCachedChunk(iter->second);
+	}
+
+	Mix_Chunk * chunk = loadSoundChunk(sound);
+
+	isCached = cache;
+	if(cache)
+		addCachedChunk(chunk, sound, {});
+
+	return chunk;
+}
+
+Mix_Chunk * CSoundHandler::GetSoundChunk(std::pair<std::unique_ptr<ui8[]>, si64> & data, bool cache, bool & isCached)
 {
 	try
 	{
-		std::vector<ui8> startBytes = std::vector<ui8>(data.first.get(), data.first.get() + std::min(static_cast<si64>(100), data.second));
+		// decoded chunk does not references source data, so size and hash of it are enough to identify chunk
+		// uncached sounds, such as audio of videos, may be large - do not hash them at all
+		ContentKey contentKey;
+		if(cache)
+		{
+			size_t contentHash = std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char *>(data.first.get()), data.second));
+			contentKey = ContentKey(data.second, contentHash);
 
-		if(cache && soundChunksRaw.find(startBytes) != soundChunksRaw.end())
-			return soundChunksRaw[startBytes].first;
+			auto iter = chunksByContent.find(contentKey);
+			if(iter != chunksByContent.end())
+			{
+				isCached = true;
+				return touchCachedChunk(iter->second);
+			}
+		}
 
 		SDL_RWops * ops = SDL_RWFromMem(data.first.get(), data.second);
 		Mix_Chunk * chunk = Mix_LoadWAV_RW(ops, 1); // will free ops
 
+		isCached = cache;
 		if(cache)
-			soundChunksRaw.insert({startBytes, std::make_pair(chunk, std::move(data.first))});
+			addCachedChunk(chunk, AudioPath(), contentKey);
 
 		return chunk;
 	}
 	catch(std::exception & e)
 	{
 		logGlobal->warn("Cannot get sound chunk: %s", e.what());
+		isCached = false;
 		return nullptr;
 	}
 }
 
+void CSoundHandler::preloadSound(const AudioPath & sound)
+{
+	if(!isInitialized() || sound.empty() || chunksBySound.count(sound))
+		return;
+
+	addCachedChunk(loadSoundChunk(sound), sound, {});
+}
+
 int CSoundHandler::ambientDistToVolume(int distance) const
 {
 	const auto & distancesVector = ambientConfig["distances"].Vector();
@@ -185,46 +276,44 @@ int CSoundHandler::playSound(const AudioPath & sound, int repeats, bool cache)
 	if(!isInitialized() || sound.empty())
 		return -1;
 
-	int channel;
-	Mix_Chunk * chunk = GetSoundChunk(sound, cache);
+	bool isCached = false;
+	Mix_Chunk * chunk = GetSoundChunk(sound, cache, isCached);
+	int channel = playSoundChunk(chunk, isCached, repeats);
 
-	if(chunk)
-	{
-		channel = Mix_PlayChannel(-1, chunk, repeats);
-		if(channel == -1)
-		{
-			logGlobal->error("Unable to play sound file %s , error %s", sound.getOriginalName(), Mix_GetError());
-			if(!cache)
-				Mix_FreeChunk(chunk);
-		}
-		else if(cache)
-			initCallback(channel);
-		else
-			initCallback(channel, [chunk](){ Mix_FreeChunk(chunk);});
-	}
-	else
-		channel = -1;
+	if(chunk && channel == -1)
+		logGlobal->error("Unable to play sound file %s , error %s", sound.getOriginalName(), Mix_GetError());
 
 	return channel;
 }
 
 int CSoundHandler::playSound(std::pair<std::unique_ptr<ui8[]>, si64> & data, int repeats, bool cache)
 {
-	int channel = -1;
-	if(Mix_Chunk * chunk = GetSoundChunk(data, cache))
+	bool isCached = false;
+	Mix_Chunk * chunk = GetSoundChunk(data, cache, isCached);
+	int channel = playSoundChunk(chunk, isCached, repeats);
+
+	if(chunk && channel == -1)
+		logGlobal->error("Unable to play sound, error %s", Mix_GetError());
+
+	return channel;
+}
+
+int CSoundHandler::playSoundChunk(Mix_Chunk * chunk, bool isCached, int repeats)
+{
+	if(!chunk)
+		return -1;
+
+	int channel = Mix_PlayChannel(-1, chunk, repeats);
+	if(channel == -1)
 	{
-		channel = Mix_PlayChannel(-1, chunk, repeats);
-		if(channel == -1)
-		{
-			logGlobal->error("Unable to play sound, error %s", Mix_GetError());
-			if(!cache)
-				Mix_FreeChunk(chunk);
-		}
-		else if(cache)
-			initCallback(channel);
-		else
-			initCallback(channel, [chunk](){ Mix_FreeChunk(chunk);});
+		if(!isCached)
+			Mix_FreeChunk(chunk);
 	}
+	else if(isCached)
+		initCallback(channel);
+	else
+		initCallback(channel, [chunk](){ Mix_FreeChunk(chunk);});
+
 	return channel;
 }
 
@@ -23,12 +23,44 @@ private:
 	SettingsListener listener;
 	void onVolumeChange(const JsonNode & volumeNode);
 
-	using CachedChunk = std::pair<Mix_Chunk *, std::unique_ptr<ui8[]>>;
-	std::map<AudioPath, CachedChunk> soundChunks;
-	std::map<std::vector<ui8>, CachedChunk> soundChunksRaw;
-
-	Mix_Chunk * GetSoundChunk(const AudioPath & sound, bool cache);
-	Mix_Chunk * GetSoundChunk(std::pair<std::unique_ptr<ui8[]>, si64> & data, bool cache);
+	/// Size and hash of raw sound data
+	using ContentKey = std::pair<size_t, size_t>;
+
+	struct CachedChunk
+	{
+		Mix_Chunk * chunk;
+		/// Size of decoded sound data
+		size_t memoryUsage;
+		/// Name of sound file, or empty if sound was created from raw data
+		AudioPath sound;
+		/// Size and hash of raw data, or zeroes if sound was loaded from file
+		ContentKey contentKey;
+	};
+
+	/// All cached chunks, most recently played first
+	std::list<CachedChunk> cachedChunks;
+	std::unordered_map<AudioPath, std::list<CachedChunk>::iterator, std::hash<ResourcePath>> chunksBySound;
+	std::map<ContentKey, std::list<CachedChunk>::iterator> chunksByContent;
+
+	/// Total size of all cached chunks and its limit, in bytes
+	size_t cacheMemoryUsage = 0;
+	size_t cacheMemoryLimit;
+
+	/// Moves cached chunk to the front of LRU list and returns it
+	Mix_Chunk * touchCachedChunk(std::list<CachedChunk>::iterator iter);
+	void addCachedChunk(Mix_Chunk * chunk, const AudioPath & sound, const ContentKey & contentKey);
+	/// Frees least recently played chunks until cache fits into memory limit. Chunks that are currently playing are kept
+	void evictCachedChunks();
+	bool isChunkPlaying(Mix_Chunk * chunk) const;
+
+	Mix_Chunk * loadSoundChunk(const AudioPath & sound);
+
+	/// Returns chunk from cache, or loads it and adds to cache if requested
+	/// Chunks that are not owned by cache (isCached == false) must be freed by caller
+	Mix_Chunk * GetSoundChunk(const AudioPath & sound, bool cache, bool & isCached);
+	Mix_Chunk * GetSoundChunk(std::pair<std::unique_ptr<ui8[]>, si64> & data, bool cache, bool & isCached);
+
+	int playSoundChunk(Mix_Chunk * chunk, bool isCached, int repeats);
 
 	/// have entry for every currently active channel
 	/// vector will be empty if callback was not set
@@ -66,6 +98,7 @@ public:
 	int playSound(const AudioPath & sound, int repeats = 0, bool cache = false) final;
 	int playSound(std::pair<std::unique_ptr<ui8[]>, si64> & data, int repeats = 0, bool cache = false) final;
 	int playSoundFromSet(std::vector<soundBase::soundID> & sound_vec) final;
+	void preloadSound(const AudioPath & sound) final;
 	void stopSound(int handler) final;
 	void pauseSound(int handler) final;
 	void resumeSound(int handler) final;
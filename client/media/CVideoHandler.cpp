@@ -22,6 +22,7 @@
 #include "../render/IScreenHandler.h"
 #include "../renderSDL/SDL_Extensions.h"
 
+#include "../../lib/CThreadHelper.h"
 #include "../../lib/filesystem/CInputStream.h"
 #include "../../lib/filesystem/Filesystem.h"
 #include "../../lib/texts/CGeneralTextHandler.h"
@@ -212,6 +213,8 @@ void CVideoInstance::prepareOutput(float scaleFactor, bool useTextureOutput)
 
 		auto preferredFormat = avcodec_find_best_pix_fmt_of_list(potentialFormats.data(), getCodecContext()->pix_fmt, false, nullptr);
 
+		outputFormat = preferredFormat;
+
 		if (preferredFormat == AV_PIX_FMT_YUV420P)
 			textureYUV = SDL_CreateTexture( mainRenderer, SDL_PIXELFORMAT_IYUV, SDL_TEXTUREACCESS_STREAMING, dimensions.x, dimensions.y);
 		else
@@ -222,6 +225,7 @@ void CVideoInstance::prepareOutput(float scaleFactor, bool useTextureOutput)
 	}
 	else
 	{
+		outputFormat = AV_PIX_FMT_RGB32;
 		surface = CSDL_Ext::newSurface(dimensions);
 		sws = sws_getContext(getCodecContext()->width, getCodecContext()->height, getCodecContext()->pix_fmt,
 							 dimensions.x, dimensions.y, AV_PIX_FMT_RGB32,
@@ -230,6 +234,20 @@ void CVideoInstance::prepareOutput(float scaleFactor, bool useTextureOutput)
 
 	if (sws == nullptr)
 		throw std::runtime_error("Failed to create sws");
+
+	// Avoid buffer overflow caused by sws_scale():
+	// http://trac.ffmpeg.org/ticket/9254
+	static const int FFMPEG_PADDING = 1024;
+	static const int FFMPEG_ALIGNMENT = 32;
+	auto pixelFormat = static_cast<AVPixelFormat>(outputFormat);
+	int bufferSize = av_image_get_buffer_size(pixelFormat, dimensions.x, dimensions.y, FFMPEG_ALIGNMENT);
+
+	for(size_t i = 0; i < frameBuffers.size(); ++i)
+	{
+		auto * buffer = static_cast<uint8_t *>(av_malloc(bufferSize + FFMPEG_PADDING));
+		av_image_fill_arrays(frameBuffers[i].data.data(), frameBuffers[i].linesize.data(), buffer, pixelFormat, dimensions.x, dimensions.y, FFMPEG_ALIGNMENT);
+		freeFrames.push_back(i);
+	}
 }
 
 void FFMpegStream::decodeNextFrame()
@@ -294,58 +312,170 @@ void FFMpegStream::decodeNextFrame()
 	}
 }
 
-bool CVideoInstance::loadNextFrame()
+bool FFMpegStream::seekStream(double timestamp)
 {
-	decodeNextFrame();
-	const AVFrame * frame = getCurrentFrame();
+	auto targetTimestamp = static_cast<int64_t>(timestamp / av_q2d(formatContext->streams[streamIndex]->time_base));
 
-	if(!frame)
+	int rc = av_seek_frame(formatContext, streamIndex, targetTimestamp, AVSEEK_FLAG_BACKWARD);
+	if(rc < 0)
 		return false;
 
-	uint8_t * data[4] = {};
-	int linesize[4] = {};
+	avcodec_flush_buffers(codecContext);
 
-	if(textureYUV)
+	// frame is released once end of stream is reached
+	if(frame == nullptr)
+		frame = av_frame_alloc();
+
+	return true;
+}
+
+void CVideoInstance::convertFrame(DecodedFrame & target)
+{
+	const AVFrame * frame = getCurrentFrame();
+
+	sws_scale(sws, frame->data, frame->linesize, 0, getCodecContext()->height, target.data.data(), target.linesize.data());
+	target.endTime = getCurrentFrameEndTime();
+	target.duration = getCurrentFrameDuration();
+}
+
+void CVideoInstance::runDecoding(double skipUntil)
+{
+	setThreadName("videoDecoding");
+
+	try
+	{
+		for(;;)
+		{
+			size_t frameIndex;
+			{
+				boost::unique_lock lock(decodingMutex);
+				decodingCondition.wait(lock, [this](){ return decodingStopRequested || !freeFrames.empty(); });
+
+				if(decodingStopRequested)
+					return;
+
+				frameIndex = freeFrames.back();
+				freeFrames.pop_back();
+			}
+
+			// after seek, frames between key frame and requested time are decoded but not converted
+			do
+				decodeNextFrame();
+			while(getCurrentFrame() && getCurrentFrameEndTime() <= skipUntil);
+
+			if(getCurrentFrame())
+				convertFrame(frameBuffers[frameIndex]);
+
+			boost::lock_guard lock(decodingMutex);
+			if(getCurrentFrame())
+			{
+				decodedFrames.push_back(frameIndex);
+			}
+			else
+			{
+				freeFrames.push_back(frameIndex);
+				decodingFinished = true;
+			}
+			decodingCondition.notify_all();
+
+			if(decodingFinished)
+				return;
+		}
+	}
+	catch(const std::exception & e)
 	{
-		av_image_alloc(data, linesize, dimensions.x, dimensions.y, AV_PIX_FMT_YUV420P, 1);
-		sws_scale(sws, frame->data, frame->linesize, 0, getCodecContext()->height, data, linesize);
-		SDL_UpdateYUVTexture(textureYUV, nullptr, data[0], linesize[0], data[1], linesize[1], data[2], linesize[2]);
-		av_freep(&data[0]);
+		logGlobal->error("Failed to decode video: %s", e.what());
+
+		boost::lock_guard lock(decodingMutex);
+		decodingError = std::current_exception();
+		decodingFinished = true;
+		decodingCondition.notify_all();
 	}
-	if(textureRGB)
+}
+
+void CVideoInstance::startDecoding(double skipUntil)
+{
+	decodingThread = boost::thread(&CVideoInstance::runDecoding, this, skipUntil);
+}
+
+void CVideoInstance::stopDecoding()
+{
 	{
-		av_image_alloc(data, linesize, dimensions.x, dimensions.y, AV_PIX_FMT_RGB32, 1);
-		sws_scale(sws, frame->data, frame->linesize, 0, getCodecContext()->height, data, linesize);
-		SDL_UpdateTexture(textureRGB, nullptr, data[0], linesize[0]);
-		av_freep(&data[0]);
+		boost::lock_guard lock(decodingMutex);
+		decodingStopRequested = true;
+		decodingCondition.notify_all();
 	}
-	if(surface)
+
+	if(decodingThread.joinable())
+		decodingThread.join();
+
+	// decoding thread is stopped, so all frame buffers are available again
+	decodedFrames.clear();
+	freeFrames.clear();
+	for(size_t i = 0; i < frameBuffers.size(); ++i)
+		freeFrames.push_back(i);
+
+	decodingStopRequested = false;
+	decodingFinished = false;
+	decodingError = nullptr;
+}
+
+bool CVideoInstance::loadFirstFrame()
+{
+	size_t frameIndex;
 	{
-		// Avoid buffer overflow caused by sws_scale():
-		// http://trac.ffmpeg.org/ticket/9254
-
-		size_t pic_bytes = surface->pitch * surface->h;
-		size_t ffmped_pad = 1024; /* a few bytes of overflow will go here */
-		void * for_sws = av_malloc(pic_bytes + ffmped_pad);
-		data[0] = (ui8 *)for_sws;
-		linesize[0] = surface->pitch;
-
-		sws_scale(sws, frame->data, frame->linesize, 0, getCodecContext()->height, data, linesize);
-		memcpy(surface->pixels, for_sws, pic_bytes);
-		av_free(for_sws);
+		boost::unique_lock lock(decodingMutex);
+		decodingCondition.wait(lock, [this](){ return decodingFinished || !decodedFrames.empty(); });
+
+		if(decodedFrames.empty())
+		{
+			playbackEnded = true;
+			return false;
+		}
+
+		frameIndex = decodedFrames.front();
+		decodedFrames.pop_front();
 	}
+
+	showDecodedFrame(frameIndex);
 	return true;
 }
 
+void CVideoInstance::showDecodedFrame(size_t frameIndex)
+{
+	const auto & frame = frameBuffers[frameIndex];
+
+	if(textureYUV)
+		SDL_UpdateYUVTexture(textureYUV, nullptr, frame.data[0], frame.linesize[0], frame.data[1], frame.linesize[1], frame.data[2], frame.linesize[2]);
+
+	if(textureRGB)
+		SDL_UpdateTexture(textureRGB, nullptr, frame.data[0], frame.linesize[0]);
+
+	if(surface)
+	{
+		auto * pixels = static_cast<uint8_t *>(surface->pixels);
+		size_t rowBytes = std::min(surface->pitch, frame.linesize[0]);
+
+		for(int y = 0; y < surface->h; ++y)
+			memcpy(pixels + y * surface->pitch, frame.data[0] + y * frame.linesize[0], rowBytes);
+	}
+
+	currentFrameEndTime = frame.endTime;
+	currentFrameDuration = frame.duration;
+
+	boost::lock_guard lock(decodingMutex);
+	freeFrames.push_back(frameIndex);
+	decodingCondition.notify_all();
+}
 
 double CVideoInstance::timeStamp()
 {
-	return getCurrentFrameEndTime();
+	return currentFrameEndTime;
 }
 
 bool CVideoInstance::videoEnded()
 {
-	return getCurrentFrame() == nullptr;
+	return playbackEnded;
 }
 
 CVideoInstance::CVideoInstance()
@@ -355,6 +485,11 @@ CVideoInstance::CVideoInstance()
 
 CVideoInstance::~CVideoInstance()
 {
+	stopDecoding();
+
+	for(auto & frame : frameBuffers)
+		av_free(frame.data[0]);
+
 	sws_freeContext(sws);
 	SDL_DestroyTexture(textureYUV);
 	SDL_DestroyTexture(textureRGB);
@@ -387,6 +522,7 @@ void CVideoInstance::show(const Point & position, Canvas & canvas)
 		throw std::runtime_error("No video to show!");
 
 	CSDL_Ext::blitSurface(surface, canvas.getInternalSurface(), position * GH.screenHandler().getScalingFactor());
+	canvas.markDirty(Rect(position * GH.screenHandler().getScalingFactor(), dimensions));
 }
 
 double FFMpegStream::getCurrentFrameEndTime() const
@@ -426,16 +562,35 @@ void CVideoInstance::tick(uint32_t msPassed)
 	auto nowTime = std::chrono::steady_clock::now();
 	double difference = std::chrono::duration_cast<std::chrono::milliseconds>(nowTime - startTime).count() / 1000.0;
 
-	int frameskipCounter = 0;
-	while(!videoEnded() && difference >= getCurrentFrameEndTime() + getCurrentFrameDuration() && frameskipCounter < MAX_FRAMESKIP) // Frameskip
+	std::optional<size_t> frameToShow;
 	{
-		decodeNextFrame();
-		frameskipCounter++;
+		boost::lock_guard lock(decodingMutex);
+
+		// Frameskip - if we are late, all frames that should have been shown by now are dropped except for the last one
+		double frameEndTime = currentFrameEndTime;
+		while(!decodedFrames.empty() && difference >= frameEndTime)
+		{
+			if(frameToShow)
+				freeFrames.push_back(*frameToShow);
+
+			frameToShow = decodedFrames.front();
+			frameEndTime = frameBuffers[*frameToShow].endTime;
+			decodedFrames.pop_front();
+		}
+
+		if(!frameToShow && decodedFrames.empty() && decodingFinished && difference >= currentFrameEndTime)
+		{
+			playbackEnded = true;
+			if(decodingError)
+				std::rethrow_exception(decodingError);
+		}
+
+		decodingCondition.notify_all();
 	}
-	if(!videoEnded() && difference >= getCurrentFrameEndTime())
-		loadNextFrame();
-}
 
+	if(frameToShow)
+		showDecodedFrame(*frameToShow);
+}
 
 void CVideoInstance::activate()
 {
@@ -453,6 +608,25 @@ void CVideoInstance::deactivate()
 	deactivationStartTimeHandling = true;
 }
 
+bool CVideoInstance::seek(double timestamp)
+{
+	stopDecoding();
+
+	if(!seekStream(timestamp))
+	{
+		playbackEnded = true;
+		return false;
+	}
+
+	playbackEnded = false;
+	currentFrameEndTime = 0;
+	startTime = std::chrono::steady_clock::now() - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timestamp));
+	startTimeInitialized = true;
+
+	startDecoding(timestamp);
+	return loadFirstFrame();
+}
+
 struct FFMpegFormatDescription
 {
 	uint8_t sampleSizeBytes;
@@ -680,7 +854,10 @@ std::unique_ptr<IVideoInstance> CVideoPlayer::open(const VideoPath & name, float
 		return nullptr;
 
 	result->prepareOutput(scaleFactor, false);
-	result->loadNextFrame(); // prepare 1st frame
+	result->startDecoding(0);
+
+	if (!result->loadFirstFrame()) // prepare 1st frame
+		return nullptr;
 
 	return result;
 }
@@ -700,4 +877,50 @@ std::pair<std::unique_ptr<ui8[]>, si64> CVideoPlayer::getAudio(const VideoPath &
 	return audio.extractAudio(videoToOpen);
 }
 
+CVideoPlayer::~CVideoPlayer()
+{
+	{
+		boost::mutex::scoped_lock lock(audioRequestsMutex);
+		audioLoadingStopRequested = true;
+		audioRequests.clear();
+	}
+	audioRequestsCondition.notify_all();
+
+	if(audioLoadingThread.joinable())
+		audioLoadingThread.join();
+}
+
+void CVideoPlayer::getAudioAsync(const VideoPath & videoToOpen, AudioCallback onLoaded)
+{
+	boost::mutex::scoped_lock lock(audioRequestsMutex);
+	audioRequests.emplace_back(videoToOpen, std::move(onLoaded));
+
+	// started on first request - most sessions never need to extract audio from videos
+	if(!audioLoadingThread.joinable())
+		audioLoadingThread = boost::thread(&CVideoPlayer::runAudioLoading, this);
+	else
+		audioRequestsCondition.notify_one();
+}
+
+void CVideoPlayer::runAudioLoading()
+{
+	setThreadName("videoAudioLoad");
+
+	boost::mutex::scoped_lock lock(audioRequestsMutex);
+	while(true)
+	{
+		audioRequestsCondition.wait(lock, [this](){ return audioLoadingStopRequested || !audioRequests.empty(); });
+
+		if(audioLoadingStopRequested)
+			return;
+
+		auto request = std::move(audioRequests.front());
+		audioRequests.pop_front();
+
+		lock.unlock();
+		request.second(getAudio(request.first));
+		lock.lock();
+	}
+}
+
 #endif
@@ -51,6 +51,8 @@ protected:
 	const AVCodecParameters * getCodecParameters() const;
 	const AVCodecContext * getCodecContext() const;
 	void decodeNextFrame();
+	/// Moves stream to last key frame before specified time. Returns false if stream does not supports seeking
+	bool seekStream(double timestamp);
 	const AVFrame * getCurrentFrame() const;
 	double getCurrentFrameEndTime() const;
 	double getCurrentFrameDuration() const;
@@ -71,11 +73,43 @@ class CVideoInstance final : public IVideoInstance, public FFMpegStream
 {
 	friend class CVideoPlayer;
 
+	/// Frame decoded and converted to output format by decoding thread
+	struct DecodedFrame
+	{
+		std::array<uint8_t *, 4> data = {};
+		std::array<int, 4> linesize = {};
+		double endTime = 0;
+		double duration = 0;
+	};
+
+	/// Number of frames that decoding thread may prepare in advance
+	static constexpr size_t FRAME_QUEUE_SIZE = 4;
+
 	struct SwsContext * sws = nullptr;
 	SDL_Texture * textureRGB = nullptr;
 	SDL_Texture * textureYUV = nullptr;
 	SDL_Surface * surface = nullptr;
 	Point dimensions;
+	/// AVPixelFormat of decoded frames
+	int outputFormat = -1;
+
+	/// Decoding thread owns ffmpeg stream and sws context while it is running
+	boost::thread decodingThread;
+	boost::mutex decodingMutex;
+	boost::condition_variable decodingCondition;
+	std::array<DecodedFrame, FRAME_QUEUE_SIZE> frameBuffers;
+	/// Indices of frames ready to be shown, in order of playback
+	std::deque<size_t> decodedFrames;
+	/// Indices of frame buffers that can be reused by decoding thread
+	std::vector<size_t> freeFrames;
+	bool decodingFinished = false;
+	bool decodingStopRequested = false;
+	std::exception_ptr decodingError;
+
+	/// End time of currently shown frame, in seconds
+	double currentFrameEndTime = 0;
+	double currentFrameDuration = 0;
+	bool playbackEnded = false;
 
 	/// video playback start time point
 	bool startTimeInitialized;
@@ -84,15 +118,22 @@ class CVideoInstance final : public IVideoInstance, public FFMpegStream
 	std::chrono::steady_clock::time_point deactivationStartTime;
 
 	void prepareOutput(float scaleFactor, bool useTextureOutput);
-	
-	const int MAX_FRAMESKIP = 5;
+
+	void startDecoding(double skipUntil);
+	void stopDecoding();
+	void runDecoding(double skipUntil);
+	void convertFrame(DecodedFrame & target);
+
+	/// Waits for decoding thread to prepare first frame and shows it. Returns false if video has no frames
+	bool loadFirstFrame();
+	/// Uploads frame into output texture or surface and returns its buffer to decoding thread
+	void showDecodedFrame(size_t frameIndex);
 
 public:
 	CVideoInstance();
 	~CVideoInstance();
 
 	bool openVideo();
-	bool loadNextFrame();
 
 	double timeStamp() final;
 	bool videoEnded() final;
@@ -102,15 +143,29 @@ public:
 	void tick(uint32_t msPassed) final;
 	void activate() final;
 	void deactivate() final;
+	bool seek(double timestamp) final;
 };
 
 class CVideoPlayer final : public IVideoPlayer
 {
+	using AudioCallback = std::function<void(std::pair<std::unique_ptr<ui8[]>, si64>)>;
+
+	/// Audio extraction requests, processed by audio loading thread in order of arrival
+	std::deque<std::pair<VideoPath, AudioCallback>> audioRequests;
+	boost::mutex audioRequestsMutex;
+	boost::condition_variable audioRequestsCondition;
+	boost::thread audioLoadingThread;
+	bool audioLoadingStopRequested = false;
+
 	void openVideoFile(CVideoInstance & state, const VideoPath & fname);
+	void runAudioLoading();
 
 public:
+	~CVideoPlayer();
+
 	std::unique_ptr<IVideoInstance> open(const VideoPath & name, float scaleFactor) final;
 	std::pair<std::unique_ptr<ui8[]>, si64> getAudio(const VideoPath & videoToOpen) final;
+	void getAudioAsync(const VideoPath & videoToOpen, AudioCallback onLoaded) final;
 };
 
 #endif
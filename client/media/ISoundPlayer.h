@@ -21,6 +21,8 @@ public:
 	virtual int playSound(const AudioPath & sound, int repeats = 0, bool cache = false) = 0;
 	virtual int playSound(std::pair<std::unique_ptr<ui8[]>, si64> & data, int repeats = 0, bool cache = false) = 0;
 	virtual int playSoundFromSet(std::vector<soundBase::soundID> & sound_vec) = 0;
+	/// Loads sound into cache in advance, so it can be played later without loading delay
+	virtual void preloadSound(const AudioPath & sound) = 0;
 	virtual void stopSound(int handler) = 0;
 	virtual void pauseSound(int handler) = 0;
 	virtual void resumeSound(int handler) = 0;
@@ -39,6 +39,9 @@ public:
 	virtual void activate() = 0;
 	virtual void deactivate() = 0;
 
+	/// Restarts playback from specified time, in seconds. Returns false if video does not supports seeking
+	virtual bool seek(double timestamp) = 0;
+
 	virtual ~IVideoInstance() = default;
 };
 
@@ -51,5 +54,9 @@ public:
 	/// Extracts audio data from provided video in wav format
 	virtual std::pair<std::unique_ptr<ui8[]>, si64> getAudio(const VideoPath & videoToOpen) = 0;
 
+	/// Extracts audio data from provided video in background. Callback is invoked from loading thread
+	/// Video player waits for request that is being processed on destruction and discards all other pending requests
+	virtual void getAudioAsync(const VideoPath & videoToOpen, std::function<void(std::pair<std::unique_ptr<ui8[]>, si64>)> onLoaded) = 0;
+
 	virtual ~IVideoPlayer() = default;
 };
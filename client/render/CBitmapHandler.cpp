@@ -20,7 +20,7 @@
 
 namespace BitmapHandler
 {
-	SDL_Surface * loadH3PCX(ui8 * data, size_t size);
+	SDL_Surface * loadH3PCX(const ui8 * data, size_t size);
 
 	SDL_Surface * loadBitmapFromDir(const ImagePath & path);
 }
@@ -39,7 +39,7 @@ enum Epcxformat
 	PCX24B
 };
 
-SDL_Surface * BitmapHandler::loadH3PCX(ui8 * pcx, size_t size)
+SDL_Surface * BitmapHandler::loadH3PCX(const ui8 * pcx, size_t size)
 {
 	SDL_Surface * ret;
 
@@ -114,7 +114,7 @@ SDL_Surface * BitmapHandler::loadBitmapFromDir(const ImagePath & path)
 	SDL_Surface * ret=nullptr;
 
 	try {
-		auto readFile = CResourceHandler::get()->load(path)->readAll();
+		auto readFile = CResourceHandler::get()->load(path)->readAllShared();
 
 		if (isPCX(readFile.first.get()))
 		{//H3-style PCX
@@ -40,7 +40,7 @@ CDefFile::CDefFile(const AnimationPath & Name):
 	data(nullptr),
 	palette(nullptr)
 {
-	data = CResourceHandler::get()->load(Name)->readAll().first;
+	data = CResourceHandler::get()->load(Name)->readAllShared().first;
 
 	palette = std::unique_ptr<SDL_Color[]>(new SDL_Color[256]);
 	int it = 0;
@@ -55,9 +55,9 @@ CDefFile::CDefFile(const AnimationPath & Name):
 
 	for (ui32 i= 0; i<256; i++)
 	{
-		palette[i].r = data[it++];
-		palette[i].g = data[it++];
-		palette[i].b = data[it++];
+		palette[i].r = data.get()[it++];
+		palette[i].g = data.get()[it++];
+		palette[i].b = data.get()[it++];
 		palette[i].a = SDL_ALPHA_OPAQUE;
 	}
 
@@ -36,7 +36,8 @@ private:
 	//offset[group][frame] - offset of frame data in file
 	std::map<size_t, std::vector <size_t> > offset;
 
-	std::unique_ptr<ui8[]>       data;
+	/// content of def file, may be shared with filesystem cache
+	std::shared_ptr<const ui8>   data;
 	std::unique_ptr<SDL_Color[]> palette;
 
 public:
@@ -9,6 +9,7 @@
  */
 #include "StdInc.h"
 #include "Canvas.h"
+#include "DirtyRegion.h"
 
 #include "../gui/CGuiHandler.h"
 #include "../render/IRenderHandler.h"
@@ -25,7 +26,8 @@
 Canvas::Canvas(SDL_Surface * surface, CanvasScalingPolicy scalingPolicy):
 	scalingPolicy(scalingPolicy),
 	surface(surface),
-	renderArea(0,0, surface->w, surface->h)
+	renderArea(0,0, surface->w, surface->h),
+	dirtyRegion(nullptr)
 {
 	surface->refcount++;
 }
@@ -33,7 +35,8 @@ Canvas::Canvas(SDL_Surface * surface, CanvasScalingPolicy scalingPolicy):
 Canvas::Canvas(const Canvas & other):
 	scalingPolicy(other.scalingPolicy),
 	surface(other.surface),
-	renderArea(other.renderArea)
+	renderArea(other.renderArea),
+	dirtyRegion(other.dirtyRegion)
 {
 	surface->refcount++;
 }
@@ -41,7 +44,8 @@ Canvas::Canvas(const Canvas & other):
 Canvas::Canvas(Canvas && other):
 	scalingPolicy(other.scalingPolicy),
 	surface(other.surface),
-	renderArea(other.renderArea)
+	renderArea(other.renderArea),
+	dirtyRegion(other.dirtyRegion)
 {
 	surface->refcount++;
 }
@@ -56,7 +60,8 @@ Canvas::Canvas(const Canvas & other, const Rect & newClipRect):
 Canvas::Canvas(const Point & size, CanvasScalingPolicy scalingPolicy):
 	scalingPolicy(scalingPolicy),
 	surface(CSDL_Ext::newSurface(size * getScalingFactor())),
-	renderArea(Point(0,0), size * getScalingFactor())
+	renderArea(Point(0,0), size * getScalingFactor()),
+	dirtyRegion(nullptr)
 {
 	CSDL_Ext::fillSurface(surface, CSDL_Ext::toSDL(Colors::TRANSPARENCY) );
 	SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
@@ -79,6 +84,36 @@ Point Canvas::transformSize(const Point & input)
 	return input * getScalingFactor();
 }
 
+void Canvas::markDirty(const Rect & area)
+{
+	if (dirtyRegion)
+		dirtyRegion->add(area.intersect(renderArea));
+}
+
+void Canvas::markDirtyText(const IFont & font, const Point & position, ETextAlignment alignment, const std::vector<std::string> & text)
+{
+	if (!dirtyRegion)
+		return;
+
+	Point size(0, font.getLineHeightScaled() * text.size());
+	for (const auto & line : text)
+		vstd::amax(size.x, font.getStringWidthScaled(line));
+
+	Point topLeft = transformPos(position);
+	if (alignment == ETextAlignment::TOPCENTER || alignment == ETextAlignment::CENTER)
+		topLeft -= size / 2;
+	if (alignment == ETextAlignment::BOTTOMRIGHT)
+		topLeft -= size;
+
+	// include some space for font shadows and rounding of centered text
+	markDirty(Rect(topLeft, size).resize(2 * getScalingFactor()));
+}
+
+void Canvas::trackChanges(DirtyRegion * region)
+{
+	dirtyRegion = region;
+}
+
 Canvas Canvas::createFromSurface(SDL_Surface * surface, CanvasScalingPolicy scalingPolicy)
 {
 	return Canvas(surface, scalingPolicy);
@@ -94,6 +129,7 @@ void Canvas::applyTransparency(bool on)
 
 void Canvas::applyGrayscale()
 {
+	markDirty(renderArea);
 	CSDL_Ext::convertToGrayscale(surface, renderArea);
 }
 
@@ -106,7 +142,10 @@ void Canvas::draw(const std::shared_ptr<IImage>& image, const Point & pos)
 {
 	assert(image);
 	if (image)
+	{
 		image->draw(surface, transformPos(pos));
+		markDirty(Rect(transformPos(pos), transformSize(image->dimensions())));
+	}
 }
 
 void Canvas::draw(const std::shared_ptr<IImage>& image, const Point & pos, const Rect & sourceRect)
@@ -114,12 +153,16 @@ void Canvas::draw(const std::shared_ptr<IImage>& image, const Point & pos, const
 	Rect realSourceRect = sourceRect * getScalingFactor();
 	assert(image);
 	if (image)
+	{
 		image->draw(surface, transformPos(pos), &realSourceRect);
+		markDirty(Rect(transformPos(pos), realSourceRect.dimensions()));
+	}
 }
 
 void Canvas::draw(const Canvas & image, const Point & pos)
 {
 	CSDL_Ext::blitSurface(image.surface, image.renderArea, surface, transformPos(pos));
+	markDirty(Rect(transformPos(pos), image.renderArea.dimensions()));
 }
 
 void Canvas::drawTransparent(const Canvas & image, const Point & pos, double transparency)
@@ -132,23 +175,29 @@ void Canvas::drawTransparent(const Canvas & image, const Point & pos, double tra
 	CSDL_Ext::blitSurface(image.surface, image.renderArea, surface, transformPos(pos));
 	SDL_SetSurfaceAlphaMod(image.surface, 255);
 	SDL_SetSurfaceBlendMode(image.surface, oldMode);
+	markDirty(Rect(transformPos(pos), image.renderArea.dimensions()));
 }
 
 void Canvas::drawScaled(const Canvas & image, const Point & pos, const Point & targetSize)
 {
 	SDL_Rect targetRect = CSDL_Ext::toSDL(Rect(transformPos(pos), transformSize(targetSize)));
 	SDL_BlitScaled(image.surface, nullptr, surface, &targetRect);
+	markDirty(Rect(transformPos(pos), transformSize(targetSize)));
 }
 
 void Canvas::drawPoint(const Point & dest, const ColorRGBA & color)
 {
 	Point point = transformPos(dest);
 	CSDL_Ext::putPixelWithoutRefreshIfInSurf(surface, point.x, point.y, color.r, color.g, color.b, color.a);
+	markDirty(Rect(point, Point(1, 1)));
 }
 
 void Canvas::drawLine(const Point & from, const Point & dest, const ColorRGBA & colorFrom, const ColorRGBA & colorDest)
 {
 	CSDL_Ext::drawLine(surface, transformPos(from), transformPos(dest), CSDL_Ext::toSDL(colorFrom), CSDL_Ext::toSDL(colorDest), getScalingFactor());
+
+	Rect lineArea(transformPos(from), Point(1, 1));
+	markDirty(lineArea.include(Rect(transformPos(dest), Point(1, 1))).resize(getScalingFactor()));
 }
 
 void Canvas::drawBorder(const Rect & target, const ColorRGBA & color, int width)
@@ -156,6 +205,7 @@ void Canvas::drawBorder(const Rect & target, const ColorRGBA & color, int width)
 	Rect realTarget = target * getScalingFactor() + renderArea.topLeft();
 
 	CSDL_Ext::drawBorder(surface, realTarget.x, realTarget.y, realTarget.w, realTarget.h, CSDL_Ext::toSDL(color), width * getScalingFactor());
+	markDirty(realTarget);
 }
 
 void Canvas::drawBorderDashed(const Rect & target, const ColorRGBA & color)
@@ -166,11 +216,13 @@ void Canvas::drawBorderDashed(const Rect & target, const ColorRGBA & color)
 	CSDL_Ext::drawLineDashed(surface, realTarget.bottomLeft(), realTarget.bottomRight(), CSDL_Ext::toSDL(color));
 	CSDL_Ext::drawLineDashed(surface, realTarget.topLeft(),    realTarget.bottomLeft(),  CSDL_Ext::toSDL(color));
 	CSDL_Ext::drawLineDashed(surface, realTarget.topRight(),   realTarget.bottomRight(), CSDL_Ext::toSDL(color));
+	markDirty(realTarget.resize(1));
 }
 
 void Canvas::drawText(const Point & position, const EFonts & font, const ColorRGBA & colorDest, ETextAlignment alignment, const std::string & text )
 {
 	const auto & fontPtr = GH.renderHandler().loadFont(font);
+	markDirtyText(*fontPtr, position, alignment, {text});
 
 	switch (alignment)
 	{
@@ -184,6 +236,7 @@ void Canvas::drawText(const Point & position, const EFonts & font, const ColorRG
 void Canvas::drawText(const Point & position, const EFonts & font, const ColorRGBA & colorDest, ETextAlignment alignment, const std::vector<std::string> & text )
 {
 	const auto & fontPtr = GH.renderHandler().loadFont(font);
+	markDirtyText(*fontPtr, position, alignment, text);
 
 	switch (alignment)
 	{
@@ -199,6 +252,7 @@ void Canvas::drawColor(const Rect & target, const ColorRGBA & color)
 	Rect realTarget = target * getScalingFactor() + renderArea.topLeft();
 
 	CSDL_Ext::fillRect(surface, realTarget, CSDL_Ext::toSDL(color));
+	markDirty(realTarget);
 }
 
 void Canvas::drawColorBlended(const Rect & target, const ColorRGBA & color)
@@ -206,6 +260,7 @@ void Canvas::drawColorBlended(const Rect & target, const ColorRGBA & color)
 	Rect realTarget = target * getScalingFactor() + renderArea.topLeft();
 
 	CSDL_Ext::fillRectBlended(surface, realTarget, CSDL_Ext::toSDL(color));
+	markDirty(realTarget);
 }
 
 void Canvas::fillTexture(const std::shared_ptr<IImage>& image)
@@ -214,6 +269,8 @@ void Canvas::fillTexture(const std::shared_ptr<IImage>& image)
 	if (!image)
 		return;
 		
+	markDirty(renderArea);
+
 	Rect imageArea(Point(0, 0), image->dimensions());
 	for (int y=0; y < surface->h; y+= imageArea.h)
 	{
@@ -15,6 +15,8 @@
 
 struct SDL_Surface;
 class IImage;
+class IFont;
+class DirtyRegion;
 enum EFonts : int8_t;
 
 enum class CanvasScalingPolicy
@@ -36,6 +38,9 @@ class Canvas
 	/// Current rendering area, all rendering operations will be moved into selected area
 	Rect renderArea;
 
+	/// If set, all modified areas of target surface will be recorded here
+	DirtyRegion * dirtyRegion;
+
 	/// constructs canvas using existing surface. Caller maintains ownership on the surface
 	explicit Canvas(SDL_Surface * surface, CanvasScalingPolicy scalingPolicy);
 
@@ -45,6 +50,8 @@ class Canvas
 	Point transformPos(const Point & input);
 	Point transformSize(const Point & input);
 
+	void markDirtyText(const IFont & font, const Point & position, ETextAlignment alignment, const std::vector<std::string> & text);
+
 public:
 	Canvas & operator = (const Canvas & other) = delete;
 	Canvas & operator = (Canvas && other) = delete;
@@ -64,6 +71,10 @@ public:
 
 	~Canvas();
 
+	/// records all subsequent changes made via this canvas, or canvases created from it, in provided region
+	/// Region must remain valid for lifetime of this canvas
+	void trackChanges(DirtyRegion * region);
+
 	/// if set to true, drawing this canvas onto another canvas will use alpha channel information
 	void applyTransparency(bool on);
 
@@ -114,7 +125,11 @@ public:
 
 	int getScalingFactor() const;
 
+	/// records area that was modified without using canvas methods, in surface coordinates
+	void markDirty(const Rect & area);
+
 	/// Compatibility method. AVOID USAGE. To be removed once SDL abstraction layer is finished.
+	/// Any drawing done on returned surface must be reported via markDirty
 	SDL_Surface * getInternalSurface();
 
 	/// get the render area
@@ -0,0 +1,80 @@
+/*
+ * DirtyRegion.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "DirtyRegion.h"
+
+void DirtyRegion::add(const Rect & area)
+{
+	if(area.w <= 0 || area.h <= 0)
+		return;
+
+	Rect merged = area;
+
+	// merge all areas that overlap with new one. Merged area may now overlap with areas that were checked before, so repeat until nothing changes
+	for(bool changed = true; changed;)
+	{
+		changed = false;
+		for(auto it = areas.begin(); it != areas.end();)
+		{
+			if(it->intersectionTest(merged))
+			{
+				merged = merged.include(*it);
+				it = areas.erase(it);
+				changed = true;
+			}
+			else
+				++it;
+		}
+	}
+
+	areas.push_back(merged);
+
+	if(areas.size() > maxAreas)
+		collapse();
+}
+
+void DirtyRegion::add(const DirtyRegion & other)
+{
+	for(const auto & area : other.areas)
+		add(area);
+}
+
+void DirtyRegion::collapse()
+{
+	Rect bounds = areas.front();
+	for(const auto & area : areas)
+		bounds = bounds.include(area);
+
+	areas.clear();
+	areas.push_back(bounds);
+}
+
+void DirtyRegion::clear()
+{
+	areas.clear();
+}
+
+bool DirtyRegion::empty() const
+{
+	return areas.empty();
+}
+
+const std::vector<Rect> & DirtyRegion::getAreas() const
+{
+	return areas;
+}
+
+int64_t DirtyRegion::getTotalArea() const
+{
+	int64_t result = 0;
+	for(const auto & area : areas)
+		result += static_cast<int64_t>(area.w) * area.h;
+	return result;
+}
@@ -0,0 +1,39 @@
+/*
+ * DirtyRegion.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../../lib/Rect.h"
+
+/// Set of rectangular areas of a surface that were modified since last update
+/// Overlapping areas are merged together, and once there are too many areas they are replaced with their bounding box
+class DirtyRegion
+{
+	static constexpr size_t maxAreas = 16;
+
+	std::vector<Rect> areas;
+
+	void collapse();
+
+public:
+	/// adds area to the region. Empty areas are ignored
+	void add(const Rect & area);
+
+	/// adds all areas from another region
+	void add(const DirtyRegion & other);
+
+	void clear();
+	bool empty() const;
+
+	/// returns list of non-overlapping areas in this region
+	const std::vector<Rect> & getAreas() const;
+
+	/// returns total number of pixels in this region
+	int64_t getTotalArea() const;
+};
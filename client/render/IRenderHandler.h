@@ -43,6 +43,11 @@ public:
 	/// Loads animation using given path
 	virtual std::shared_ptr<CAnimation> loadAnimation(const AnimationPath & path, EImageBlitMode mode) = 0;
 
+	/// Starts loading of image or all frames of animation in background, so later calls to loadImage or loadAnimation won't have to decode them
+	/// Does not block caller, prefetching is skipped for images that are already loaded
+	virtual void prefetchImage(const ImagePath & path, EImageBlitMode mode) = 0;
+	virtual void prefetchAnimation(const AnimationPath & path, EImageBlitMode mode) = 0;
+
 	/// Returns font with specified identifer
 	virtual std::shared_ptr<const IFont> loadFont(EFonts font) = 0;
 };
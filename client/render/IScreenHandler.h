@@ -15,6 +15,8 @@ class Point;
 class Rect;
 VCMI_LIB_NAMESPACE_END
 
+class TextureAtlas;
+
 class IScreenHandler
 {
 public:
@@ -50,4 +52,12 @@ public:
 
 	/// Window has focus
 	virtual bool hasFocus() = 0;
+
+	/// Registers atlas that will be rendered underneath screen surface on every frame, visible through its transparent areas
+	/// Returns false if current renderer can not compose screen surface with underlays, in which case atlas is not registered
+	virtual bool addUnderlay(TextureAtlas * atlas) = 0;
+	virtual void removeUnderlay(TextureAtlas * atlas) = 0;
+
+	/// Renders all registered underlays and prepares screen texture to be composed on top of them
+	virtual void renderUnderlays() = 0;
 };
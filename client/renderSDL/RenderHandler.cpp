@@ -13,6 +13,7 @@
 #include "SDLImage.h"
 #include "ImageScaled.h"
 #include "FontChain.h"
+#include "ScaledImageCache.h"
 
 #include "../gui/CGuiHandler.h"
 
@@ -38,21 +39,21 @@ std::shared_ptr<CDefFile> RenderHandler::getAnimationFile(const AnimationPath &
 {
 	AnimationPath actualPath = boost::starts_with(path.getName(), "SPRITES") ? path : path.addPrefix("SPRITES/");
 
-	auto it = animationFiles.find(actualPath);
-
-	if (it != animationFiles.end())
-		return it->second;
-
-	if (!CResourceHandler::get()->existsResource(actualPath))
 	{
-		animationFiles[actualPath] = nullptr;
-		return nullptr;
+		std::lock_guard lock(cacheMutex);
+		auto it = animationFiles.find(actualPath);
+
+		if (it != animationFiles.end())
+			return it->second;
 	}
 
-	auto result = std::make_shared<CDefFile>(actualPath);
+	std::shared_ptr<CDefFile> result;
+
+	if (CResourceHandler::get()->existsResource(actualPath))
+		result = std::make_shared<CDefFile>(actualPath);
 
-	animationFiles[actualPath] = result;
-	return result;
+	std::lock_guard lock(cacheMutex);
+	return animationFiles.try_emplace(actualPath, result).first->second;
 }
 
 std::optional<ResourcePath> RenderHandler::getPathForScaleFactor(const ResourcePath & path, const std::string & factor)
@@ -159,10 +160,13 @@ RenderHandler::AnimationLayoutMap & RenderHandler::getAnimationLayout(const Anim
 	auto animPath = AnimationPath::builtin(tmp.first.getName());
 	AnimationPath actualPath = boost::starts_with(animPath.getName(), "SPRITES") ? animPath : animPath.addPrefix("SPRITES/");
 
-	auto it = animationLayouts.find(actualPath);
+	{
+		std::lock_guard lock(cacheMutex);
+		auto it = animationLayouts.find(actualPath);
 
-	if (it != animationLayouts.end())
-		return it->second;
+		if (it != animationLayouts.end())
+			return it->second;
+	}
 
 	AnimationLayoutMap result;
 
@@ -193,8 +197,8 @@ RenderHandler::AnimationLayoutMap & RenderHandler::getAnimationLayout(const Anim
 		for(auto & i : g.second)
 			i.preScaledFactor = tmp.second;
 
-	animationLayouts[actualPath] = result;
-	return animationLayouts[actualPath];
+	std::lock_guard lock(cacheMutex);
+	return animationLayouts.try_emplace(actualPath, std::move(result)).first->second;
 }
 
 int RenderHandler::getScalingFactor() const
@@ -220,9 +224,8 @@ ImageLocator RenderHandler::getLocatorForAnimationFrame(const AnimationPath & pa
 
 std::shared_ptr<const ISharedImage> RenderHandler::loadImageImpl(const ImageLocator & locator)
 {
-	auto it = imageFiles.find(locator);
-	if (it != imageFiles.end())
-		return it->second;
+	if (auto cached = findCachedImage(locator))
+		return cached;
 
 	// TODO: order should be different:
 	// 1) try to find correctly scaled image
@@ -271,9 +274,21 @@ std::shared_ptr<const ISharedImage> RenderHandler::loadImageFromFileUncached(con
 	throw std::runtime_error("Invalid image locator received!");
 }
 
-void RenderHandler::storeCachedImage(const ImageLocator & locator, std::shared_ptr<const ISharedImage> image)
+std::shared_ptr<const ISharedImage> RenderHandler::findCachedImage(const ImageLocator & locator)
 {
-	imageFiles[locator] = image;
+	std::lock_guard lock(cacheMutex);
+	auto it = imageFiles.find(locator);
+	if (it != imageFiles.end())
+		return it->second;
+	return nullptr;
+}
+
+std::shared_ptr<const ISharedImage> RenderHandler::storeCachedImage(const ImageLocator & locator, std::shared_ptr<const ISharedImage> image)
+{
+	std::lock_guard lock(cacheMutex);
+	auto [it, inserted] = imageFiles.try_emplace(locator, image);
+	if (!inserted)
+		return it->second;
 
 #if 0
 	const boost::filesystem::path outPath = VCMIDirs::get().userExtractedPath() / "imageCache" / (locator.toString() + ".png");
@@ -282,22 +297,21 @@ void RenderHandler::storeCachedImage(const ImageLocator & locator, std::shared_p
 	boost::filesystem::create_directories(outDir);
 	image->exportBitmap(outPath , nullptr);
 #endif
+	return image;
 }
 
 std::shared_ptr<const ISharedImage> RenderHandler::loadImageFromFile(const ImageLocator & locator)
 {
-	if (imageFiles.count(locator))
-		return imageFiles.at(locator);
+	if (auto cached = findCachedImage(locator))
+		return cached;
 
-	auto result = loadImageFromFileUncached(locator);
-	storeCachedImage(locator, result);
-	return result;
+	return storeCachedImage(locator, loadImageFromFileUncached(locator));
 }
 
 std::shared_ptr<const ISharedImage> RenderHandler::transformImage(const ImageLocator & locator, std::shared_ptr<const ISharedImage> image)
 {
-	if (imageFiles.count(locator))
-		return imageFiles.at(locator);
+	if (auto cached = findCachedImage(locator))
+		return cached;
 
 	auto result = image;
 
@@ -307,14 +321,13 @@ std::shared_ptr<const ISharedImage> RenderHandler::transformImage(const ImageLoc
 	if (locator.horizontalFlip)
 		result = result->horizontalFlip();
 
-	storeCachedImage(locator, result);
-	return result;
+	return storeCachedImage(locator, result);
 }
 
 std::shared_ptr<const ISharedImage> RenderHandler::scaleImage(const ImageLocator & locator, std::shared_ptr<const ISharedImage> image)
 {
-	if (imageFiles.count(locator))
-		return imageFiles.at(locator);
+	if (auto cached = findCachedImage(locator))
+		return cached;
 
 	auto handle = image->createImageReference(locator.layer);
 
@@ -324,9 +337,7 @@ std::shared_ptr<const ISharedImage> RenderHandler::scaleImage(const ImageLocator
 
 	handle->scaleInteger(locator.scalingFactor);
 
-	auto result = handle->getSharedImage();
-	storeCachedImage(locator, result);
-	return result;
+	return storeCachedImage(locator, handle->getSharedImage());
 }
 
 std::shared_ptr<IImage> RenderHandler::loadImage(const ImageLocator & locator, EImageBlitMode mode)
@@ -407,6 +418,47 @@ std::shared_ptr<CAnimation> RenderHandler::loadAnimation(const AnimationPath & p
 	return std::make_shared<CAnimation>(path, getAnimationLayout(path), mode);
 }
 
+void RenderHandler::prefetchImage(const ImagePath & path, EImageBlitMode mode)
+{
+	prefetchImage(ImageLocator(path), mode);
+}
+
+void RenderHandler::prefetchImage(const ImageLocator & locator, EImageBlitMode mode)
+{
+	prefetchTasks.run([this, locator, mode]()
+	{
+		try
+		{
+			loadImage(locator, mode);
+		}
+		catch(const std::exception & e)
+		{
+			logGlobal->warn("Failed to prefetch image %s: %s", locator.toString(), e.what());
+		}
+	});
+}
+
+void RenderHandler::prefetchAnimation(const AnimationPath & path, EImageBlitMode mode)
+{
+	// layout is resolved on caller thread, so each frame can be decoded by separate task
+	const auto & layout = getAnimationLayout(path);
+
+	for (const auto & [group, frames] : layout)
+	{
+		for (size_t frame = 0; frame < frames.size(); ++frame)
+		{
+			ImageLocator locator = frames[frame].empty() ? ImageLocator(path, frame, group) : frames[frame];
+			prefetchImage(locator, mode);
+		}
+	}
+}
+
+RenderHandler::~RenderHandler()
+{
+	prefetchTasks.cancel();
+	prefetchTasks.wait();
+}
+
 void RenderHandler::addImageListEntries(const EntityService * service)
 {
 	service->forEachBase([this](const Entity * entity, bool & stop)
@@ -431,6 +483,8 @@ void RenderHandler::addImageListEntries(const EntityService * service)
 
 void RenderHandler::onLibraryLoadingFinished(const Services * services)
 {
+	ScaledImageCache::get().startWarmUp();
+
 	addImageListEntries(services->creatures());
 	addImageListEntries(services->heroTypes());
 	addImageListEntries(services->artifacts());
@@ -11,6 +11,8 @@
 
 #include "../render/IRenderHandler.h"
 
+#include <tbb/task_group.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 class EntityService;
 VCMI_LIB_NAMESPACE_END
@@ -28,6 +30,13 @@ class RenderHandler : public IRenderHandler
 	std::map<ImageLocator, std::shared_ptr<const ISharedImage>> imageFiles;
 	std::map<EFonts, std::shared_ptr<const IFont>> fonts;
 
+	/// Protects animation and image caches, which are also accessed by prefetching tasks
+	/// Lock is never held while files are decoded or images are transformed, so prefetching does not block GUI thread
+	std::mutex cacheMutex;
+
+	/// Tasks that load images in background before they are requested by GUI
+	tbb::task_group prefetchTasks;
+
 	std::shared_ptr<CDefFile> getAnimationFile(const AnimationPath & path);
 	std::optional<ResourcePath> getPathForScaleFactor(const ResourcePath & path, const std::string & factor);
 	std::pair<ResourcePath, int> getScalePath(const ResourcePath & p);
@@ -36,7 +45,10 @@ class RenderHandler : public IRenderHandler
 
 	void addImageListEntry(size_t index, size_t group, const std::string & listName, const std::string & imageName);
 	void addImageListEntries(const EntityService * service);
-	void storeCachedImage(const ImageLocator & locator, std::shared_ptr<const ISharedImage> image);
+	std::shared_ptr<const ISharedImage> findCachedImage(const ImageLocator & locator);
+
+	/// Stores image in cache and returns cached image, which may differ from provided one if another thread has loaded it first
+	std::shared_ptr<const ISharedImage> storeCachedImage(const ImageLocator & locator, std::shared_ptr<const ISharedImage> image);
 
 	std::shared_ptr<const ISharedImage> loadImageImpl(const ImageLocator & config);
 
@@ -50,7 +62,10 @@ class RenderHandler : public IRenderHandler
 
 	int getScalingFactor() const;
 
+	void prefetchImage(const ImageLocator & locator, EImageBlitMode mode);
+
 public:
+	~RenderHandler();
 
 	// IRenderHandler implementation
 	void onLibraryLoadingFinished(const Services * services) override;
@@ -61,6 +76,9 @@ public:
 
 	std::shared_ptr<CAnimation> loadAnimation(const AnimationPath & path, EImageBlitMode mode) override;
 
+	void prefetchImage(const ImagePath & path, EImageBlitMode mode) override;
+	void prefetchAnimation(const AnimationPath & path, EImageBlitMode mode) override;
+
 	std::shared_ptr<IImage> createImage(SDL_Surface * source) override;
 
 	/// Returns font with specified identifer
@@ -11,6 +11,7 @@
 #include "SDL_Extensions.h"
 
 #include "SDL_PixelAccess.h"
+#include "ScaledImageCache.h"
 
 #include "../gui/CGuiHandler.h"
 #include "../render/Graphics.h"
@@ -682,6 +683,9 @@ SDL_Surface * CSDL_Ext::scaleSurfaceIntegerFactor(SDL_Surface * surf, int factor
 		case EScalingAlgorithm::XBRZ_ALPHA:
 		case EScalingAlgorithm::XBRZ_OPAQUE:
 		{
+			if(ScaledImageCache::get().load(srcPixels, intermediate->w, intermediate->h, factor, algorithm, dstPixels))
+				break;
+
 			auto format = algorithm == EScalingAlgorithm::XBRZ_OPAQUE ? xbrz::ColorFormat::ARGB_CLAMPED : xbrz::ColorFormat::ARGB;
 
 			if(intermediate->h < 32)
@@ -699,6 +703,8 @@ SDL_Surface * CSDL_Ext::scaleSurfaceIntegerFactor(SDL_Surface * surf, int factor
 				});
 			}
 
+			ScaledImageCache::get().store(srcPixels, intermediate->w, intermediate->h, factor, algorithm, dstPixels);
+
 			break;
 		}
 		default:
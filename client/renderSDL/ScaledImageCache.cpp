@@ -0,0 +1,418 @@
+/*
+ * ScaledImageCache.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "ScaledImageCache.h"
+
+#include "SDL_Extensions.h"
+
+#include "../../lib/CConfigHandler.h"
+#include "../../lib/CThreadHelper.h"
+#include "../../lib/VCMIDirs.h"
+
+#include <boost/crc.hpp>
+#include <zlib.h>
+
+/// Must be increased whenever upscaling algorithms or format of cache entries change, to discard outdated entries
+static constexpr int cacheFormatVersion = 2;
+
+/// Small images are fast to upscale and are not worth the disk access
+static constexpr int minimalCacheableArea = 32 * 32;
+
+/// Limit on total size of compressed entries that can be preloaded into memory by warm-up
+static constexpr size_t warmUpMemoryLimit = 256 * 1024 * 1024;
+
+/// Time after finished warm-up during which preloaded entries are kept in memory. Entries that were not requested
+/// by then are unlikely to be needed, e.g. entries created for different scaling factor
+static constexpr auto warmUpGracePeriod = boost::chrono::minutes(2);
+
+/// Limit on total size of upscaled images waiting to be written. If writer can't keep up, new images are not cached
+static constexpr size_t pendingEntriesMemoryLimit = 64 * 1024 * 1024;
+
+/// 64-bit FNV-1a hash of image pixels, used as entry name
+static uint64_t hashPixels(const uint32_t * pixels, size_t pixelsCount)
+{
+	const auto * bytes = reinterpret_cast<const uint8_t *>(pixels);
+	uint64_t hash = 0xcbf29ce484222325ULL;
+
+	for(size_t i = 0; i < pixelsCount * sizeof(uint32_t); ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+/// Checksum of image pixels, stored in entry to detect collisions of entry names
+static uint32_t checksumPixels(const uint32_t * pixels, size_t pixelsCount)
+{
+	boost::crc_32_type checksum;
+	checksum.process_bytes(pixels, pixelsCount * sizeof(uint32_t));
+	return checksum.checksum();
+}
+
+static std::vector<uint8_t> readFile(const boost::filesystem::path & path)
+{
+	boost::filesystem::ifstream file(path, std::ios::binary | std::ios::ate);
+	if(!file)
+		return {};
+
+	std::vector<uint8_t> result(file.tellg());
+	file.seekg(0);
+	file.read(reinterpret_cast<char *>(result.data()), result.size());
+
+	if(!file)
+		return {};
+	return result;
+}
+
+ScaledImageCache::ScaledImageCache()
+	: cacheDirectory(VCMIDirs::get().userCachePath() / "scaledImages" / std::to_string(cacheFormatVersion))
+	, enabled(settings["video"]["upscalingCache"].Bool())
+	, pendingEntriesSize(0)
+	, writerStopRequested(false)
+	, cacheSize(0)
+	, cacheSizeLimit(std::max<int64_t>(1, settings["video"]["upscalingCacheSize"].Integer()) * 1024 * 1024)
+{
+	if(!enabled)
+		return;
+
+	boost::system::error_code ec;
+	boost::filesystem::create_directories(cacheDirectory, ec);
+	if(ec)
+	{
+		logGlobal->warn("Failed to create directory for scaled images cache: %s", ec.message());
+		enabled = false;
+		return;
+	}
+
+	writerThread = boost::thread(&ScaledImageCache::runWriter, this);
+}
+
+ScaledImageCache::~ScaledImageCache()
+{
+	stopWarmUp();
+
+	if(writerThread.joinable())
+	{
+		{
+			boost::unique_lock lock(pendingEntriesMutex);
+			writerStopRequested = true;
+		}
+		pendingEntriesCondition.notify_one();
+		writerThread.join();
+	}
+}
+
+ScaledImageCache & ScaledImageCache::get()
+{
+	static ScaledImageCache instance;
+	return instance;
+}
+
+std::string ScaledImageCache::getEntryName(const uint32_t * sourcePixels, int width, int height, int factor, EScalingAlgorithm algorithm) const
+{
+	uint64_t hash = hashPixels(sourcePixels, static_cast<size_t>(width) * height);
+
+	return boost::str(boost::format("%016x_%dx%d_%dx_%d.bin") % hash % width % height % factor % static_cast<int>(algorithm));
+}
+
+std::vector<uint8_t> ScaledImageCache::readEntry(const std::string & entryName)
+{
+	{
+		std::lock_guard lock(preloadedEntriesMutex);
+		auto it = preloadedEntries.find(entryName);
+		if(it != preloadedEntries.end())
+		{
+			auto result = std::move(it->second);
+			preloadedEntries.erase(it);
+			return result;
+		}
+	}
+
+	return readFile(cacheDirectory / entryName);
+}
+
+bool ScaledImageCache::isCacheable(int width, int height) const
+{
+	return enabled && width * height >= minimalCacheableArea;
+}
+
+bool ScaledImageCache::load(const uint32_t * sourcePixels, int width, int height, int factor, EScalingAlgorithm algorithm, uint32_t * scaledPixels)
+{
+	if(!isCacheable(width, height))
+		return false;
+
+	std::string entryName = getEntryName(sourcePixels, width, height, factor, algorithm);
+	std::vector<uint8_t> entry = readEntry(entryName);
+
+	if(entry.empty())
+		return false;
+
+	// entry consists of checksum of source pixels followed by compressed upscaled pixels
+	uint32_t storedChecksum = 0;
+	if(entry.size() <= sizeof(storedChecksum))
+	{
+		removeCorruptedEntry(entryName);
+		return false;
+	}
+
+	std::memcpy(&storedChecksum, entry.data(), sizeof(storedChecksum));
+
+	if(storedChecksum != checksumPixels(sourcePixels, static_cast<size_t>(width) * height))
+	{
+		// either corrupted entry or different image with same hash. In both cases entry will be overwritten by this image
+		logGlobal->debug("Entry '%s' of scaled images cache does not match source image", entryName);
+		return false;
+	}
+
+	const uLongf expectedSize = static_cast<uLongf>(width) * factor * height * factor * sizeof(uint32_t);
+	uLongf actualSize = expectedSize;
+
+	int result = uncompress(reinterpret_cast<Bytef *>(scaledPixels), &actualSize, entry.data() + sizeof(storedChecksum), entry.size() - sizeof(storedChecksum));
+
+	if(result != Z_OK || actualSize != expectedSize)
+	{
+		removeCorruptedEntry(entryName);
+		return false;
+	}
+
+	// mark entry as recently used, so it will not be pruned
+	pushPendingEntry({entryName, storedChecksum, {}});
+	return true;
+}
+
+void ScaledImageCache::removeCorruptedEntry(const std::string & entryName)
+{
+	logGlobal->warn("Discarding corrupted entry '%s' of scaled images cache", entryName);
+	boost::system::error_code ec;
+	boost::filesystem::remove(cacheDirectory / entryName, ec);
+}
+
+void ScaledImageCache::store(const uint32_t * sourcePixels, int width, int height, int factor, EScalingAlgorithm algorithm, const uint32_t * scaledPixels)
+{
+	if(!isCacheable(width, height))
+		return;
+
+	const size_t scaledPixelsCount = static_cast<size_t>(width) * factor * height * factor;
+
+	PendingEntry entry;
+	entry.name = getEntryName(sourcePixels, width, height, factor, algorithm);
+	entry.sourceChecksum = checksumPixels(sourcePixels, static_cast<size_t>(width) * height);
+	entry.pixels.assign(scaledPixels, scaledPixels + scaledPixelsCount);
+
+	pushPendingEntry(std::move(entry));
+}
+
+void ScaledImageCache::pushPendingEntry(PendingEntry && entry)
+{
+	size_t entrySize = entry.pixels.size() * sizeof(uint32_t);
+
+	{
+		boost::unique_lock lock(pendingEntriesMutex);
+
+		if(pendingEntriesSize + entrySize > pendingEntriesMemoryLimit)
+			return;
+
+		pendingEntriesSize += entrySize;
+		pendingEntries.push_back(std::move(entry));
+	}
+	pendingEntriesCondition.notify_one();
+}
+
+void ScaledImageCache::runWriter()
+{
+	setThreadName("scaledImagesWriter");
+
+	// computes size of existing cache and removes old entries, if cache size limit was reduced since last run
+	pruneEntries();
+
+	while(true)
+	{
+		PendingEntry entry;
+
+		{
+			boost::unique_lock lock(pendingEntriesMutex);
+			pendingEntriesCondition.wait(lock, [this](){ return writerStopRequested || !pendingEntries.empty(); });
+
+			// all pending entries are written before stopping
+			if(pendingEntries.empty())
+				return;
+
+			entry = std::move(pendingEntries.front());
+			pendingEntries.pop_front();
+			pendingEntriesSize -= entry.pixels.size() * sizeof(uint32_t);
+		}
+
+		if(entry.pixels.empty())
+			touchEntry(entry.name);
+		else
+			writeEntry(entry);
+	}
+}
+
+void ScaledImageCache::writeEntry(const PendingEntry & entry)
+{
+	const uLong scaledSize = entry.pixels.size() * sizeof(uint32_t);
+	std::vector<uint8_t> data(sizeof(entry.sourceChecksum) + compressBound(scaledSize));
+	uLongf compressedSize = data.size() - sizeof(entry.sourceChecksum);
+
+	std::memcpy(data.data(), &entry.sourceChecksum, sizeof(entry.sourceChecksum));
+
+	if(compress2(data.data() + sizeof(entry.sourceChecksum), &compressedSize, reinterpret_cast<const Bytef *>(entry.pixels.data()), scaledSize, Z_BEST_SPEED) != Z_OK)
+		return;
+
+	const size_t entrySize = sizeof(entry.sourceChecksum) + compressedSize;
+
+	// write into temporary file first, so other running game instances will never see partially written entry
+	boost::system::error_code ec;
+	const auto entryPath = cacheDirectory / entry.name;
+	const auto temporaryPath = cacheDirectory / boost::filesystem::unique_path("%%%%-%%%%-%%%%.tmp");
+
+	{
+		boost::filesystem::ofstream file(temporaryPath, std::ios::binary);
+		file.write(reinterpret_cast<const char *>(data.data()), entrySize);
+		if(!file)
+		{
+			logGlobal->warn("Failed to write entry of scaled images cache into %s", temporaryPath.string());
+			file.close();
+			boost::filesystem::remove(temporaryPath, ec);
+			return;
+		}
+	}
+
+	boost::filesystem::rename(temporaryPath, entryPath, ec);
+	if(ec)
+	{
+		boost::filesystem::remove(temporaryPath, ec);
+		return;
+	}
+
+	cacheSize += entrySize;
+	if(cacheSize > cacheSizeLimit)
+		pruneEntries();
+}
+
+void ScaledImageCache::touchEntry(const std::string & entryName)
+{
+	boost::system::error_code ec;
+	boost::filesystem::last_write_time(cacheDirectory / entryName, std::time(nullptr), ec);
+}
+
+void ScaledImageCache::pruneEntries()
+{
+	struct CacheFile
+	{
+		boost::filesystem::path path;
+		std::time_t lastUsed;
+		uintmax_t size;
+	};
+
+	std::vector<CacheFile> files;
+	boost::system::error_code ec;
+
+	cacheSize = 0;
+	for(const auto & entry : boost::filesystem::directory_iterator(cacheDirectory, ec))
+	{
+		if(entry.path().extension() != ".bin")
+			continue;
+
+		CacheFile file{entry.path(), boost::filesystem::last_write_time(entry.path(), ec), boost::filesystem::file_size(entry.path(), ec)};
+		if(ec)
+			continue;
+
+		cacheSize += file.size;
+		files.push_back(file);
+	}
+
+	if(cacheSize <= cacheSizeLimit)
+		return;
+
+	// remove more than strictly necessary, so pruning is not repeated after every new entry
+	const uintmax_t targetSize = cacheSizeLimit / 4 * 3;
+	size_t removedFiles = 0;
+
+	std::sort(files.begin(), files.end(), [](const CacheFile & left, const CacheFile & right)
+	{
+		return left.lastUsed < right.lastUsed;
+	});
+
+	for(const auto & file : files)
+	{
+		if(cacheSize <= targetSize)
+			break;
+
+		boost::filesystem::remove(file.path, ec);
+		if(ec)
+			continue;
+
+		cacheSize -= file.size;
+		removedFiles++;
+	}
+
+	logGlobal->debug("Removed %d least recently used entries from scaled images cache", removedFiles);
+}
+
+void ScaledImageCache::runWarmUp()
+{
+	setThreadName("scaledImagesWarmUp");
+
+	size_t totalSize = 0;
+	boost::system::error_code ec;
+
+	for(const auto & entry : boost::filesystem::directory_iterator(cacheDirectory, ec))
+	{
+		boost::this_thread::interruption_point();
+
+		if(entry.path().extension() != ".bin")
+			continue;
+
+		auto fileSize = boost::filesystem::file_size(entry.path(), ec);
+		if(ec || totalSize + fileSize > warmUpMemoryLimit)
+			continue;
+
+		auto data = readFile(entry.path());
+		totalSize += data.size();
+
+		std::lock_guard lock(preloadedEntriesMutex);
+		preloadedEntries.emplace(entry.path().filename().string(), std::move(data));
+	}
+
+	logGlobal->debug("Preloaded %d KB of scaled images", totalSize / 1024);
+
+	boost::this_thread::sleep_for(warmUpGracePeriod);
+	discardPreloadedEntries();
+}
+
+void ScaledImageCache::discardPreloadedEntries()
+{
+	std::lock_guard lock(preloadedEntriesMutex);
+
+	if(!preloadedEntries.empty())
+		logGlobal->debug("Discarding %d unused preloaded scaled images", preloadedEntries.size());
+	preloadedEntries.clear();
+}
+
+void ScaledImageCache::startWarmUp()
+{
+	if(!enabled || !settings["video"]["upscalingCacheWarmUp"].Bool() || warmUpThread.joinable())
+		return;
+
+	warmUpThread = boost::thread(&ScaledImageCache::runWarmUp, this);
+}
+
+void ScaledImageCache::stopWarmUp()
+{
+	if(!warmUpThread.joinable())
+		return;
+
+	warmUpThread.interrupt();
+	warmUpThread.join();
+	discardPreloadedEntries();
+}
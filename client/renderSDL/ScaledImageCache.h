@@ -0,0 +1,83 @@
+/*
+ * ScaledImageCache.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+enum class EScalingAlgorithm : int8_t;
+
+/// Persistent on-disk cache of images upscaled using xBRZ, to avoid paying for expensive upscaling on every game start
+/// Entries are identified by 64-bit hash of source pixels, their dimensions, scaling factor and scaling algorithm
+/// Each entry also contains checksum of source pixels, which is verified on load to detect hash collisions
+/// Entries are compressed and written by background thread. Least recently used entries are removed once cache exceeds its size limit
+class ScaledImageCache : boost::noncopyable
+{
+	/// Upscaled image waiting to be written to disk, or, if pixels are empty, existing entry that was used and should be marked as recent
+	struct PendingEntry
+	{
+		std::string name;
+		uint32_t sourceChecksum;
+		std::vector<uint32_t> pixels;
+	};
+
+	boost::filesystem::path cacheDirectory;
+	bool enabled;
+
+	/// Compressed entries that were read from disk in advance by warm-up thread. Entries are removed once requested,
+	/// remaining ones are discarded shortly after warm-up is over
+	std::map<std::string, std::vector<uint8_t>> preloadedEntries;
+	std::mutex preloadedEntriesMutex;
+
+	boost::thread warmUpThread;
+
+	std::deque<PendingEntry> pendingEntries;
+	size_t pendingEntriesSize;
+	bool writerStopRequested;
+	boost::mutex pendingEntriesMutex;
+	boost::condition_variable pendingEntriesCondition;
+	boost::thread writerThread;
+
+	/// Total size of entries on disk, only accessed by writer thread
+	uintmax_t cacheSize;
+	uintmax_t cacheSizeLimit;
+
+	std::string getEntryName(const uint32_t * sourcePixels, int width, int height, int factor, EScalingAlgorithm algorithm) const;
+	std::vector<uint8_t> readEntry(const std::string & entryName);
+	void removeCorruptedEntry(const std::string & entryName);
+
+	void runWarmUp();
+	void discardPreloadedEntries();
+
+	void pushPendingEntry(PendingEntry && entry);
+	void runWriter();
+	void writeEntry(const PendingEntry & entry);
+	void touchEntry(const std::string & entryName);
+	void pruneEntries();
+
+	ScaledImageCache();
+public:
+	~ScaledImageCache();
+
+	static ScaledImageCache & get();
+
+	/// Returns true if cache should be used for image of specified size
+	bool isCacheable(int width, int height) const;
+
+	/// Attempts to load upscaled image from cache into provided buffer of (width * factor) x (height * factor) pixels
+	/// Returns false if there is no such image in cache
+	bool load(const uint32_t * sourcePixels, int width, int height, int factor, EScalingAlgorithm algorithm, uint32_t * scaledPixels);
+
+	/// Schedules writing of upscaled image into cache. Image is copied and can be released after this call
+	void store(const uint32_t * sourcePixels, int width, int height, int factor, EScalingAlgorithm algorithm, const uint32_t * scaledPixels);
+
+	/// Starts background thread that reads existing cache entries into memory, if enabled in settings
+	void startWarmUp();
+
+	/// Stops background warm-up thread, if any, and discards all preloaded entries
+	void stopWarmUp();
+};
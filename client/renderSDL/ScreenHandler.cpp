@@ -10,6 +10,7 @@
 
 #include "StdInc.h"
 #include "ScreenHandler.h"
+#include "TextureAtlas.h"
 
 #include "../../lib/CConfigHandler.h"
 #include "../../lib/constants/StringConstants.h"
@@ -636,6 +637,42 @@ void ScreenHandler::close()
 	SDL_Quit();
 }
 
+/// Screen surface is premultiplied by alpha: whatever was blended onto its transparent areas is already multiplied by own alpha
+static SDL_BlendMode getUnderlayBlendMode()
+{
+	return SDL_ComposeCustomBlendMode(
+		SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+		SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+	);
+}
+
+bool ScreenHandler::addUnderlay(TextureAtlas * atlas)
+{
+	if(SDL_SetTextureBlendMode(screenTexture, getUnderlayBlendMode()) != 0)
+	{
+		logGlobal->warn("Renderer does not support composition of screen with underlays: %s", SDL_GetError());
+		SDL_SetTextureBlendMode(screenTexture, SDL_BLENDMODE_NONE);
+		return false;
+	}
+
+	underlays.push_back(atlas);
+	return true;
+}
+
+void ScreenHandler::removeUnderlay(TextureAtlas * atlas)
+{
+	vstd::erase(underlays, atlas);
+}
+
+void ScreenHandler::renderUnderlays()
+{
+	// screen texture may have been recreated since last frame
+	SDL_SetTextureBlendMode(screenTexture, underlays.empty() ? SDL_BLENDMODE_NONE : getUnderlayBlendMode());
+
+	for(auto * atlas : underlays)
+		atlas->render();
+}
+
 void ScreenHandler::clearScreen()
 {
 	SDL_SetRenderDrawColor(mainRenderer, 0, 0, 0, 255);
@@ -46,6 +46,8 @@ class ScreenHandler final : public IScreenHandler
 {
 	EUpscalingFilter upscalingFilter = EUpscalingFilter::AUTO;
 
+	std::vector<TextureAtlas *> underlays;
+
 	/// Dimensions of target surfaces/textures, this value is what game logic views as screen size
 	Point getPreferredLogicalResolution() const;
 
@@ -118,4 +120,8 @@ public:
 	std::vector<Point> getSupportedResolutions(int displayIndex) const;
 	std::tuple<int, int> getSupportedScalingRange() const final;
 	Rect convertLogicalPointsToWindow(const Rect & input) const final;
+
+	bool addUnderlay(TextureAtlas * atlas) final;
+	void removeUnderlay(TextureAtlas * atlas) final;
+	void renderUnderlays() final;
 };
@@ -0,0 +1,85 @@
+/*
+ * TextureAtlas.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "TextureAtlas.h"
+
+#include "SDL_Extensions.h"
+
+#include "../CMT.h"
+
+#include <SDL_render.h>
+#include <SDL_surface.h>
+
+TextureAtlas::TextureAtlas(const Point & dimensions)
+	: texture(SDL_CreateTexture(mainRenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, dimensions.x, dimensions.y))
+	, dimensions(dimensions)
+{
+	if(texture)
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+	else
+		logGlobal->warn("Failed to create texture atlas %dx%d: %s", dimensions.x, dimensions.y, SDL_GetError());
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	// textures are destroyed together with renderer, which may happen before destruction of atlas
+	if(texture && mainRenderer)
+		SDL_DestroyTexture(texture);
+}
+
+bool TextureAtlas::isValid() const
+{
+	return texture != nullptr;
+}
+
+void TextureAtlas::upload(SDL_Surface * source, const Rect & area)
+{
+	Rect clipped = area.intersect(Rect(Point(0, 0), dimensions));
+
+	if(clipped.w <= 0 || clipped.h <= 0)
+		return;
+
+	assert(source->format->format == SDL_PIXELFORMAT_ARGB8888);
+
+	SDL_Rect targetRect = CSDL_Ext::toSDL(clipped);
+	const auto * pixels = static_cast<const uint8_t *>(source->pixels) + clipped.y * source->pitch + clipped.x * source->format->BytesPerPixel;
+
+	SDL_UpdateTexture(texture, &targetRect, pixels, source->pitch);
+}
+
+void TextureAtlas::resetQueue(const Rect & screenClipRect)
+{
+	clipRect = screenClipRect;
+	queuedQuads.clear();
+}
+
+void TextureAtlas::queueQuad(const Rect & atlasArea, const Rect & screenArea)
+{
+	queuedQuads.emplace_back(atlasArea, screenArea);
+}
+
+void TextureAtlas::render()
+{
+	if(queuedQuads.empty())
+		return;
+
+	SDL_Rect sdlClipRect = CSDL_Ext::toSDL(clipRect);
+	SDL_RenderSetClipRect(mainRenderer, &sdlClipRect);
+
+	// SDL groups consecutive copies from same texture into a single draw call
+	for(const auto & [atlasArea, screenArea] : queuedQuads)
+	{
+		SDL_Rect sourceRect = CSDL_Ext::toSDL(atlasArea);
+		SDL_Rect targetRect = CSDL_Ext::toSDL(screenArea);
+		SDL_RenderCopy(mainRenderer, texture, &sourceRect, &targetRect);
+	}
+
+	SDL_RenderSetClipRect(mainRenderer, nullptr);
+}
@@ -0,0 +1,46 @@
+/*
+ * TextureAtlas.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../../lib/Rect.h"
+
+struct SDL_Texture;
+struct SDL_Surface;
+struct SDL_Rect;
+
+/// Texture in video memory that holds many small images packed together, e.g. rendered map tiles
+/// Parts of atlas are drawn as a batch of textured quads underneath screen surface and are visible through its transparent areas
+class TextureAtlas : boost::noncopyable
+{
+	SDL_Texture * texture;
+	Point dimensions;
+
+	Rect clipRect;
+	std::vector<std::pair<Rect, Rect>> queuedQuads;
+
+public:
+	/// Creates atlas of specified size in pixels. Check isValid() to see whether creation was successful
+	explicit TextureAtlas(const Point & dimensions);
+	~TextureAtlas();
+
+	bool isValid() const;
+
+	/// Copies specified area of source surface into same area of atlas
+	void upload(SDL_Surface * source, const Rect & area);
+
+	/// Removes all quads queued for rendering and sets area of screen to which following quads will be clipped
+	void resetQueue(const Rect & screenClipRect);
+
+	/// Queues rendering of specified area of atlas at specified area of screen. Both areas are in pixels
+	void queueQuad(const Rect & atlasArea, const Rect & screenArea);
+
+	/// Renders all queued quads. Queue is kept, so atlas is rendered on every frame until queue is reset
+	void render();
+};
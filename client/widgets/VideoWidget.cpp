@@ -40,6 +40,18 @@ void VideoWidgetBase::playVideo(const VideoPath & fileToPlay)
 {
 	OBJECT_CONSTRUCTION;
 
+	// restart of the same video, e.g. looped video in town screen - reuse already opened video and loaded audio
+	auto previousVideo = std::move(finishedVideoInstance);
+	if(previousVideo && fileToPlay == currentVideo && previousVideo->seek(0))
+	{
+		videoInstance = std::move(previousVideo);
+		if (isActive())
+			startAudio();
+		return;
+	}
+	previousVideo.reset();
+	currentVideo = fileToPlay;
+
 	JsonPath subTitlePath = fileToPlay.toType<EResType::JSON>();
 	JsonPath subTitlePathVideoDir = subTitlePath.addPrefix("VIDEO/");
 	if(CResourceHandler::get()->existsResource(subTitlePath))
@@ -76,11 +88,7 @@ void VideoWidgetBase::playVideo(const VideoPath & fileToPlay)
 	}
 
 	if (playAudio)
-	{
 		loadAudio(fileToPlay);
-		if (isActive())
-			startAudio();
-	}
 }
 
 void VideoWidgetBase::show(Canvas & to)
@@ -96,7 +104,31 @@ void VideoWidgetBase::loadAudio(const VideoPath & fileToPlay)
 	if (!playAudio)
 		return;
 
-	audioData = CCS->videoh->getAudio(fileToPlay);
+	// audio may need to be decoded from video file, which may take noticeable time
+	audioData = {nullptr, 0};
+	pendingAudio = std::make_shared<PendingAudio>();
+
+	// if widget is destroyed before audio is loaded, loaded audio is simply discarded
+	CCS->videoh->getAudioAsync(fileToPlay, [state = pendingAudio](AudioData data)
+	{
+		state->data = std::move(data);
+		state->ready = true;
+	});
+}
+
+bool VideoWidgetBase::updatePendingAudio()
+{
+	if(!pendingAudio)
+		return true;
+
+	if(!pendingAudio->ready)
+		return false;
+
+	audioData = std::move(pendingAudio->data);
+	pendingAudio.reset();
+	if(isActive())
+		startAudio();
+	return true;
 }
 
 void VideoWidgetBase::startAudio()
@@ -169,6 +201,10 @@ void VideoWidgetBase::showAll(Canvas & to)
 
 void VideoWidgetBase::tick(uint32_t msPassed)
 {
+	// keep video on its first frame until its audio is ready
+	if(!updatePendingAudio())
+		return;
+
 	if(videoInstance)
 	{
 		videoInstance->tick(msPassed);
@@ -178,7 +214,10 @@ void VideoWidgetBase::tick(uint32_t msPassed)
 
 		if(videoInstance->videoEnded())
 		{
-			videoInstance.reset();
+			if(isLooped())
+				finishedVideoInstance = std::move(videoInstance);
+			else
+				videoInstance.reset();
 			stopAudio();
 			onPlaybackFinished();
 			// WARNING: onPlaybackFinished call may destoy `this`. Make sure that this is the very last operation in this method!
@@ -203,6 +242,11 @@ void VideoWidget::onPlaybackFinished()
 	playVideo(loopedVideo);
 }
 
+bool VideoWidget::isLooped() const
+{
+	return true;
+}
+
 VideoWidgetOnce::VideoWidgetOnce(const Point & position, const VideoPath & video, bool playAudio, IVideoHolder * owner)
 	: VideoWidgetBase(position, video, playAudio)
 	, owner(owner)
@@ -219,3 +263,8 @@ void VideoWidgetOnce::onPlaybackFinished()
 {
 	owner->onVideoPlaybackFinished();
 }
+
+bool VideoWidgetOnce::isLooped() const
+{
+	return false;
+}
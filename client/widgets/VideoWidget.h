@@ -21,15 +21,31 @@ class CMultiLineLabel;
 class VideoWidgetBase : public CIntObject
 {
 	std::unique_ptr<IVideoInstance> videoInstance;
+	/// Video that has just finished playing, kept so it can be restarted without reopening
+	std::unique_ptr<IVideoInstance> finishedVideoInstance;
+	VideoPath currentVideo;
 	std::unique_ptr<CMultiLineLabel> subTitle;
 
-	std::pair<std::unique_ptr<ui8[]>, si64> audioData = {nullptr, 0};
+	using AudioData = std::pair<std::unique_ptr<ui8[]>, si64>;
+
+	/// Audio that is being extracted from video in background. Video playback waits for it to keep audio in sync
+	/// Shared with loading thread, so widget can be destroyed without waiting for loading to finish
+	struct PendingAudio
+	{
+		std::atomic<bool> ready = false;
+		AudioData data = {nullptr, 0};
+	};
+
+	AudioData audioData = {nullptr, 0};
+	std::shared_ptr<PendingAudio> pendingAudio;
 	int audioHandle = -1;
 	bool playAudio = false;
 	float scaleFactor = 1.0;
 	JsonNode subTitleData;
 
 	void loadAudio(const VideoPath & file);
+	/// Returns true if audio is not being loaded at the moment
+	bool updatePendingAudio();
 	void startAudio();
 	void stopAudio();
 	std::string getSubTitleLine(double timestamp);
@@ -39,6 +55,8 @@ protected:
 	VideoWidgetBase(const Point & position, const VideoPath & video, bool playAudio, float scaleFactor);
 
 	virtual void onPlaybackFinished() = 0;
+	/// Returns true if video will be played again once finished, in which case opened video is kept for reuse
+	virtual bool isLooped() const = 0;
 	void playVideo(const VideoPath & video);
 
 public:
@@ -58,6 +76,7 @@ class VideoWidget final: public VideoWidgetBase
 	VideoPath loopedVideo;
 
 	void onPlaybackFinished() final;
+	bool isLooped() const final;
 public:
 	VideoWidget(const Point & position, const VideoPath & prologue, const VideoPath & looped, bool playAudio);
 	VideoWidget(const Point & position, const VideoPath & looped, bool playAudio);
@@ -68,6 +87,7 @@ class VideoWidgetOnce final: public VideoWidgetBase
 	IVideoHolder * owner;
 
 	void onPlaybackFinished() final;
+	bool isLooped() const final;
 public:
 	VideoWidgetOnce(const Point & position, const VideoPath & video, bool playAudio, IVideoHolder * owner);
 	VideoWidgetOnce(const Point & position, const VideoPath & video, bool playAudio, float scaleFactor, IVideoHolder * owner);
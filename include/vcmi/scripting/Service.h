@@ -25,6 +25,9 @@ namespace scripting
 using BattleCb = Environment::BattleCb;
 using GameCb = Environment::GameCb;
 
+/// Targets of scripted spell effect as pairs of hex and id of unit on it, or -1 if there is no unit
+using EffectTargets = std::vector<std::pair<int32_t, int32_t>>;
+
 class DLL_LINKAGE Context
 {
 public:
@@ -36,6 +39,12 @@ public:
 	virtual JsonNode callGlobal(const std::string & name, const JsonNode & parameters) = 0;
 	virtual JsonNode callGlobal(ServerCallback * server, const std::string & name, const JsonNode & parameters) = 0;
 
+	/// Typed calls push parameters directly onto script stack instead of converting them through JsonNode
+	/// Return result of function, or std::nullopt if call failed or function returned something other than boolean
+	virtual std::optional<bool> callGlobalPredicate(const std::string & name) = 0;
+	virtual std::optional<bool> callGlobalPredicate(const std::string & name, const EffectTargets & targets) = 0;
+	virtual void callGlobal(ServerCallback * server, const std::string & name, const EffectTargets & targets) = 0;
+
 	virtual void setGlobal(const std::string & name, int value) = 0;
 	virtual void setGlobal(const std::string & name, const std::string & value) = 0;
 	virtual void setGlobal(const std::string & name, double value) = 0;
@@ -14,6 +14,7 @@
 
 #include "bonuses/Bonus.h"
 #include "bonuses/CBonusSystemNode.h"
+#include "gameState/FogOfWarMap.h"
 #include "ResourceSet.h"
 #include "TurnTimerInfo.h"
 
@@ -162,8 +163,7 @@ struct DLL_LINKAGE TeamState : public CBonusSystemNode
 public:
 	TeamID id; //position in gameState::teams
 	std::set<PlayerColor> players; // members of this team
-	//TODO: boost::array, bool if possible
-	boost::multi_array<ui8, 3> fogOfWarMap; //[z][x][y] true - visible, false - hidden
+	FogOfWarMap fogOfWarMap;
 
 	std::set<ObjectInstanceID> scoutedObjects;
 
@@ -185,7 +185,16 @@ public:
 			h & ptrHelper;
 		}
 
-		h & fogOfWarMap;
+		if (h.version >= Handler::Version::BIT_PACKED_FOG_OF_WAR)
+		{
+			h & fogOfWarMap;
+		}
+		else
+		{
+			boost::multi_array<ui8, 3> legacyFogOfWarMap; //[z][x][y] true - visible, false - hidden
+			h & legacyFogOfWarMap;
+			fogOfWarMap.loadLegacyFormat(legacyFogOfWarMap);
+		}
 		h & static_cast<CBonusSystemNode&>(*this);
 
 		if (h.version >= Handler::Version::REWARDABLE_BANKS)
@@ -38,6 +38,7 @@
 #include "gameState/CGameState.h"
 #include "gameState/CGameStateCampaign.h"
 #include "gameState/TavernHeroesPool.h"
+#include "gameState/TileSpanSet.h"
 #include "gameState/QuestInfo.h"
 #include "mapping/CMap.h"
 #include "modding/CModHandler.h"
@@ -84,34 +85,64 @@ void CPrivilegedInfoCallback::getTilesInRange(std::unordered_set<int3> & tiles,
 											  ETileVisibility mode,
 											  std::optional<PlayerColor> player,
 											  int3::EDistanceFormula distanceFormula) const
+{
+	TileSpanSet spans;
+	getTilesInRange(spans, pos, radious, mode, player, distanceFormula);
+	spans.forEachTile([&tiles](const int3 & tile)
+	{
+		tiles.insert(tile);
+	});
+}
+
+void CPrivilegedInfoCallback::getTilesInRange(TileSpanSet & tiles,
+											  const int3 & pos,
+											  int radious,
+											  ETileVisibility mode,
+											  std::optional<PlayerColor> player,
+											  int3::EDistanceFormula distanceFormula) const
 {
 	if(!!player && !player->isValidPlayer())
 	{
 		logGlobal->error("Illegal call to getTilesInRange!");
 		return;
 	}
+
+	const TeamState * team = !player ? nullptr : gs->getPlayerTeam(*player);
+
+	auto addSpan = [&](const int3 & start, int length)
+	{
+		if(team)
+			team->fogOfWarMap.selectTiles(tiles, start, length, mode == ETileVisibility::REVEALED);
+		else
+			tiles.insert(start, length);
+	};
+
 	if(radious == CBuilding::HEIGHT_SKYSHIP) //reveal entire map
-		getAllTiles (tiles, player, -1, [](auto * tile){return true;});
-	else
 	{
-		const TeamState * team = !player ? nullptr : gs->getPlayerTeam(*player);
-		for (int xd = std::max<int>(pos.x - radious , 0); xd <= std::min<int>(pos.x + radious, gs->map->width - 1); xd++)
-		{
-			for (int yd = std::max<int>(pos.y - radious, 0); yd <= std::min<int>(pos.y + radious, gs->map->height - 1); yd++)
-			{
-				int3 tilePos(xd,yd,pos.z);
-				int distance = pos.dist(tilePos, distanceFormula);
-
-				if(distance <= radious)
-				{
-					if(!player
-						|| (mode == ETileVisibility::HIDDEN  && team->fogOfWarMap[pos.z][xd][yd] == 0)
-						|| (mode == ETileVisibility::REVEALED && team->fogOfWarMap[pos.z][xd][yd] == 1)
-					)
-						tiles.insert(int3(xd,yd,pos.z));
-				}
-			}
-		}
+		for(int zd = 0; zd < gs->map->levels(); zd++)
+			for(int yd = 0; yd < gs->map->height; yd++)
+				addSpan(int3(0, yd, zd), gs->map->width);
+		return;
+	}
+
+	// distance grows with horizontal offset, so every row of the area is a single span of tiles
+	std::vector<int> halfWidths;
+	int halfWidth = radious;
+	for(int dy = 0; dy <= radious; dy++)
+	{
+		while(halfWidth >= 0 && static_cast<int>(pos.dist(pos + int3(halfWidth, dy, 0), distanceFormula)) > radious)
+			halfWidth--;
+		halfWidths.push_back(halfWidth);
+	}
+
+	for (int yd = std::max<int>(pos.y - radious, 0); yd <= std::min<int>(pos.y + radious, gs->map->height - 1); yd++)
+	{
+		int rowHalfWidth = halfWidths[std::abs(yd - pos.y)];
+		int xFirst = std::max<int>(pos.x - rowHalfWidth, 0);
+		int xLast = std::min<int>(pos.x + rowHalfWidth, gs->map->width - 1);
+
+		if(rowHalfWidth >= 0 && xFirst <= xLast)
+			addSpan(int3(xFirst, yd, pos.z), xLast - xFirst + 1);
 	}
 }
 
@@ -148,6 +179,32 @@ void CPrivilegedInfoCallback::getAllTiles(std::unordered_set<int3> & tiles, std:
 	}
 }
 
+void CPrivilegedInfoCallback::getAllTiles(TileSpanSet & tiles, std::optional<PlayerColor> Player, int level, std::function<bool(const TerrainTile *)> filter) const
+{
+	if(!!Player && !Player->isValidPlayer())
+	{
+		logGlobal->error("Illegal call to getAllTiles !");
+		return;
+	}
+
+	int firstLevel = level == -1 ? 0 : level;
+	int lastLevel = level == -1 ? gs->map->levels() - 1 : level;
+
+	// iterate in row-major order, so tiles are appended to the end of span set
+	for(int zd = firstLevel; zd <= lastLevel; zd++)
+	{
+		for(int yd = 0; yd < gs->map->height; yd++)
+		{
+			for(int xd = 0; xd < gs->map->width; xd++)
+			{
+				int3 coordinates(xd, yd, zd);
+				if (filter(getTile(coordinates)))
+					tiles.insert(coordinates);
+			}
+		}
+	}
+}
+
 void CPrivilegedInfoCallback::pickAllowedArtsSet(std::vector<ArtifactID> & out, vstd::RNG & rand)
 {
 	for (int j = 0; j < 3 ; j++)
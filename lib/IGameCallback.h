@@ -35,6 +35,7 @@ class CGCreature;
 class CSaveFile;
 class CLoadFile;
 class IObjectInterface;
+class TileSpanSet;
 enum class EOpenWindowMode : uint8_t;
 
 namespace spells
@@ -71,8 +72,16 @@ public:
 						 std::optional<PlayerColor> player = std::optional<PlayerColor>(),
 						 int3::EDistanceFormula formula = int3::DIST_2D) const;
 
+	void getTilesInRange(TileSpanSet & tiles,
+						 const int3 & pos,
+						 int radius,
+						 ETileVisibility mode,
+						 std::optional<PlayerColor> player = std::optional<PlayerColor>(),
+						 int3::EDistanceFormula formula = int3::DIST_2D) const;
+
 	//returns all tiles on given level (-1 - both levels, otherwise number of level)
 	void getAllTiles(std::unordered_set<int3> &tiles, std::optional<PlayerColor> player, int level, std::function<bool(const TerrainTile *)> filter) const;
+	void getAllTiles(TileSpanSet &tiles, std::optional<PlayerColor> player, int level, std::function<bool(const TerrainTile *)> filter) const;
 
 	//gives 3 treasures, 3 minors, 1 major -> used by Black Market and Artifact Merchant
 	void pickAllowedArtsSet(std::vector<ArtifactID> & out, vstd::RNG & rand);
@@ -143,7 +152,7 @@ public:
 	virtual void sendAndApply(CPackForClient & pack) = 0;
 	virtual void heroExchange(ObjectInstanceID hero1, ObjectInstanceID hero2)=0; //when two heroes meet on adventure map
 	virtual void changeFogOfWar(int3 center, ui32 radius, PlayerColor player, ETileVisibility mode) = 0;
-	virtual void changeFogOfWar(const std::unordered_set<int3> &tiles, PlayerColor player, ETileVisibility mode) = 0;
+	virtual void changeFogOfWar(const TileSpanSet &tiles, PlayerColor player, ETileVisibility mode) = 0;
 	
 	virtual void castSpell(const spells::Caster * caster, SpellID spellID, const int3 &pos) = 0;
 
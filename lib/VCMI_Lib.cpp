@@ -197,6 +197,8 @@ void LibClasses::init(bool onlyEssential)
 
 	modh->load();
 	modh->afterLoad(onlyEssential);
+
+	generaltexth->createTranslationSnapshot();
 }
 
 #if SCRIPTING_ENABLED
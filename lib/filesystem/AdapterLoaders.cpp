@@ -62,14 +62,85 @@ CFilesystemList::CFilesystemList()
 
 CFilesystemList::~CFilesystemList()
 {
+	for(const auto & loader : loaders)
+	{
+		const auto * list = dynamic_cast<const CFilesystemList *>(loader.get());
+		if(list)
+			vstd::erase(list->parentLists, this);
+	}
+}
+
+const ISimpleResourceLoader * CFilesystemList::findLoader(const ResourcePath & resourceName) const
+{
+	{
+		std::shared_lock lock(resourceIndexMutex);
+		if(resourceIndexValid)
+		{
+			auto it = resourceIndex.find(resourceName);
+			return it == resourceIndex.end() ? nullptr : it->second;
+		}
+	}
+
+	std::unique_lock lock(resourceIndexMutex);
+	if(!resourceIndexValid)
+		buildIndex();
+
+	auto it = resourceIndex.find(resourceName);
+	return it == resourceIndex.end() ? nullptr : it->second;
+}
+
+void CFilesystemList::buildIndex() const
+{
+	resourceIndex.clear();
+
+	// later loaders override resources from earlier ones
+	for(const auto & loader : loaders)
+		for(const auto & entry : loader->getFilteredFiles([](const ResourcePath &){ return true; }))
+			resourceIndex[entry] = loader.get();
+
+	resourceIndexValid = true;
+}
+
+void CFilesystemList::invalidateIndex() const
+{
+	{
+		std::unique_lock lock(resourceIndexMutex);
+		resourceIndexValid = false;
+		resourceIndex.clear();
+	}
+
+	for(const auto * parent : parentLists)
+		parent->invalidateIndex();
+}
+
+void CFilesystemList::onResourceAdded(const ResourcePath & resourceName, const ISimpleResourceLoader * loader) const
+{
+	{
+		std::unique_lock lock(resourceIndexMutex);
+		if(resourceIndexValid)
+		{
+			auto position = [this](const ISimpleResourceLoader * entry)
+			{
+				return boost::range::find_if(loaders, [entry](const auto & ptr){ return ptr.get() == entry; }) - loaders.begin();
+			};
+
+			// keep current owner if it overrides loader that received new resource
+			auto it = resourceIndex.find(resourceName);
+			if(it == resourceIndex.end() || position(it->second) <= position(loader))
+				resourceIndex[resourceName] = loader;
+		}
+	}
+
+	for(const auto * parent : parentLists)
+		parent->onResourceAdded(resourceName, this);
 }
 
 std::unique_ptr<CInputStream> CFilesystemList::load(const ResourcePath & resourceName) const
 {
 	// load resource from last loader that have it (last overridden version)
-	for(const auto & loader : boost::adaptors::reverse(loaders))
-		if (loader->existsResource(resourceName))
-			return loader->load(resourceName);
+	const auto * loader = findLoader(resourceName);
+	if(loader)
+		return loader->load(resourceName);
 
 	throw std::runtime_error("Resource with name " + resourceName.getName() + " and type "
 		+ EResTypeHelper::getEResTypeAsString(resourceName.getType()) + " wasn't found.");
@@ -77,10 +148,7 @@ std::unique_ptr<CInputStream> CFilesystemList::load(const ResourcePath & resourc
 
 bool CFilesystemList::existsResource(const ResourcePath & resourceName) const
 {
-	for(const auto & loader : loaders)
-		if (loader->existsResource(resourceName))
-			return true;
-	return false;
+	return findLoader(resourceName) != nullptr;
 }
 
 std::string CFilesystemList::getMountPoint() const
@@ -90,8 +158,9 @@ std::string CFilesystemList::getMountPoint() const
 
 std::optional<boost::filesystem::path> CFilesystemList::getResourceName(const ResourcePath & resourceName) const
 {
-	if (existsResource(resourceName))
-		return getResourcesWithName(resourceName).back()->getResourceName(resourceName);
+	const auto * loader = findLoader(resourceName);
+	if(loader)
+		return loader->getResourceName(resourceName);
 	return std::optional<boost::filesystem::path>();
 }
 
@@ -113,12 +182,25 @@ void CFilesystemList::updateFilteredFiles(std::function<bool(const std::string &
 {
 	for(const auto & loader : loaders)
 		loader->updateFilteredFiles(filter);
+
+	invalidateIndex();
 }
 
 std::unordered_set<ResourcePath> CFilesystemList::getFilteredFiles(std::function<bool(const ResourcePath &)> filter) const
 {
 	std::unordered_set<ResourcePath> ret;
 
+	{
+		std::shared_lock lock(resourceIndexMutex);
+		if(resourceIndexValid)
+		{
+			for(const auto & entry : resourceIndex)
+				if(filter(entry.first))
+					ret.insert(entry.first);
+			return ret;
+		}
+	}
+
 	for(const auto & loader : loaders)
 		for(const auto & entry : loader->getFilteredFiles(filter))
 			ret.insert(entry);
@@ -137,7 +219,10 @@ bool CFilesystemList::createResource(const std::string & filename, bool update)
 			// Check if resource was created successfully. Possible reasons for this to fail
 			// a) loader failed to create resource (e.g. read-only FS)
 			// b) in update mode, call with filename that does not exists
-			assert(load(ResourcePath(filename)));
+			// Loader is queried directly since index of this list is only updated below
+			assert(loader->load(ResourcePath(filename)));
+
+			onResourceAdded(ResourcePath(filename), loader.get());
 
 			logGlobal->trace("Resource created successfully");
 			return true;
@@ -162,6 +247,14 @@ void CFilesystemList::addLoader(ISimpleResourceLoader * loader, bool writeable)
 	loaders.push_back(std::unique_ptr<ISimpleResourceLoader>(loader));
 	if (writeable)
 		writeableLoaders.insert(loader);
+
+	auto * list = dynamic_cast<CFilesystemList *>(loader);
+	if(list)
+		list->parentLists.push_back(this);
+
+	// new loader overrides all existing ones, so index can be updated in place
+	for(const auto & entry : loader->getFilteredFiles([](const ResourcePath &){ return true; }))
+		onResourceAdded(entry, loader);
 }
 
 bool CFilesystemList::removeLoader(ISimpleResourceLoader * loader)
@@ -170,8 +263,13 @@ bool CFilesystemList::removeLoader(ISimpleResourceLoader * loader)
 	{
 		if(loaderIterator->get() == loader)
 		{
+			auto * list = dynamic_cast<CFilesystemList *>(loader);
+			if(list)
+				vstd::erase(list->parentLists, this);
+
 			loaders.erase(loaderIterator);
 			writeableLoaders.erase(loader);
+			invalidateIndex();
 			return true;
 		}
 	}
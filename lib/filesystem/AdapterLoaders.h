@@ -59,6 +59,23 @@ class DLL_LINKAGE CFilesystemList : public ISimpleResourceLoader
 
 	std::set<ISimpleResourceLoader *> writeableLoaders;
 
+	/// Lists that contain this list as one of their loaders and need to be notified about changes
+	mutable std::vector<const CFilesystemList *> parentLists;
+
+	/// Lookup table from resource to last (overriding) loader that contains it
+	/// Built lazily on first request since mods add large amounts of loaders one by one during startup
+	mutable std::unordered_map<ResourcePath, const ISimpleResourceLoader *> resourceIndex;
+	mutable bool resourceIndexValid = false;
+	mutable std::shared_mutex resourceIndexMutex;
+
+	/// Returns loader that provides resource or nullptr if resource does not exists
+	const ISimpleResourceLoader * findLoader(const ResourcePath & resourceName) const;
+	void buildIndex() const;
+	/// Drops index of this list and of all lists that contain it
+	void invalidateIndex() const;
+	/// Updates index of this list and of all lists that contain it after new resource was added to one of loaders
+	void onResourceAdded(const ResourcePath & resourceName, const ISimpleResourceLoader * loader) const;
+
 	//FIXME: this is only compile fix, should be removed in the end
 	CFilesystemList(CFilesystemList &) = delete;
 	CFilesystemList &operator=(CFilesystemList &) = delete;
@@ -13,6 +13,8 @@
 #include "VCMIDirs.h"
 #include "CFileInputStream.h"
 #include "CCompressedStream.h"
+#include "CMappedFile.h"
+#include "CMemoryViewStream.h"
 
 #include "CBinaryReader.h"
 
@@ -50,6 +52,16 @@ CArchiveLoader::CArchiveLoader(std::string _mountPoint, boost::filesystem::path
 		throw std::runtime_error("LOD archive format unknown. Cannot deal with " + archive.string());
 
 	logGlobal->trace("%sArchive \"%s\" loaded (%d files found).", ext, archive.filename(), entries.size());
+
+	try
+	{
+		mappedArchive = std::make_shared<CMappedFile>(archive);
+	}
+	catch(const std::runtime_error & e)
+	{
+		// e.g. not enough address space on 32-bit systems. Entries will be read from file instead
+		logGlobal->warn("%s", e.what());
+	}
 }
 
 void CArchiveLoader::initLODArchive(const std::string &mountPoint, CFileInputStream & fileStream)
@@ -177,14 +189,64 @@ std::unique_ptr<CInputStream> CArchiveLoader::load(const ResourcePath & resource
 
 	if (entry.compressedSize != 0) //compressed data
 	{
-		auto fileStream = std::make_unique<CFileInputStream>(archive, entry.offset, entry.compressedSize);
-
-		return std::make_unique<CCompressedStream>(std::move(fileStream), false, entry.fullSize);
+		auto data = loadDecompressed(resourceName, entry);
+		return std::make_unique<CMemoryViewStream>(data, data->data(), data->size());
 	}
 	else
 	{
-		return std::make_unique<CFileInputStream>(archive, entry.offset, entry.fullSize);
+		return loadRaw(entry, entry.fullSize);
+	}
+}
+
+std::unique_ptr<CInputStream> CArchiveLoader::loadRaw(const ArchiveEntry & entry, int size) const
+{
+	if (mappedArchive && entry.offset >= 0 && size >= 0 && static_cast<si64>(entry.offset) + size <= mappedArchive->size())
+		return std::make_unique<CMemoryViewStream>(mappedArchive, mappedArchive->data() + entry.offset, size);
+
+	return std::make_unique<CFileInputStream>(archive, entry.offset, size);
+}
+
+std::shared_ptr<const std::vector<ui8>> CArchiveLoader::loadDecompressed(const ResourcePath & resourceName, const ArchiveEntry & entry) const
+{
+	{
+		std::lock_guard lock(decompressedCacheMutex);
+
+		auto it = decompressedCacheIndex.find(resourceName);
+		if (it != decompressedCacheIndex.end())
+		{
+			decompressedCache.splice(decompressedCache.begin(), decompressedCache, it->second);
+			return it->second->second;
+		}
+	}
+
+	// decompression is done without lock, so other threads can still use the cache
+	CCompressedStream stream(loadRaw(entry, entry.compressedSize), false, entry.fullSize);
+
+	auto data = std::make_shared<std::vector<ui8>>(entry.fullSize);
+	data->resize(stream.read(data->data(), entry.fullSize));
+
+	// entries that would take significant part of the cache are not worth keeping
+	if (data->size() > decompressedCacheLimit / 4)
+		return data;
+
+	std::lock_guard lock(decompressedCacheMutex);
+
+	// entry might have been loaded by another thread in meanwhile
+	if (decompressedCacheIndex.count(resourceName))
+		return data;
+
+	decompressedCache.emplace_front(resourceName, data);
+	decompressedCacheIndex[resourceName] = decompressedCache.begin();
+	decompressedCacheSize += data->size();
+
+	while (decompressedCacheSize > decompressedCacheLimit)
+	{
+		decompressedCacheSize -= decompressedCache.back().second->size();
+		decompressedCacheIndex.erase(decompressedCache.back().first);
+		decompressedCache.pop_back();
 	}
+
+	return data;
 }
 
 bool CArchiveLoader::existsResource(const ResourcePath & resourceName) const
@@ -15,6 +15,7 @@
 VCMI_LIB_NAMESPACE_BEGIN
 
 class CFileInputStream;
+class CMappedFile;
 
 /**
  * A struct which holds information about the archive entry e.g. where it is located in space of the archive container.
@@ -103,6 +104,25 @@ private:
 
 	/** Specifies if Original H3 archives should be extracted to a separate folder **/
 	bool extractArchives;
+
+	/** Whole archive mapped into memory, or null if archive could not be mapped **/
+	std::shared_ptr<const CMappedFile> mappedArchive;
+
+	/** Max total size of decompressed entries that are kept in memory **/
+	static constexpr size_t decompressedCacheLimit = 32 * 1024 * 1024;
+
+	/** Recently loaded decompressed entries, most recently used first **/
+	using DecompressedEntry = std::pair<ResourcePath, std::shared_ptr<const std::vector<ui8>>>;
+	mutable std::list<DecompressedEntry> decompressedCache;
+	mutable std::unordered_map<ResourcePath, std::list<DecompressedEntry>::iterator> decompressedCacheIndex;
+	mutable size_t decompressedCacheSize = 0;
+	mutable std::mutex decompressedCacheMutex;
+
+	/** Returns stream with raw, possibly compressed data of the entry **/
+	std::unique_ptr<CInputStream> loadRaw(const ArchiveEntry & entry, int size) const;
+
+	/** Returns decompressed data of the entry, from cache if possible **/
+	std::shared_ptr<const std::vector<ui8>> loadDecompressed(const ResourcePath & resourceName, const ArchiveEntry & entry) const;
 };
 
 /** Constructs the file path for the extracted file. Creates the subfolder hierarchy aswell **/
@@ -11,15 +11,18 @@
 #include "CFilesystemLoader.h"
 
 #include "CFileInputStream.h"
+#include "CMappedFile.h"
+#include "CMemoryViewStream.h"
 
 #include "../ExceptionsCommon.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
-CFilesystemLoader::CFilesystemLoader(std::string _mountPoint, boost::filesystem::path baseDirectory, size_t depth, bool initial):
+CFilesystemLoader::CFilesystemLoader(std::string _mountPoint, boost::filesystem::path baseDirectory, size_t depth, bool initial, bool mapLargeFiles):
 	baseDirectory(std::move(baseDirectory)),
 	mountPoint(std::move(_mountPoint)),
-	recursiveDepth(depth)
+	recursiveDepth(depth),
+	mapLargeFiles(mapLargeFiles)
 {
 	try {
 		fileList = listFiles(mountPoint, depth, initial);
@@ -36,6 +39,24 @@ std::unique_ptr<CInputStream> CFilesystemLoader::load(const ResourcePath & resou
 	assert(fileList.count(resourceName));
 	boost::filesystem::path file = baseDirectory / fileList.at(resourceName);
 	logGlobal->trace("loading %s", file.string());
+
+	// large game data files are mapped to avoid copying them through file stream buffers
+	boost::system::error_code ec;
+	auto fileSize = mapLargeFiles ? boost::filesystem::file_size(file, ec) : 0;
+
+	if (!ec && fileSize >= minMappedFileSize)
+	{
+		try
+		{
+			auto mappedFile = std::make_shared<CMappedFile>(file);
+			return std::make_unique<CMemoryViewStream>(mappedFile, mappedFile->data(), mappedFile->size());
+		}
+		catch(const std::runtime_error & e)
+		{
+			logGlobal->warn("%s", e.what());
+		}
+	}
+
 	return std::make_unique<CFileInputStream>(file);
 }
 
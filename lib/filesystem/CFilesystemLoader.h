@@ -27,10 +27,11 @@ public:
 	 *
 	 * @param baseDirectory Specifies the base directory and their sub-directories which should be indexed.
 	 * @param depth - recursion depth of subdirectories search. 0 = no recursion
+	 * @param mapLargeFiles - map large files into memory. Should only be used for read-only game data
 	 *
 	 * @throws std::runtime_error if the base directory is not a directory or if it is not available
 	 */
-	explicit CFilesystemLoader(std::string mountPoint, boost::filesystem::path baseDirectory, size_t depth = 16, bool initial = false);
+	explicit CFilesystemLoader(std::string mountPoint, boost::filesystem::path baseDirectory, size_t depth = 16, bool initial = false, bool mapLargeFiles = false);
 
 	/// Interface implementation
 	/// @see ISimpleResourceLoader
@@ -50,6 +51,12 @@ private:
 	
 	size_t recursiveDepth;
 
+	/** True if files of this directory are never modified while game is running and can be mapped into memory **/
+	bool mapLargeFiles;
+
+	/** Files of this size or larger are mapped into memory instead of being read through file stream **/
+	static constexpr uintmax_t minMappedFileSize = 64 * 1024;
+
 	/** A list of files in the directory
 	 * key = ResourcePath for resource loader
 	 * value = name that can be used to access file
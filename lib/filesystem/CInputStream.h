@@ -44,6 +44,17 @@ public:
 		return std::make_pair(std::move(data), getSize());
 	}
 
+	/**
+	 * @brief for convenience, reads whole stream at once. Streams that already hold their data in memory provide it without copying
+	 *
+	 * @return pair, first = read-only data that remains valid as long as pointer exists, second = size of data
+	 */
+	virtual std::pair<std::shared_ptr<const ui8>, si64> readAllShared()
+	{
+		auto data = readAll();
+		return std::make_pair(std::shared_ptr<const ui8>(data.first.release(), std::default_delete<ui8[]>()), data.second);
+	}
+
 	/**
 	 * @brief calculateCRC32 calculates CRC32 checksum for the whole file
 	 * @return calculated checksum
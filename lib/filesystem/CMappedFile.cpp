@@ -0,0 +1,52 @@
+/*
+ * CMappedFile.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "CMappedFile.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+CMappedFile::CMappedFile(const boost::filesystem::path & file)
+{
+	try
+	{
+		// regions of zero size can not be mapped
+		if (boost::filesystem::file_size(file) == 0)
+			return;
+
+		// mapping remains valid after file_mapping object is destroyed
+		boost::interprocess::file_mapping mapping(file.string().c_str(), boost::interprocess::read_only);
+		region = std::make_unique<boost::interprocess::mapped_region>(mapping, boost::interprocess::read_only);
+	}
+	catch (const std::exception & e)
+	{
+		throw std::runtime_error("Failed to map file " + file.string() + ": " + e.what());
+	}
+}
+
+CMappedFile::~CMappedFile() = default;
+
+const ui8 * CMappedFile::data() const
+{
+	if (!region)
+		return nullptr;
+	return static_cast<const ui8 *>(region->get_address());
+}
+
+si64 CMappedFile::size() const
+{
+	if (!region)
+		return 0;
+	return region->get_size();
+}
+
+VCMI_LIB_NAMESPACE_END
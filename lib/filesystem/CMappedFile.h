@@ -0,0 +1,45 @@
+/*
+ * CMappedFile.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+namespace boost::interprocess
+{
+class mapped_region;
+}
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/**
+ * A class which maps whole file into memory for reading.
+ * Mapped memory remains valid as long as this object exists, regardless of state of the file on disk.
+ */
+class DLL_LINKAGE CMappedFile : boost::noncopyable
+{
+	std::unique_ptr<boost::interprocess::mapped_region> region;
+
+public:
+	/**
+	 * C-tor. Maps the specified file.
+	 *
+	 * @param file Path to the file.
+	 *
+	 * @throws std::runtime_error if file can not be opened or mapped
+	 */
+	explicit CMappedFile(const boost::filesystem::path & file);
+	~CMappedFile();
+
+	/// Returns pointer to content of the file. May be null if file is empty
+	const ui8 * data() const;
+
+	/// Returns size of the file in bytes
+	si64 size() const;
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,57 @@
+/*
+ * CMemoryViewStream.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "CMemoryViewStream.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+CMemoryViewStream::CMemoryViewStream(std::shared_ptr<const void> owner, const ui8 * data, si64 size) :
+	owner(std::move(owner)), data(data), size(size), position(0)
+{
+}
+
+si64 CMemoryViewStream::read(ui8 * data, si64 size)
+{
+	si64 toRead = std::max<si64>(0, std::min(this->size - position, size));
+	std::copy(this->data + position, this->data + position + toRead, data);
+	position += toRead;
+	return toRead;
+}
+
+si64 CMemoryViewStream::seek(si64 position)
+{
+	si64 origin = tell();
+	this->position = std::clamp<si64>(position, 0, size);
+	return tell() - origin;
+}
+
+si64 CMemoryViewStream::tell()
+{
+	return position;
+}
+
+si64 CMemoryViewStream::skip(si64 delta)
+{
+	si64 origin = tell();
+	position += std::clamp<si64>(delta, -origin, size - origin);
+	return tell() - origin;
+}
+
+si64 CMemoryViewStream::getSize()
+{
+	return size;
+}
+
+std::pair<std::shared_ptr<const ui8>, si64> CMemoryViewStream::readAllShared()
+{
+	return { std::shared_ptr<const ui8>(owner, data), size };
+}
+
+VCMI_LIB_NAMESPACE_END
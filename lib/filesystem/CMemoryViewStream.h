@@ -0,0 +1,54 @@
+/*
+ * CMemoryViewStream.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "CInputStream.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/**
+ * A class which provides stream access to read-only memory that is shared with other users, e.g. mapped file or cached resource.
+ * Unlike CMemoryStream, stream keeps its data alive and can provide it via readAllShared without copying.
+ */
+class DLL_LINKAGE CMemoryViewStream : public CInputStream
+{
+public:
+	/**
+	 * C-tor.
+	 *
+	 * @param owner object that owns the data, will be kept alive as long as stream or any data view from it exists.
+	 * @param data a pointer to the data array.
+	 * @param size The size in bytes of the array.
+	 */
+	CMemoryViewStream(std::shared_ptr<const void> owner, const ui8 * data, si64 size);
+
+	si64 read(ui8 * data, si64 size) override;
+	si64 seek(si64 position) override;
+	si64 tell() override;
+	si64 skip(si64 delta) override;
+	si64 getSize() override;
+
+	/// Returns view on data of this stream without copying it
+	std::pair<std::shared_ptr<const ui8>, si64> readAllShared() override;
+
+private:
+	std::shared_ptr<const void> owner;
+
+	/** A pointer to the data array. */
+	const ui8 * data;
+
+	/** The size in bytes of the array. */
+	si64 size;
+
+	/** Current reading position of the stream. */
+	si64 position;
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -83,13 +83,14 @@ void CFilesystemGenerator::loadDirectory(const std::string &mountPoint, const Js
 	int depth = 16;
 	if (!config["depth"].isNull())
 		depth = static_cast<int>(config["depth"].Float());
+	bool mapLargeFiles = config["mapped"].Bool();
 
 	ResourcePath resID(URI, EResType::DIRECTORY);
 
 	for(auto & loader : CResourceHandler::get("initial")->getResourcesWithName(resID))
 	{
 		auto filename = loader->getResourceName(resID);
-		filesystem->addLoader(new CFilesystemLoader(mountPoint, *filename, depth), false);
+		filesystem->addLoader(new CFilesystemLoader(mountPoint, *filename, depth, false, mapLargeFiles), false);
 	}
 }
 
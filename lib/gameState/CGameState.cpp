@@ -668,23 +668,18 @@ void CGameState::initFogOfWar()
 {
 	logGlobal->debug("\tFog of war"); //FIXME: should be initialized after all bonuses are set
 
-	int layers = map->levels();
 	for(auto & elem : teams)
 	{
 		auto & fow = elem.second.fogOfWarMap;
-		fow.resize(boost::extents[layers][map->width][map->height]);
-		std::fill(fow.data(), fow.data() + fow.num_elements(), 0);
+		fow.resize(int3(map->width, map->height, map->levels()));
 
 		for(CGObjectInstance *obj : map->objects)
 		{
 			if(!obj || !vstd::contains(elem.second.players, obj->tempOwner)) continue; //not a flagged object
 
-			std::unordered_set<int3> tiles;
+			TileSpanSet tiles;
 			getTilesInRange(tiles, obj->getSightCenter(), obj->getSightRadius(), ETileVisibility::HIDDEN, obj->tempOwner);
-			for(const int3 & tile : tiles)
-			{
-				elem.second.fogOfWarMap[tile.z][tile.x][tile.y] = 1;
-			}
+			fow.reveal(tiles);
 		}
 	}
 }
@@ -1223,7 +1218,7 @@ bool CGameState::isVisible(int3 pos, const std::optional<PlayerColor> & player)
 	if(player->isSpectator())
 		return true;
 
-	return getPlayerTeam(*player)->fogOfWarMap[pos.z][pos.x][pos.y];
+	return getPlayerTeam(*player)->fogOfWarMap.isVisible(pos);
 }
 
 bool CGameState::isVisible(const CGObjectInstance * obj, const std::optional<PlayerColor> & player) const
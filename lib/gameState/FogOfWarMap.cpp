@@ -0,0 +1,124 @@
+/*
+ * FogOfWarMap.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "FogOfWarMap.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+void FogOfWarMap::resize(const int3 & mapSize)
+{
+	sizes = mapSize;
+	wordsPerRow = (sizes.x + wordBits - 1) / wordBits;
+	words.assign(static_cast<size_t>(wordsPerRow) * sizes.y * sizes.z, 0);
+}
+
+void FogOfWarMap::setSpan(const int3 & start, si32 length, bool visible)
+{
+	const si32 first = std::max(start.x, 0);
+	const si32 last = std::min(start.x + length - 1, sizes.x - 1);
+
+	if(first > last)
+		return;
+
+	const size_t row = rowOffset(start.y, start.z);
+
+	for(si32 word = first / wordBits; word <= last / wordBits; ++word)
+	{
+		const si32 lowBit = (word == first / wordBits) ? first % wordBits : 0;
+		const si32 highBit = (word == last / wordBits) ? last % wordBits : wordBits - 1;
+		const Word mask = (~Word(0) >> (wordBits - 1 - highBit)) & (~Word(0) << lowBit);
+
+		if(visible)
+			words[row + word] |= mask;
+		else
+			words[row + word] &= ~mask;
+	}
+}
+
+si32 FogOfWarMap::findNext(size_t row, si32 x, si32 last, bool visible) const
+{
+	while(x <= last)
+	{
+		Word word = words[row + x / wordBits];
+		if(!visible)
+			word = ~word;
+		word >>= x % wordBits;
+
+		if(word == 0)
+		{
+			x = (x / wordBits + 1) * wordBits;
+			continue;
+		}
+
+		while((word & 1) == 0)
+		{
+			word >>= 1;
+			++x;
+		}
+		return std::min(x, last + 1);
+	}
+	return last + 1;
+}
+
+void FogOfWarMap::reveal(const int3 & tile)
+{
+	setSpan(tile, 1, true);
+}
+
+void FogOfWarMap::hide(const int3 & tile)
+{
+	setSpan(tile, 1, false);
+}
+
+void FogOfWarMap::reveal(const TileSpanSet & tiles)
+{
+	for(const auto & span : tiles.getSpans())
+		setSpan(span.start, span.length, true);
+}
+
+void FogOfWarMap::hide(const TileSpanSet & tiles)
+{
+	for(const auto & span : tiles.getSpans())
+		setSpan(span.start, span.length, false);
+}
+
+void FogOfWarMap::selectTiles(TileSpanSet & out, const int3 & start, si32 length, bool visible) const
+{
+	const si32 last = std::min(start.x + length - 1, sizes.x - 1);
+	const size_t row = rowOffset(start.y, start.z);
+
+	si32 x = std::max(start.x, 0);
+	while(x <= last)
+	{
+		si32 spanStart = findNext(row, x, last, visible);
+		if(spanStart > last)
+			break;
+
+		si32 spanEnd = findNext(row, spanStart, last, !visible);
+		out.insert(int3(spanStart, start.y, start.z), spanEnd - spanStart);
+		x = spanEnd;
+	}
+}
+
+void FogOfWarMap::loadLegacyFormat(const boost::multi_array<ui8, 3> & legacyMap)
+{
+	// legacy format is indexed as [z][x][y]
+	const auto * shape = legacyMap.shape();
+	resize(int3(shape[1], shape[2], shape[0]));
+
+	int3 tile;
+	for(tile.z = 0; tile.z < sizes.z; ++tile.z)
+		for(tile.x = 0; tile.x < sizes.x; ++tile.x)
+			for(tile.y = 0; tile.y < sizes.y; ++tile.y)
+				if(legacyMap[tile.z][tile.x][tile.y])
+					reveal(tile);
+}
+
+VCMI_LIB_NAMESPACE_END
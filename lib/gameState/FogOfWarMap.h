@@ -0,0 +1,73 @@
+/*
+ * FogOfWarMap.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "TileSpanSet.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Visibility of map tiles for a team, stored as one bit per tile
+/// Each map row is packed into 32-bit words, so operations on spans of tiles are applied to entire words at once
+class DLL_LINKAGE FogOfWarMap
+{
+	using Word = uint32_t;
+	static constexpr si32 wordBits = 32;
+
+	int3 sizes; // width, height and number of levels of the map
+	si32 wordsPerRow = 0;
+	std::vector<Word> words;
+
+	size_t rowOffset(si32 y, si32 z) const
+	{
+		return (static_cast<size_t>(z) * sizes.y + y) * wordsPerRow;
+	}
+
+	void setSpan(const int3 & start, si32 length, bool visible);
+
+	/// Returns position of first tile in range [x, last] of row with specified visibility, or last + 1 if there are none
+	si32 findNext(size_t row, si32 x, si32 last, bool visible) const;
+
+public:
+	/// Resizes map to specified dimensions, with all tiles hidden
+	void resize(const int3 & mapSize);
+
+	const int3 & getSize() const
+	{
+		return sizes;
+	}
+
+	bool isVisible(const int3 & tile) const
+	{
+		return (words[rowOffset(tile.y, tile.z) + tile.x / wordBits] >> (tile.x % wordBits)) & 1;
+	}
+
+	void reveal(const int3 & tile);
+	void hide(const int3 & tile);
+
+	void reveal(const TileSpanSet & tiles);
+	void hide(const TileSpanSet & tiles);
+
+	/// Adds to 'out' all tiles from span of 'length' tiles starting from 'start' that have requested visibility
+	void selectTiles(TileSpanSet & out, const int3 & start, si32 length, bool visible) const;
+
+	/// Converts fog of war from format used in saves prior to BIT_PACKED_FOG_OF_WAR
+	void loadLegacyFormat(const boost::multi_array<ui8, 3> & legacyMap);
+
+	template <typename Handler> void serialize(Handler & h)
+	{
+		h & sizes;
+		h & words;
+
+		if (!h.saving)
+			wordsPerRow = (sizes.x + wordBits - 1) / wordBits;
+	}
+};
+
+VCMI_LIB_NAMESPACE_END
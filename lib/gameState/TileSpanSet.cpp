@@ -0,0 +1,160 @@
+/*
+ * TileSpanSet.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "TileSpanSet.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+static bool isSameRow(const int3 & left, const int3 & right)
+{
+	return left.z == right.z && left.y == right.y;
+}
+
+static bool isRowBefore(const int3 & left, const int3 & right)
+{
+	if(left.z != right.z)
+		return left.z < right.z;
+	return left.y < right.y;
+}
+
+void TileSpanSet::insert(const int3 & tile)
+{
+	insert(tile, 1);
+}
+
+void TileSpanSet::insert(const int3 & start, si32 length)
+{
+	if(length <= 0)
+		return;
+
+	// fast path - spans are usually generated in row-major order
+	if(spans.empty() || isRowBefore(spans.back().start, start) || (isSameRow(spans.back().start, start) && spans.back().lastX() + 1 < start.x))
+	{
+		spans.emplace_back(start, length);
+		return;
+	}
+
+	// first span that overlaps or directly touches inserted span
+	auto first = std::lower_bound(spans.begin(), spans.end(), start, [](const TileSpan & span, const int3 & position)
+	{
+		if(!isSameRow(span.start, position))
+			return isRowBefore(span.start, position);
+		return span.lastX() + 1 < position.x;
+	});
+
+	si32 mergedFirst = start.x;
+	si32 mergedLast = start.x + length - 1;
+	auto last = first;
+
+	while(last != spans.end() && isSameRow(last->start, start) && last->start.x <= mergedLast + 1)
+	{
+		mergedFirst = std::min(mergedFirst, last->start.x);
+		mergedLast = std::max(mergedLast, last->lastX());
+		++last;
+	}
+
+	TileSpan merged(int3(mergedFirst, start.y, start.z), mergedLast - mergedFirst + 1);
+
+	if(first == last)
+	{
+		spans.insert(first, merged);
+	}
+	else
+	{
+		*first = merged;
+		spans.erase(first + 1, last);
+	}
+}
+
+void TileSpanSet::insert(const TileSpanSet & other)
+{
+	for(const auto & span : other.spans)
+		insert(span.start, span.length);
+}
+
+void TileSpanSet::erase(const TileSpanSet & other)
+{
+	if(empty() || other.empty())
+		return;
+
+	std::vector<TileSpan> result;
+	result.reserve(spans.size());
+
+	auto removed = other.spans.begin();
+
+	for(const auto & span : spans)
+	{
+		si32 current = span.start.x;
+
+		while(removed != other.spans.end() && (isRowBefore(removed->start, span.start) || (isSameRow(removed->start, span.start) && removed->lastX() < current)))
+			++removed;
+
+		// removed span may overlap with several of our spans, so keep 'removed' pointing to the first one
+		for(auto it = removed; it != other.spans.end() && isSameRow(it->start, span.start) && it->start.x <= span.lastX(); ++it)
+		{
+			if(it->start.x > current)
+				result.emplace_back(int3(current, span.start.y, span.start.z), it->start.x - current);
+			current = std::max(current, it->lastX() + 1);
+		}
+
+		if(current <= span.lastX())
+			result.emplace_back(int3(current, span.start.y, span.start.z), span.lastX() - current + 1);
+	}
+
+	spans = std::move(result);
+}
+
+bool TileSpanSet::contains(const int3 & tile) const
+{
+	auto it = std::lower_bound(spans.begin(), spans.end(), tile, [](const TileSpan & span, const int3 & position)
+	{
+		if(!isSameRow(span.start, position))
+			return isRowBefore(span.start, position);
+		return span.lastX() < position.x;
+	});
+
+	return it != spans.end() && isSameRow(it->start, tile) && it->start.x <= tile.x;
+}
+
+bool TileSpanSet::empty() const
+{
+	return spans.empty();
+}
+
+size_t TileSpanSet::size() const
+{
+	size_t result = 0;
+	for(const auto & span : spans)
+		result += span.length;
+	return result;
+}
+
+void TileSpanSet::clear()
+{
+	spans.clear();
+}
+
+const std::vector<TileSpan> & TileSpanSet::getSpans() const
+{
+	return spans;
+}
+
+std::unordered_set<int3> TileSpanSet::toSet() const
+{
+	std::unordered_set<int3> result;
+	result.reserve(size());
+	forEachTile([&result](const int3 & tile)
+	{
+		result.insert(tile);
+	});
+	return result;
+}
+
+VCMI_LIB_NAMESPACE_END
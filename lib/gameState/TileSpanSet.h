@@ -0,0 +1,99 @@
+/*
+ * TileSpanSet.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../int3.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Horizontal run of adjacent map tiles located on the same row
+struct DLL_LINKAGE TileSpan
+{
+	int3 start; // leftmost tile of the span
+	si32 length = 0;
+
+	TileSpan() = default;
+	TileSpan(const int3 & start, si32 length)
+		: start(start)
+		, length(length)
+	{}
+
+	/// x coordinate of rightmost tile of the span
+	si32 lastX() const
+	{
+		return start.x + length - 1;
+	}
+
+	bool operator==(const TileSpan & other) const
+	{
+		return start == other.start && length == other.length;
+	}
+
+	template <typename Handler> void serialize(Handler & h)
+	{
+		h & start;
+		h & length;
+	}
+};
+
+/// Set of map tiles, stored as list of sorted, non-overlapping and non-adjacent spans
+/// Compact replacement for hash set of tiles for large and mostly contiguous areas, such as fog of war changes
+class DLL_LINKAGE TileSpanSet
+{
+	std::vector<TileSpan> spans; // sorted by level, row, and then by column
+
+public:
+	/// Adds single tile to the set
+	void insert(const int3 & tile);
+
+	/// Adds span of 'length' tiles starting from 'start' and going to the right
+	void insert(const int3 & start, si32 length);
+
+	/// Adds all tiles from another set
+	void insert(const TileSpanSet & other);
+
+	/// Removes all tiles that are present in another set
+	void erase(const TileSpanSet & other);
+
+	bool contains(const int3 & tile) const;
+
+	bool empty() const;
+
+	/// Returns total number of tiles in the set
+	size_t size() const;
+
+	void clear();
+
+	const std::vector<TileSpan> & getSpans() const;
+
+	/// Converts set into hash set of individual tiles
+	std::unordered_set<int3> toSet() const;
+
+	/// Calls provided functor for every tile in the set, in row-major order
+	template<typename Func>
+	void forEachTile(const Func & func) const
+	{
+		for(const auto & span : spans)
+			for(int3 tile = span.start; tile.x <= span.lastX(); ++tile.x)
+				func(tile);
+	}
+
+	bool operator==(const TileSpanSet & other) const
+	{
+		return spans == other.spans;
+	}
+
+	template <typename Handler> void serialize(Handler & h)
+	{
+		h & spans;
+	}
+};
+
+VCMI_LIB_NAMESPACE_END
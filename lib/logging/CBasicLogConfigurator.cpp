@@ -51,6 +51,24 @@ void CBasicLogConfigurator::configure()
 		}
 		CLogger::getGlobalLogger()->clearTargets();
 
+		// With async logging enabled, console and file targets are written to from dedicated thread
+		std::unique_ptr<CLogAsyncTarget> asyncTarget;
+		const JsonNode & asyncNode = loggingNode["async"];
+		if(asyncNode["enabled"].Bool())
+		{
+			// settings may be edited by hand, so queue must not end up with zero or negative (wrapped) capacity
+			auto queueSize = std::max<int64_t>(1, asyncNode["queueSize"].Integer());
+			asyncTarget = std::make_unique<CLogAsyncTarget>(static_cast<size_t>(queueSize));
+		}
+
+		auto addTarget = [&asyncTarget](std::unique_ptr<ILogTarget> && target)
+		{
+			if(asyncTarget)
+				asyncTarget->addTarget(std::move(target));
+			else
+				CLogger::getGlobalLogger()->addTarget(std::move(target));
+		};
+
 		// Add console target
 		auto consoleTarget = std::make_unique<CLogConsoleTarget>(console);
 		const JsonNode & consoleNode = loggingNode["console"];
@@ -77,7 +95,7 @@ void CBasicLogConfigurator::configure()
 			}
 			consoleTarget->setColorMapping(colorMapping);
 		}
-		CLogger::getGlobalLogger()->addTarget(std::move(consoleTarget));
+		addTarget(std::move(consoleTarget));
 
 		// Add file target
 		auto fileTarget = std::make_unique<CLogFileTarget>(filePath, appendToLogFile);
@@ -87,7 +105,10 @@ void CBasicLogConfigurator::configure()
 			const JsonNode & fileFormatNode = fileNode["format"];
 			if(!fileFormatNode.isNull()) fileTarget->setFormatter(CLogFormatter(fileFormatNode.String()));
 		}
-		CLogger::getGlobalLogger()->addTarget(std::move(fileTarget));
+		addTarget(std::move(fileTarget));
+
+		if(asyncTarget)
+			CLogger::getGlobalLogger()->addTarget(std::move(asyncTarget));
 		appendToLogFile = true;
 	}
 	catch(const std::exception & e)
@@ -449,6 +449,156 @@ CLogFileTarget::~CLogFileTarget()
 	file.close();
 }
 
+struct CLogRecordQueue::Slot
+{
+	std::atomic<size_t> sequence;
+	std::optional<LogRecord> record;
+};
+
+CLogRecordQueue::CLogRecordQueue(size_t capacity)
+	: pushPosition(0)
+	, popPosition(0)
+{
+	size_t actualCapacity = 2;
+	while(actualCapacity < capacity)
+		actualCapacity *= 2;
+
+	mask = actualCapacity - 1;
+	slots = std::make_unique<Slot[]>(actualCapacity);
+
+	// slot is free for writing when its sequence equals to push position that maps onto it
+	for(size_t i = 0; i < actualCapacity; ++i)
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+CLogRecordQueue::~CLogRecordQueue() = default;
+
+bool CLogRecordQueue::push(LogRecord && record)
+{
+	size_t position = pushPosition.load(std::memory_order_relaxed);
+	Slot * slot;
+
+	while(true)
+	{
+		slot = &slots[position & mask];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+		if(difference == 0)
+		{
+			// slot is free - try to claim it, otherwise another producer was faster and position is reloaded
+			if(pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if(difference < 0)
+		{
+			// slot still holds record from previous lap that was not consumed yet
+			return false;
+		}
+		else
+		{
+			position = pushPosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->record = std::move(record);
+	slot->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+std::optional<LogRecord> CLogRecordQueue::pop()
+{
+	Slot & slot = slots[popPosition & mask];
+	size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+	if(sequence != popPosition + 1)
+		return std::nullopt;
+
+	std::optional<LogRecord> result = std::move(slot.record);
+	slot.record.reset();
+	slot.sequence.store(popPosition + mask + 1, std::memory_order_release);
+	++popPosition;
+	return result;
+}
+
+CLogAsyncTarget::CLogAsyncTarget(size_t queueCapacity)
+	: queue(queueCapacity)
+	, droppedRecords(0)
+	, writerSleeping(false)
+	, stopRequested(false)
+{
+	writerThread = boost::thread(&CLogAsyncTarget::runWriter, this);
+}
+
+CLogAsyncTarget::~CLogAsyncTarget()
+{
+	{
+		std::lock_guard lock(writerMutex);
+		stopRequested = true;
+	}
+	writerCondition.notify_one();
+	writerThread.join();
+}
+
+void CLogAsyncTarget::addTarget(std::unique_ptr<ILogTarget> && target)
+{
+	targets.push_back(std::move(target));
+}
+
+void CLogAsyncTarget::write(const LogRecord & record)
+{
+	if(!queue.push(LogRecord(record)))
+	{
+		droppedRecords.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	// wake up only if writer is waiting, to avoid system call for every record
+	if(writerSleeping.load(std::memory_order_relaxed))
+		writerCondition.notify_one();
+}
+
+bool CLogAsyncTarget::writeQueuedRecords()
+{
+	bool anyWritten = false;
+
+	while(auto record = queue.pop())
+	{
+		for(const auto & target : targets)
+			target->write(*record);
+		anyWritten = true;
+	}
+
+	size_t dropped = droppedRecords.exchange(0, std::memory_order_relaxed);
+	if(dropped != 0)
+	{
+		LogRecord report(CLoggerDomain(CLoggerDomain::DOMAIN_GLOBAL), ELogLevel::WARN, std::to_string(dropped) + " log messages were dropped due to full log queue");
+		for(const auto & target : targets)
+			target->write(report);
+	}
+
+	return anyWritten;
+}
+
+void CLogAsyncTarget::runWriter()
+{
+	setThreadName("logWriter");
+
+	while(!stopRequested)
+	{
+		if(writeQueuedRecords())
+			continue;
+
+		std::unique_lock lock(writerMutex);
+		writerSleeping = true;
+		// producers don't lock the mutex, so notification may be missed - timeout keeps latency bounded in this case
+		writerCondition.wait_for(lock, std::chrono::milliseconds(50), [this](){ return stopRequested.load(); });
+		writerSleeping = false;
+	}
+
+	writeQueuedRecords();
+}
+
 LogRecord::LogRecord(const CLoggerDomain & domain, ELogLevel::ELogLevel level, const std::string & message)
 	: domain(domain),
 	level(level),
@@ -11,6 +11,8 @@
 
 #include "../CConsoleHandler.h"
 
+#include <condition_variable>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 class CLogger;
@@ -75,7 +77,7 @@ private:
 
 	CLoggerDomain domain;
 	CLogger * parent;
-	ELogLevel::ELogLevel level;
+	std::atomic<ELogLevel::ELogLevel> level; /// read without locking on every log call
 	std::vector<std::unique_ptr<ILogTarget> > targets;
 	mutable std::mutex mx;
 	static std::recursive_mutex smx;
@@ -219,4 +221,59 @@ private:
 	mutable std::mutex mx;
 };
 
+/// Bounded queue of log records that can be filled by any number of threads and drained by a single thread.
+/// Every slot holds a sequence number that tells whether slot is free or filled, so neither producers
+/// nor the consumer ever take a lock. When the queue is full new records are rejected instead of waiting.
+class DLL_LINKAGE CLogRecordQueue : public boost::noncopyable
+{
+public:
+	/// Capacity is rounded up to power of two
+	explicit CLogRecordQueue(size_t capacity);
+	~CLogRecordQueue();
+
+	/// Returns false if queue is full. May be called from any thread
+	bool push(LogRecord && record);
+
+	/// Returns oldest record or nothing if queue is empty. Must be called from one thread only
+	std::optional<LogRecord> pop();
+
+private:
+	struct Slot;
+
+	std::unique_ptr<Slot[]> slots;
+	size_t mask;
+	std::atomic<size_t> pushPosition;
+	size_t popPosition;
+};
+
+/// This target passes log records to other targets on a dedicated writer thread, so logging thread only has to
+/// place record into the queue. Records that don't fit into the queue are dropped, and the number of dropped
+/// records is reported by the writer thread once the queue has been drained.
+/// Targets must be added before the target is added to a logger.
+class DLL_LINKAGE CLogAsyncTarget : public ILogTarget
+{
+public:
+	explicit CLogAsyncTarget(size_t queueCapacity);
+	/// Stops writer thread after writing all records that are still queued
+	~CLogAsyncTarget();
+
+	void addTarget(std::unique_ptr<ILogTarget> && target);
+
+	void write(const LogRecord & record) override;
+
+private:
+	void runWriter();
+	bool writeQueuedRecords();
+
+	CLogRecordQueue queue;
+	std::vector<std::unique_ptr<ILogTarget>> targets;
+
+	std::atomic<size_t> droppedRecords;
+	std::atomic<bool> writerSleeping;
+	std::atomic<bool> stopRequested;
+	std::mutex writerMutex;
+	std::condition_variable writerCondition;
+	boost::thread writerThread;
+};
+
 VCMI_LIB_NAMESPACE_END
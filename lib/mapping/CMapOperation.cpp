@@ -19,6 +19,8 @@
 
 #include <vstd/RNG.h>
 
+#include <tbb/parallel_for.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 CMapOperation::CMapOperation(CMap* map) : map(map)
@@ -93,7 +95,10 @@ CDrawTerrainOperation::CDrawTerrainOperation(CMap * map, CTerrainSelection terra
 	terrainSel(std::move(terrainSel)),
 	terType(terType),
 	decorationsPercentage(decorationsPercentage),
-	gen(gen)
+	gen(gen),
+	invalidatedTerViews(static_cast<size_t>(map->width) * map->height * map->levels(), false),
+	invalidatedMin(map->width, map->height, map->levels()),
+	invalidatedMax(-1, -1, -1)
 {
 
 }
@@ -262,65 +267,191 @@ void CDrawTerrainOperation::updateTerrainTypes()
 
 void CDrawTerrainOperation::updateTerrainViews()
 {
-	for(const auto & pos : invalidatedTerViews)
+	// collect tiles in the same [z][y][x] order in which they were processed when stored in std::set,
+	// so random numbers are drawn in the same sequence
+	std::vector<int3> tiles;
+	int3 pos;
+	for(pos.z = invalidatedMin.z; pos.z <= invalidatedMax.z; ++pos.z)
+		for(pos.y = invalidatedMin.y; pos.y <= invalidatedMax.y; ++pos.y)
+			for(pos.x = invalidatedMin.x; pos.x <= invalidatedMax.x; ++pos.x)
+				if(invalidatedTerViews[(static_cast<size_t>(pos.z) * map->height + pos.y) * map->width + pos.x])
+					tiles.push_back(pos);
+
+	std::vector<TerrainViewSignature> signatures(tiles.size());
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, tiles.size()), [&](const tbb::blocked_range<size_t> & r)
+	{
+		for(size_t i = r.begin(); i != r.end(); ++i)
+			signatures[i] = getTerrainViewSignature(tiles[i]);
+	});
+
+	// patterns are matched only once for every distinct neighbourhood
+	std::vector<size_t> unmatchedTiles;
+	for(size_t i = 0; i < tiles.size(); ++i)
+		if(terrainViewMatches.emplace(signatures[i], TerrainViewMatch()).second)
+			unmatchedTiles.push_back(i);
+
+	std::vector<TerrainViewMatch> matches(unmatchedTiles.size());
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, unmatchedTiles.size()), [&](const tbb::blocked_range<size_t> & r)
 	{
-		const auto & patterns = VLC->terviewh->getTerrainViewPatterns(map->getTile(pos).getTerrainID());
+		for(size_t i = r.begin(); i != r.end(); ++i)
+			matches[i] = findTerrainViewMatch(tiles[unmatchedTiles[i]]);
+	});
+
+	for(size_t i = 0; i < unmatchedTiles.size(); ++i)
+		terrainViewMatches[signatures[unmatchedTiles[i]]] = matches[i];
+
+	for(size_t i = 0; i < tiles.size(); ++i)
+		applyTerrainView(tiles[i], terrainViewMatches.at(signatures[i]));
+}
 
-		// Detect a pattern which fits best
-		int bestPattern = -1;
-		ValidationResult valRslt(false);
-		for(int k = 0; k < patterns.size(); ++k)
+size_t CDrawTerrainOperation::TerrainViewSignatureHash::operator()(const TerrainViewSignature & signature) const
+{
+	size_t result = std::hash<int>()(signature.centerTerrain.getNum());
+	boost::hash_range(result, signature.cells.begin(), signature.cells.end());
+	return result;
+}
+
+CDrawTerrainOperation::TerrainViewSignature CDrawTerrainOperation::getTerrainViewSignature(const int3 & pos) const
+{
+	// tile has same terrain as center
+	static constexpr uint8_t CELL_NATIVE = 0;
+	// tile is outside of map, validation uses terrain of adjacent tile instead
+	static constexpr uint8_t CELL_OUTSIDE = 1;
+	// tile has other terrain, combined with flags below
+	static constexpr uint8_t CELL_FOREIGN = 4;
+	static constexpr uint8_t FLAG_TRANSITION = 1;
+	static constexpr uint8_t FLAG_PASSABLE = 2;
+
+	const auto * centerTerType = map->getTile(pos).getTerrain();
+
+	TerrainViewSignature signature;
+	signature.centerTerrain = centerTerType->getId();
+
+	size_t cellIndex = 0;
+	for(int dy = -2; dy <= 2; ++dy)
+	{
+		for(int dx = -2; dx <= 2; ++dx)
 		{
-			const auto & pattern = patterns[k];
-			//(ETerrainGroup::ETerrainGroup terGroup, const std::string & id)
-			valRslt = validateTerrainView(pos, &pattern);
-			if (valRslt.result)
+			if(dx == 0 && dy == 0)
+				continue;
+
+			int3 cell(pos.x + dx, pos.y + dy, pos.z);
+			uint8_t cellClass = CELL_NATIVE;
+
+			if(map->isInTheMap(cell))
 			{
-				bestPattern = k;
-				break;
+				const auto * terType = map->getTile(cell).getTerrain();
+				if(terType->getId() != centerTerType->getId())
+				{
+					cellClass = CELL_FOREIGN;
+					if(terType->isTransitionRequired())
+						cellClass |= FLAG_TRANSITION;
+					if(terType->isPassable())
+						cellClass |= FLAG_PASSABLE;
+				}
 			}
+			else
+			{
+				// same substitution as in validateTerrainViewInner. Substitute may be outside of map too only for
+				// cells of outer ring that are never validated, their class does not matter
+				const TerrainType * terType = centerTerType;
+				int3 substitute = cell;
+				bool widthTooHigh = cell.x >= map->width;
+				bool widthTooLess = cell.x < 0;
+				bool heightTooHigh = cell.y >= map->height;
+				bool heightTooLess = cell.y < 0;
+
+				if((widthTooHigh || widthTooLess) && (heightTooHigh || heightTooLess))
+					substitute = pos;
+				else if(widthTooHigh)
+					substitute.x -= 1;
+				else if(heightTooHigh)
+					substitute.y -= 1;
+				else if(widthTooLess)
+					substitute.x += 1;
+				else if(heightTooLess)
+					substitute.y += 1;
+
+				if(map->isInTheMap(substitute))
+					terType = map->getTile(substitute).getTerrain();
+
+				cellClass = CELL_OUTSIDE;
+				if(terType->isTransitionRequired())
+					cellClass |= FLAG_TRANSITION;
+			}
+
+			signature.cells[cellIndex++] = cellClass;
 		}
-		//assert(bestPattern != -1);
-		if(bestPattern == -1)
-		{
-			// This shouldn't be the case
-			logGlobal->warn("No pattern detected at pos '%s'.", pos.toString());
-			CTerrainViewPatternUtils::printDebuggingInfoAboutTile(map, pos);
-			continue;
-		}
+	}
+	return signature;
+}
 
-		// Get mapping
-		const TerrainViewPattern& pattern = patterns[bestPattern][valRslt.flip];
-		std::pair<int, int> mapping;
+CDrawTerrainOperation::TerrainViewMatch CDrawTerrainOperation::findTerrainViewMatch(const int3 & pos) const
+{
+	const auto & patterns = VLC->terviewh->getTerrainViewPatterns(map->getTile(pos).getTerrainID());
 
-		mapping = pattern.mapping[0];
+	TerrainViewMatch match;
 
-		if(pattern.decoration)
+	// Detect a pattern which fits best
+	for(int k = 0; k < patterns.size(); ++k)
+	{
+		match.validation = validateTerrainView(pos, &patterns[k]);
+		if (match.validation.result)
 		{
-			if (pattern.mapping.size() < 2 || gen->nextInt(100) > decorationsPercentage)
-				mapping = pattern.mapping[0];
-			else
-				mapping = pattern.mapping[1];
+			match.pattern = k;
+			break;
 		}
+	}
+	return match;
+}
+
+void CDrawTerrainOperation::applyTerrainView(const int3 & pos, const TerrainViewMatch & match)
+{
+	//assert(match.pattern != -1);
+	if(match.pattern == -1)
+	{
+		// This shouldn't be the case
+		logGlobal->warn("No pattern detected at pos '%s'.", pos.toString());
+		CTerrainViewPatternUtils::printDebuggingInfoAboutTile(map, pos);
+		return;
+	}
 
-		if (!valRslt.transitionReplacement.empty())
-			mapping = valRslt.transitionReplacement == TerrainViewPattern::RULE_DIRT ? pattern.mapping[0] : pattern.mapping[1];
+	const auto & patterns = VLC->terviewh->getTerrainViewPatterns(map->getTile(pos).getTerrainID());
+	const ValidationResult & valRslt = match.validation;
 
-		// Set terrain view
-		auto & tile = map->getTile(pos);
-		if(!pattern.diffImages)
-		{
-			tile.terView = gen->nextInt(mapping.first, mapping.second);
-			tile.extTileFlags = valRslt.flip;
-		}
+	// Get mapping
+	const TerrainViewPattern& pattern = patterns[match.pattern][valRslt.flip];
+	std::pair<int, int> mapping;
+
+	mapping = pattern.mapping[0];
+
+	if(pattern.decoration)
+	{
+		if (pattern.mapping.size() < 2 || gen->nextInt(100) > decorationsPercentage)
+			mapping = pattern.mapping[0];
 		else
-		{
-			const int framesPerRot = (mapping.second - mapping.first + 1) / pattern.rotationTypesCount;
-			int flip = (pattern.rotationTypesCount == 2 && valRslt.flip == 2) ? 1 : valRslt.flip;
-			int firstFrame = mapping.first + flip * framesPerRot;
-			tile.terView = gen->nextInt(firstFrame, firstFrame + framesPerRot - 1);
-			tile.extTileFlags = 0;
-		}
+			mapping = pattern.mapping[1];
+	}
+
+	if (!valRslt.transitionReplacement.empty())
+		mapping = valRslt.transitionReplacement == TerrainViewPattern::RULE_DIRT ? pattern.mapping[0] : pattern.mapping[1];
+
+	// Set terrain view
+	auto & tile = map->getTile(pos);
+	if(!pattern.diffImages)
+	{
+		tile.terView = gen->nextInt(mapping.first, mapping.second);
+		tile.extTileFlags = valRslt.flip;
+	}
+	else
+	{
+		const int framesPerRot = (mapping.second - mapping.first + 1) / pattern.rotationTypesCount;
+		int flip = (pattern.rotationTypesCount == 2 && valRslt.flip == 2) ? 1 : valRslt.flip;
+		int firstFrame = mapping.first + flip * framesPerRot;
+		tile.terView = gen->nextInt(firstFrame, firstFrame + framesPerRot - 1);
+		tile.extTileFlags = 0;
 	}
 }
 
@@ -501,7 +632,9 @@ void CDrawTerrainOperation::invalidateTerrainViews(const int3& centerPos)
 	auto rect = extendTileAroundSafely(centerPos);
 	rect.forEach([&](const int3& pos)
 		{
-			invalidatedTerViews.insert(pos);
+			invalidatedTerViews[(static_cast<size_t>(pos.z) * map->height + pos.y) * map->width + pos.x] = true;
+			invalidatedMin = int3(std::min(invalidatedMin.x, pos.x), std::min(invalidatedMin.y, pos.y), std::min(invalidatedMin.z, pos.z));
+			invalidatedMax = int3(std::max(invalidatedMax.x, pos.x), std::max(invalidatedMax.y, pos.y), std::max(invalidatedMax.z, pos.z));
 		});
 }
 
@@ -516,28 +649,7 @@ CDrawTerrainOperation::InvalidTiles CDrawTerrainOperation::getInvalidTiles(const
 			if(map->isInTheMap(pos))
 			{
 				const auto * terType = map->getTile(pos).getTerrain();
-				auto valid = validateTerrainView(pos, VLC->terviewh->getTerrainTypePatternById("n1")).result;
-
-				// Special validity check for rock & water
-				if(valid && (terType->isWater() || !terType->isPassable()))
-				{
-					static const std::string patternIds[] = { "s1", "s2" };
-					for(const auto & patternId : patternIds)
-					{
-						valid = !validateTerrainView(pos, VLC->terviewh->getTerrainTypePatternById(patternId)).result;
-						if(!valid) break;
-					}
-				}
-				// Additional validity check for non rock OR water
-				else if(!valid && (terType->isLand() && terType->isPassable()))
-				{
-					static const std::string patternIds[] = { "n2", "n3" };
-					for(const auto & patternId : patternIds)
-					{
-						valid = validateTerrainView(pos, VLC->terviewh->getTerrainTypePatternById(patternId)).result;
-						if(valid) break;
-					}
-				}
+				bool valid = isTerrainViewValid(pos);
 
 				if(!valid)
 				{
@@ -553,6 +665,41 @@ CDrawTerrainOperation::InvalidTiles CDrawTerrainOperation::getInvalidTiles(const
 	return tiles;
 }
 
+bool CDrawTerrainOperation::isTerrainViewValid(const int3 & pos) const
+{
+	auto signature = getTerrainViewSignature(pos);
+	auto cached = terrainViewValidity.find(signature);
+	if(cached != terrainViewValidity.end())
+		return cached->second;
+
+	const auto * terType = map->getTile(pos).getTerrain();
+	auto valid = validateTerrainView(pos, VLC->terviewh->getTerrainTypePatternById("n1")).result;
+
+	// Special validity check for rock & water
+	if(valid && (terType->isWater() || !terType->isPassable()))
+	{
+		static const std::string patternIds[] = { "s1", "s2" };
+		for(const auto & patternId : patternIds)
+		{
+			valid = !validateTerrainView(pos, VLC->terviewh->getTerrainTypePatternById(patternId)).result;
+			if(!valid) break;
+		}
+	}
+	// Additional validity check for non rock OR water
+	else if(!valid && (terType->isLand() && terType->isPassable()))
+	{
+		static const std::string patternIds[] = { "n2", "n3" };
+		for(const auto & patternId : patternIds)
+		{
+			valid = validateTerrainView(pos, VLC->terviewh->getTerrainTypePatternById(patternId)).result;
+			if(valid) break;
+		}
+	}
+
+	terrainViewValidity.emplace(signature, valid);
+	return valid;
+}
+
 CDrawTerrainOperation::ValidationResult::ValidationResult(bool result, std::string transitionReplacement)
 	: result(result)
 	, transitionReplacement(std::move(transitionReplacement))
@@ -94,11 +94,42 @@ private:
 		InvalidTiles() : centerPosValid(false) { }
 	};
 
+	/// Everything that pattern validation of a tile can depend on: terrain of the tile and class of each tile
+	/// in the surrounding 5x5 area (outer ring is used by patterns that validate neighbouring tiles recursively).
+	/// Tiles with equal signatures always match the same terrain view pattern
+	struct TerrainViewSignature
+	{
+		TerrainId centerTerrain;
+		std::array<uint8_t, 24> cells = {};
+
+		bool operator==(const TerrainViewSignature & other) const
+		{
+			return centerTerrain == other.centerTerrain && cells == other.cells;
+		}
+	};
+
+	struct TerrainViewSignatureHash
+	{
+		size_t operator()(const TerrainViewSignature & signature) const;
+	};
+
+	/// Best pattern for a terrain view signature, or -1 if none of the patterns fit
+	struct TerrainViewMatch
+	{
+		int pattern = -1;
+		ValidationResult validation = ValidationResult(false);
+	};
+
 	void updateTerrainTypes();
 	void invalidateTerrainViews(const int3 & centerPos);
 	InvalidTiles getInvalidTiles(const int3 & centerPos) const;
+	bool isTerrainViewValid(const int3 & pos) const;
 
 	void updateTerrainViews();
+	TerrainViewSignature getTerrainViewSignature(const int3 & pos) const;
+	TerrainViewMatch findTerrainViewMatch(const int3 & pos) const;
+	void applyTerrainView(const int3 & pos, const TerrainViewMatch & match);
+
 	/// Validates the terrain view of the given position and with the given pattern. The first method wraps the
 	/// second method to validate the terrain view with the given pattern in all four flip directions(horizontal, vertical).
 	ValidationResult validateTerrainView(const int3 & pos, const std::vector<TerrainViewPattern> * pattern, int recDepth = 0) const;
@@ -108,7 +139,15 @@ private:
 	TerrainId terType;
 	int decorationsPercentage;
 	vstd::RNG* gen;
-	std::set<int3> invalidatedTerViews;
+
+	/// Flat bitmap of tiles with invalidated terrain view, indexed as [z][y][x], and bounding box of these tiles
+	std::vector<bool> invalidatedTerViews;
+	int3 invalidatedMin;
+	int3 invalidatedMax;
+
+	/// Results of pattern matching, cached by neighbourhood signature
+	std::unordered_map<TerrainViewSignature, TerrainViewMatch, TerrainViewSignatureHash> terrainViewMatches;
+	mutable std::unordered_map<TerrainViewSignature, bool, TerrainViewSignatureHash> terrainViewValidity;
 };
 
 /// The CClearTerrainOperation clears+initializes the terrain.
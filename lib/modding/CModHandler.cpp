@@ -60,6 +60,7 @@ static JsonNode genDefaultFS()
 	defaultFS[""].Vector()[0]["path"].String() = "/Content.zip";
 	defaultFS[""].Vector()[1]["type"].String() = "dir";
 	defaultFS[""].Vector()[1]["path"].String() = "/Content";
+	defaultFS[""].Vector()[1]["mapped"].Bool() = true;
 	return defaultFS;
 }
 
@@ -19,6 +19,8 @@
 
 #include <vstd/StringUtils.h>
 
+#include <tbb/parallel_for.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 CIdentifierStorage::CIdentifierStorage()
@@ -336,11 +338,11 @@ void CIdentifierStorage::registerObject(const std::string & scope, const std::st
 	std::string fullID = type + '.' + name;
 	checkIdentifier(fullID);
 
-	std::pair<const std::string, ObjectData> mapping = std::make_pair(fullID, data);
-	if(!vstd::containsMapping(registeredObjects, mapping))
+	auto range = registeredObjects.equal_range(fullID);
+	if(std::find_if(range.first, range.second, [&data](const auto & entry){ return entry.second == data; }) == range.second)
 	{
 		logMod->trace("registered '%s' as %s:%s", fullID, scope, identifier);
-		registeredObjects.insert(mapping);
+		registeredObjects.emplace(fullID, data);
 	}
 	else
 	{
@@ -348,8 +350,17 @@ void CIdentifierStorage::registerObject(const std::string & scope, const std::st
 	}
 }
 
-std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdentifiers(const ObjectCallback & request) const
+std::shared_ptr<const std::set<std::string>> CIdentifierStorage::getAllowedScopes(const ObjectCallback & request) const
 {
+	std::lock_guard lock(allowedScopesMutex);
+
+	auto cacheKey = std::make_pair(request.localScope, request.remoteScope);
+	auto cached = allowedScopesCache.find(cacheKey);
+	if (cached != allowedScopesCache.end())
+		return cached->second;
+
+	auto & result = allowedScopesCache[cacheKey];
+
 	std::set<std::string> allowedScopes;
 	bool isValidScope = true;
 
@@ -369,7 +380,7 @@ std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdent
 			allowedScopes = VLC->modh->getModDependencies(request.localScope, isValidScope);
 
 			if(!isValidScope)
-				return std::vector<ObjectData>();
+				return nullptr;
 
 			allowedScopes.insert(request.localScope);
 		}
@@ -401,13 +412,24 @@ std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdent
 			auto myDeps = VLC->modh->getModDependencies(request.localScope, isValidScope);
 
 			if(!isValidScope)
-				return std::vector<ObjectData>();
+				return nullptr;
 
 			if(myDeps.count(request.remoteScope))
 				allowedScopes.insert(request.remoteScope);
 		}
 	}
 
+	result = std::make_shared<const std::set<std::string>>(std::move(allowedScopes));
+	return result;
+}
+
+std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdentifiers(const ObjectCallback & request) const
+{
+	auto allowedScopes = getAllowedScopes(request);
+
+	if (!allowedScopes)
+		return std::vector<ObjectData>();
+
 	std::string fullID = request.type + '.' + request.name;
 
 	auto entries = registeredObjects.equal_range(fullID);
@@ -417,7 +439,7 @@ std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdent
 
 		for (auto it = entries.first; it != entries.second; it++)
 		{
-			if (vstd::contains(allowedScopes, it->second.scope))
+			if (allowedScopes->count(it->second.scope))
 			{
 				locatedIDs.push_back(it->second);
 			}
@@ -429,7 +451,11 @@ std::vector<CIdentifierStorage::ObjectData> CIdentifierStorage::getPossibleIdent
 
 bool CIdentifierStorage::resolveIdentifier(const ObjectCallback & request) const
 {
-	auto identifiers = getPossibleIdentifiers(request);
+	return resolveIdentifier(request, getPossibleIdentifiers(request));
+}
+
+bool CIdentifierStorage::resolveIdentifier(const ObjectCallback & request, const std::vector<ObjectData> & identifiers) const
+{
 	if (identifiers.size() == 1) // normally resolved ID
 	{
 		request.callback(identifiers.front().id);
@@ -453,12 +479,37 @@ void CIdentifierStorage::finalize()
 
 	state = ELoadingState::FINALIZING;
 
-	while ( !scheduledRequests.empty() )
+	// Lookups of all requests scheduled during loading are done in parallel, callbacks are then called sequentially
+	std::vector<ObjectCallback> batch;
+	std::swap(batch, scheduledRequests);
+
+	std::vector<std::vector<ObjectData>> batchIdentifiers(batch.size());
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.size()), [&](const tbb::blocked_range<size_t> & r)
+	{
+		for(size_t i = r.begin(); i != r.end(); ++i)
+			batchIdentifiers[i] = getPossibleIdentifiers(batch[i]);
+	});
+
+	const size_t registeredBeforeCallbacks = registeredObjects.size();
+
+	// resolve in same order as if requests were popped one by one from the back of the queue
+	for(size_t i = batch.size(); i-- > 0;)
 	{
-		// Use local copy since new requests may appear during resolving, invalidating any iterators
-		auto request = scheduledRequests.back();
-		scheduledRequests.pop_back();
-		resolveIdentifier(request);
+		// some callback has registered new object, so precomputed lookup may be outdated
+		if (registeredObjects.size() != registeredBeforeCallbacks)
+			resolveIdentifier(batch[i]);
+		else
+			resolveIdentifier(batch[i], batchIdentifiers[i]);
+
+		// requests that appeared during resolving are processed immediately, before the rest of the batch
+		while ( !scheduledRequests.empty() )
+		{
+			// Use local copy since new requests may appear during resolving, invalidating any iterators
+			auto request = scheduledRequests.back();
+			scheduledRequests.pop_back();
+			resolveIdentifier(request);
+		}
 	}
 
 	state = ELoadingState::FINISHED;
@@ -55,9 +55,14 @@ class DLL_LINKAGE CIdentifierStorage
 		}
 	};
 
-	std::multimap<std::string, ObjectData> registeredObjects;
+	/// map "type.name" -> objects registered under this identifier in different scopes
+	std::unordered_multimap<std::string, ObjectData> registeredObjects;
 	mutable std::vector<ObjectCallback> scheduledRequests;
 
+	/// Scopes accessible by requests, cached by (local scope, remote scope) pair. nullptr if local scope is not valid
+	mutable std::map<std::pair<std::string, std::string>, std::shared_ptr<const std::set<std::string>>> allowedScopesCache;
+	mutable std::mutex allowedScopesMutex;
+
 	/// All non-optional requests that have failed to resolve, for debug & error reporting
 	mutable std::vector<ObjectCallback> failedRequests;
 
@@ -71,7 +76,9 @@ class DLL_LINKAGE CIdentifierStorage
 
 	void requestIdentifier(ObjectCallback callback) const;
 	bool resolveIdentifier(const ObjectCallback & callback) const;
+	bool resolveIdentifier(const ObjectCallback & callback, const std::vector<ObjectData> & identifiers) const;
 	std::vector<ObjectData> getPossibleIdentifiers(const ObjectCallback & callback) const;
+	std::shared_ptr<const std::set<std::string>> getAllowedScopes(const ObjectCallback & callback) const;
 
 	void showIdentifierResolutionErrorDetails(const ObjectCallback & callback) const;
 	std::optional<si32> getIdentifierImpl(const ObjectCallback & callback, bool silent) const;
@@ -15,6 +15,7 @@ VCMI_LIB_NAMESPACE_BEGIN
 NetworkConnection::NetworkConnection(INetworkConnectionListener & listener, const std::shared_ptr<NetworkSocket> & socket, const std::shared_ptr<NetworkContext> & context)
 	: socket(socket)
 	, timer(std::make_shared<NetworkTimer>(*context))
+	, strand(context->get_executor())
 	, listener(listener)
 {
 	socket->set_option(boost::asio::ip::tcp::no_delay(true));
@@ -43,8 +44,11 @@ NetworkConnection::NetworkConnection(INetworkConnectionListener & listener, cons
 
 void NetworkConnection::start()
 {
-	heartbeat();
-	startReceiving();
+	boost::asio::dispatch(strand, [self = shared_from_this()]()
+	{
+		self->heartbeat();
+		self->startReceiving();
+	});
 }
 
 void NetworkConnection::startReceiving()
@@ -52,7 +56,7 @@ void NetworkConnection::startReceiving()
 	boost::asio::async_read(*socket,
 							readBuffer,
 							boost::asio::transfer_exactly(messageHeaderSize),
-							[self = shared_from_this()](const auto & ec, const auto & endpoint) { self->onHeaderReceived(ec); });
+							boost::asio::bind_executor(strand, [self = shared_from_this()](const auto & ec, const auto & endpoint) { self->onHeaderReceived(ec); }));
 }
 
 void NetworkConnection::heartbeat()
@@ -60,7 +64,7 @@ void NetworkConnection::heartbeat()
 	constexpr auto heartbeatInterval = std::chrono::seconds(10);
 
 	timer->expires_after(heartbeatInterval);
-	timer->async_wait( [self = weak_from_this()](const auto & ec)
+	timer->async_wait(boost::asio::bind_executor(strand, [self = weak_from_this()](const auto & ec)
 	{
 		if (ec)
 			return;
@@ -71,7 +75,7 @@ void NetworkConnection::heartbeat()
 
 		locked->sendPacket({});
 		locked->heartbeat();
-	});
+	}));
 }
 
 void NetworkConnection::onHeaderReceived(const boost::system::error_code & ecHeader)
@@ -104,7 +108,7 @@ void NetworkConnection::onHeaderReceived(const boost::system::error_code & ecHea
 	boost::asio::async_read(*socket,
 							readBuffer,
 							boost::asio::transfer_exactly(messageSize),
-							[self = shared_from_this(), messageSize](const auto & ecPayload, const auto & endpoint) { self->onPacketReceived(ecPayload, messageSize); });
+							boost::asio::bind_executor(strand, [self = shared_from_this(), messageSize](const auto & ecPayload, const auto & endpoint) { self->onPacketReceived(ecPayload, messageSize); }));
 }
 
 void NetworkConnection::onPacketReceived(const boost::system::error_code & ec, uint32_t expectedPacketSize)
@@ -122,13 +126,51 @@ void NetworkConnection::onPacketReceived(const boost::system::error_code & ec, u
 		onError(errorMessage);
 	}
 
-	std::vector<std::byte> message(expectedPacketSize);
-	readBuffer.sgetn(reinterpret_cast<char *>(message.data()), expectedPacketSize);
-	listener.onPacketReceived(shared_from_this(), message);
+	auto message = std::make_shared<std::vector<std::byte>>(expectedPacketSize);
+	readBuffer.sgetn(reinterpret_cast<char *>(message->data()), expectedPacketSize);
+
+	if (!relayPacket(message))
+		listener.onPacketReceived(shared_from_this(), *message);
 
 	startReceiving();
 }
 
+bool NetworkConnection::relayPacket(const PacketBuffer & message)
+{
+	std::shared_ptr<NetworkConnection> target;
+	std::shared_ptr<NetworkRelayStatistics> statistics;
+
+	{
+		std::lock_guard lock(relayMutex);
+		target = relayTarget.lock();
+		statistics = relayStatistics;
+	}
+
+	if (!target)
+		return false;
+
+	target->sendBuffer(message);
+
+	if (statistics)
+	{
+		statistics->packets += 1;
+		statistics->bytes += message->size();
+	}
+	return true;
+}
+
+void NetworkConnection::setRelayTarget(const std::shared_ptr<INetworkConnection> & target, const std::shared_ptr<NetworkRelayStatistics> & statistics)
+{
+	auto targetConnection = std::dynamic_pointer_cast<NetworkConnection>(target);
+
+	if (target && !targetConnection)
+		throw std::runtime_error("Packets can only be relayed between network connections!");
+
+	std::lock_guard lock(relayMutex);
+	relayTarget = targetConnection;
+	relayStatistics = statistics;
+}
+
 void NetworkConnection::setAsyncWritesEnabled(bool on)
 {
 	asyncWritesEnabled = on;
@@ -136,32 +178,43 @@ void NetworkConnection::setAsyncWritesEnabled(bool on)
 
 void NetworkConnection::sendPacket(const std::vector<std::byte> & message)
 {
-	std::lock_guard lock(writeMutex);
-	std::vector<std::byte> headerVector(sizeof(uint32_t));
-	uint32_t messageSize = message.size();
-	std::memcpy(headerVector.data(), &messageSize, sizeof(uint32_t));
-
 	// At the moment, vcmilobby *requires* async writes in order to handle multiple connections with different speeds and at optimal performance
 	// However server (and potentially - client) can not handle this mode and may shutdown either socket or entire asio service too early, before all writes are performed
 	if (asyncWritesEnabled)
+		sendBuffer(std::make_shared<const std::vector<std::byte>>(message));
+	else
+		writeSynchronously(message);
+}
+
+void NetworkConnection::sendBuffer(const PacketBuffer & message)
+{
+	if (!asyncWritesEnabled)
 	{
+		writeSynchronously(*message);
+		return;
+	}
 
-		bool messageQueueEmpty = dataToSend.empty();
-		dataToSend.push_back(headerVector);
-		if (!message.empty())
-			dataToSend.push_back(message);
+	// packets may be sent from any thread, including strands of other connections when relaying
+	boost::asio::dispatch(strand, [self = shared_from_this(), message]()
+	{
+		bool messageQueueEmpty = self->dataToSend.empty();
+		self->dataToSend.push_back({static_cast<uint32_t>(message->size()), message});
 
 		if (messageQueueEmpty)
-			doSendData();
+			self->doSendData();
 		//else - data sending loop is still active and still sending previous messages
-	}
-	else
-	{
-		boost::system::error_code ec;
-		boost::asio::write(*socket, boost::asio::buffer(headerVector), ec );
-		if (!message.empty())
-			boost::asio::write(*socket, boost::asio::buffer(message), ec );
-	}
+	});
+}
+
+void NetworkConnection::writeSynchronously(const std::vector<std::byte> & message)
+{
+	std::lock_guard lock(writeMutex);
+	uint32_t messageSize = message.size();
+
+	boost::system::error_code ec;
+	boost::asio::write(*socket, boost::asio::buffer(&messageSize, sizeof(messageSize)), ec );
+	if (!message.empty())
+		boost::asio::write(*socket, boost::asio::buffer(message), ec );
 }
 
 void NetworkConnection::doSendData()
@@ -169,16 +222,24 @@ void NetworkConnection::doSendData()
 	if (dataToSend.empty())
 		throw std::runtime_error("Attempting to sent data but there is no data to send!");
 
-	boost::asio::async_write(*socket, boost::asio::buffer(dataToSend.front()), [self = shared_from_this()](const auto & error, const auto & )
+	const auto & packet = dataToSend.front();
+
+	// header and payload are sent in a single write, payload is not copied into send queue
+	std::array<boost::asio::const_buffer, 2> buffers = {
+		boost::asio::buffer(&packet.size, sizeof(packet.size)),
+		boost::asio::buffer(*packet.payload)
+	};
+
+	boost::asio::async_write(*socket, buffers, boost::asio::bind_executor(strand, [self = shared_from_this()](const auto & error, const auto & )
 	{
 		self->onDataSent(error);
-	});
+	}));
 }
 
 void NetworkConnection::onDataSent(const boost::system::error_code & ec)
 {
-	std::lock_guard lock(writeMutex);
 	dataToSend.pop_front();
+
 	if (ec)
 	{
 		onError(ec.message());
@@ -197,15 +258,18 @@ void NetworkConnection::onError(const std::string & message)
 
 void NetworkConnection::close()
 {
-	boost::system::error_code ec;
-	socket->close(ec);
+	boost::asio::dispatch(strand, [self = shared_from_this()]()
+	{
+		boost::system::error_code ec;
+		self->socket->close(ec);
 #if BOOST_VERSION >= 108700
-	timer->cancel();
+		self->timer->cancel();
 #else
-	timer->cancel(ec);
+		self->timer->cancel(ec);
 #endif
 
-	//NOTE: ignoring error code, intended
+		//NOTE: ignoring error code, intended
+	});
 }
 
 VCMI_LIB_NAMESPACE_END
@@ -18,11 +18,26 @@ class NetworkConnection final : public INetworkConnection, public std::enable_sh
 	static const int messageHeaderSize = sizeof(uint32_t);
 	static const int messageMaxSize = 64 * 1024 * 1024; // arbitrary size to prevent potential massive allocation if we receive garbage input
 
-	std::list<std::vector<std::byte>> dataToSend;
+	using PacketBuffer = std::shared_ptr<const std::vector<std::byte>>;
+
+	struct OutgoingPacket
+	{
+		uint32_t size;
+		PacketBuffer payload;
+	};
+
+	std::list<OutgoingPacket> dataToSend;
 	std::shared_ptr<NetworkSocket> socket;
 	std::shared_ptr<NetworkTimer> timer;
+	/// All operations on socket, timer and send queue are performed on this strand, so network context can be run by multiple threads
+	boost::asio::strand<NetworkContext::executor_type> strand;
+	/// Protects socket during synchronous writes, which are performed by caller thread
 	std::mutex writeMutex;
 
+	std::weak_ptr<NetworkConnection> relayTarget;
+	std::shared_ptr<NetworkRelayStatistics> relayStatistics;
+	std::mutex relayMutex;
+
 	NetworkBuffer readBuffer;
 	INetworkConnectionListener & listener;
 	bool asyncWritesEnabled = false;
@@ -34,9 +49,15 @@ class NetworkConnection final : public INetworkConnection, public std::enable_sh
 	void onHeaderReceived(const boost::system::error_code & ec);
 	void onPacketReceived(const boost::system::error_code & ec, uint32_t expectedPacketSize);
 
+	/// Queues packet for sending, packet data may be shared with other connections
+	void sendBuffer(const PacketBuffer & message);
+	void writeSynchronously(const std::vector<std::byte> & message);
 	void doSendData();
 	void onDataSent(const boost::system::error_code & ec);
 
+	/// Returns true if packet was forwarded to relay target
+	bool relayPacket(const PacketBuffer & message);
+
 public:
 	NetworkConnection(INetworkConnectionListener & listener, const std::shared_ptr<NetworkSocket> & socket, const std::shared_ptr<NetworkContext> & context);
 
@@ -44,6 +65,7 @@ public:
 	void close() override;
 	void sendPacket(const std::vector<std::byte> & message) override;
 	void setAsyncWritesEnabled(bool on) override;
+	void setRelayTarget(const std::shared_ptr<INetworkConnection> & target, const std::shared_ptr<NetworkRelayStatistics> & statistics) override;
 };
 
 VCMI_LIB_NAMESPACE_END
@@ -11,6 +11,13 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Counters of traffic that was relayed between connections, may be shared by multiple connections
+struct NetworkRelayStatistics
+{
+	std::atomic<uint64_t> packets = 0;
+	std::atomic<uint64_t> bytes = 0;
+};
+
 /// Base class for connections with other services, either incoming or outgoing
 class DLL_LINKAGE INetworkConnection : boost::noncopyable
 {
@@ -19,6 +26,10 @@ public:
 	virtual void sendPacket(const std::vector<std::byte> & message) = 0;
 	virtual void setAsyncWritesEnabled(bool on) = 0;
 	virtual void close() = 0;
+
+	/// Forwards all packets received from now on directly to target connection, without notifying listener and without copying packet data
+	/// Relaying stops once target connection is destroyed. Relayed traffic is added to statistics, if provided
+	virtual void setRelayTarget(const std::shared_ptr<INetworkConnection> & target, const std::shared_ptr<NetworkRelayStatistics> & statistics) = 0;
 };
 
 using NetworkConnectionPtr = std::shared_ptr<INetworkConnection>;
@@ -991,12 +991,14 @@ void FoWChange::applyGs(CGameState *gs)
 {
 	TeamState * team = gs->getPlayerTeam(player);
 	auto & fogOfWarMap = team->fogOfWarMap;
-	for(const int3 & t : tiles)
-		fogOfWarMap[t.z][t.x][t.y] = mode != ETileVisibility::HIDDEN;
+	if (mode == ETileVisibility::HIDDEN)
+		fogOfWarMap.hide(tiles);
+	else
+		fogOfWarMap.reveal(tiles);
 
 	if (mode == ETileVisibility::HIDDEN) //do not hide too much
 	{
-		std::unordered_set<int3> tilesRevealed;
+		TileSpanSet tilesRevealed;
 		for (auto & elem : gs->map->objects)
 		{
 			const CGObjectInstance *o = elem;
@@ -1014,8 +1016,7 @@ void FoWChange::applyGs(CGameState *gs)
 				}
 			}
 		}
-		for(const int3 & t : tilesRevealed) //probably not the most optimal solution ever
-			fogOfWarMap[t.z][t.x][t.y] = 1;
+		fogOfWarMap.reveal(tilesRevealed);
 	}
 }
 
@@ -1356,9 +1357,7 @@ void TryMoveHero::applyGs(CGameState *gs)
 		gs->map->addBlockVisTiles(h);
 	}
 
-	auto & fogOfWarMap = gs->getPlayerTeam(h->getOwner())->fogOfWarMap;
-	for(const int3 & t : fowRevealed)
-		fogOfWarMap[t.z][t.x][t.y] = 1;
+	gs->getPlayerTeam(h->getOwner())->fogOfWarMap.reveal(fowRevealed);
 }
 
 void NewStructures::applyGs(CGameState *gs)
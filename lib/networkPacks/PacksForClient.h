@@ -24,6 +24,7 @@
 #include "../gameState/RumorState.h"
 #include "../gameState/QuestInfo.h"
 #include "../gameState/TavernSlot.h"
+#include "../gameState/TileSpanSet.h"
 #include "../gameState/GameStatistics.h"
 #include "../int3.h"
 #include "../mapping/CMapDefines.h"
@@ -362,7 +363,7 @@ struct DLL_LINKAGE FoWChange : public CPackForClient
 {
 	void applyGs(CGameState * gs) override;
 
-	std::unordered_set<int3> tiles;
+	TileSpanSet tiles;
 	PlayerColor player;
 	ETileVisibility mode;
 	bool waitForDialogs = false;
@@ -645,7 +646,7 @@ struct DLL_LINKAGE TryMoveHero : public CPackForClient
 	EResult result = FAILED; //uses EResult
 	int3 start; //h3m format
 	int3 end;
-	std::unordered_set<int3> fowRevealed; //revealed tiles
+	TileSpanSet fowRevealed; //revealed tiles
 	std::optional<int3> attackedFrom; // Set when stepping into endangered tile.
 
 	void visitTyped(ICPackVisitor & visitor) override;
@@ -13,19 +13,20 @@
 #include "../mapObjects/CGObjectInstance.h"
 #include "../mapping/CMapDefines.h"
 #include "../gameState/CGameState.h"
+#include "../gameState/FogOfWarMap.h"
 #include "CGPathNode.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
 namespace PathfinderUtil
 {
-	using FoW = boost::multi_array<ui8, 3>;
+	using FoW = FogOfWarMap;
 	using ELayer = EPathfindingLayer;
 
 	template<EPathfindingLayer::Type layer>
 	EPathAccessibility evaluateAccessibility(const int3 & pos, const TerrainTile & tinfo, const FoW & fow, const PlayerColor player, const CGameState * gs)
 	{
-		if(!fow[pos.z][pos.x][pos.y])
+		if(!fow.isVisible(pos))
 			return EPathAccessibility::BLOCKED;
 
 		switch(layer)
@@ -75,15 +75,17 @@ void Rewardable::Interface::grantRewardBeforeLevelup(const Rewardable::VisitInfo
 			return score > 0;
 		};
 
-		std::unordered_set<int3> tiles;
+		TileSpanSet tiles;
 		if (props.radius > 0)
 		{
-			cb->getTilesInRange(tiles, hero->getSightCenter(), props.radius, ETileVisibility::HIDDEN, hero->getOwner());
+			TileSpanSet tilesInRange;
+			cb->getTilesInRange(tilesInRange, hero->getSightCenter(), props.radius, ETileVisibility::HIDDEN, hero->getOwner());
 			if (props.hide)
-				cb->getTilesInRange(tiles, hero->getSightCenter(), props.radius, ETileVisibility::REVEALED, hero->getOwner());
+				cb->getTilesInRange(tilesInRange, hero->getSightCenter(), props.radius, ETileVisibility::REVEALED, hero->getOwner());
 
-			vstd::erase_if(tiles, [&](const int3 & coord){
-				return !functor(cb->getTile(coord));
+			tilesInRange.forEachTile([&](const int3 & coord){
+				if (functor(cb->getTile(coord)))
+					tiles.insert(coord);
 			});
 		}
 		else
@@ -70,6 +70,7 @@ enum class ESerializationVersion : int32_t
 	REWARDABLE_GUARDS, // 871 - fix missing serialization of guards in rewardable objects
 	MARKET_TRANSLATION_FIX, // 872 - remove serialization of markets translateable strings
 	EVENT_OBJECTS_DELETION, //873 - allow events to remove map objects
-	
-	CURRENT = EVENT_OBJECTS_DELETION
+	BIT_PACKED_FOG_OF_WAR, // 874 - fog of war is stored as bitmask, fog of war changes are sent as tile spans
+
+	CURRENT = BIT_PACKED_FOG_OF_WAR
 };
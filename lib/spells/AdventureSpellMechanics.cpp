@@ -731,7 +731,7 @@ ESpellCastResult ViewMechanics::applyAdventureEffects(SpellCastEnvironment * env
 		{
 			ObjectPosInfo posInfo(obj);
 
-			if(fowMap[posInfo.pos.z][posInfo.pos.x][posInfo.pos.y] == 0)
+			if(!fowMap.isVisible(posInfo.pos))
 				pack.objectPositions.push_back(posInfo);
 		}
 	}
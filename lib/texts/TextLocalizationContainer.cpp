@@ -22,12 +22,17 @@ VCMI_LIB_NAMESPACE_BEGIN
 
 std::recursive_mutex TextLocalizationContainer::globalTextMutex;
 
+/// Number of replaced snapshots that are kept alive after replacement
+static constexpr size_t RETIRED_SNAPSHOTS_LIMIT = 4;
+
 void TextLocalizationContainer::registerStringOverride(const std::string & modContext, const TextIdentifier & UID, const std::string & localized, const std::string & language)
 {
 	std::lock_guard globalLock(globalTextMutex);
 
 	assert(!modContext.empty());
 
+	invalidateSnapshot(UID);
+
 	// NOTE: implicitly creates entry, intended - strings added by maps, campaigns, vcmi and potentially - UI mods are not registered anywhere at the moment
 	auto & entry = stringsLocalizations[UID.get()];
 
@@ -71,8 +76,64 @@ void TextLocalizationContainer::removeSubContainer(const TextLocalizationContain
 	subContainers.erase(std::remove(subContainers.begin(), subContainers.end(), &container), subContainers.end());
 }
 
+void TextLocalizationContainer::createTranslationSnapshot()
+{
+	std::lock_guard globalLock(globalTextMutex);
+
+	snapshotEnabled = true;
+
+	auto newSnapshot = std::make_shared<TranslationSnapshot>();
+	newSnapshot->reserve(stringsLocalizations.size());
+	for(const auto & entry : stringsLocalizations)
+		newSnapshot->emplace(entry.first, entry.second.translatedText);
+
+	replaceSnapshot(newSnapshot);
+}
+
+void TextLocalizationContainer::replaceSnapshot(std::shared_ptr<const TranslationSnapshot> newSnapshot)
+{
+	std::lock_guard globalLock(globalTextMutex);
+
+	auto oldSnapshot = std::atomic_exchange(&snapshot, newSnapshot);
+	if (!oldSnapshot)
+		return;
+
+	retiredSnapshots.push_back(oldSnapshot);
+
+	// readers that are still searching in oldest snapshots hold their own reference to it
+	while (retiredSnapshots.size() > RETIRED_SNAPSHOTS_LIMIT && retiredSnapshots.front().use_count() == 1)
+		retiredSnapshots.pop_front();
+}
+
+void TextLocalizationContainer::invalidateSnapshot(const TextIdentifier & UID)
+{
+	std::lock_guard globalLock(globalTextMutex);
+
+	// new strings are not part of snapshot and will be looked up under lock until snapshot is updated
+	auto currentSnapshot = std::atomic_load(&snapshot);
+	if (currentSnapshot && currentSnapshot->count(UID.get()))
+		replaceSnapshot(nullptr);
+}
+
+void TextLocalizationContainer::updateSnapshot()
+{
+	std::lock_guard globalLock(globalTextMutex);
+
+	if (snapshotEnabled)
+		createTranslationSnapshot();
+}
+
 const std::string & TextLocalizationContainer::translateString(const TextIdentifier & identifier) const
 {
+	// fast path - string registered before snapshot was created
+	auto currentSnapshot = std::atomic_load(&snapshot);
+	if(currentSnapshot)
+	{
+		auto it = currentSnapshot->find(identifier.get());
+		if(it != currentSnapshot->end())
+			return it->second;
+	}
+
 	std::lock_guard globalLock(globalTextMutex);
 
 	if(stringsLocalizations.count(identifier.get()) == 0)
@@ -114,6 +175,8 @@ void TextLocalizationContainer::registerString(const std::string & identifierMod
 	assert(UID.get().find("..") == std::string::npos); // invalid identifier - there is section that was evaluated to empty string
 	assert(stringsLocalizations.count(UID.get()) == 0 || boost::algorithm::starts_with(UID.get(), "map") || boost::algorithm::starts_with(UID.get(), "header")); // registering already registered string? FIXME: "header" is a workaround. VMAP needs proper integration in translation system
 
+	invalidateSnapshot(UID);
+
 	if(stringsLocalizations.count(UID.get()) > 0)
 	{
 		auto & value = stringsLocalizations[UID.get()];
@@ -134,8 +197,12 @@ void TextLocalizationContainer::registerString(const std::string & identifierMod
 
 void TextLocalizationContainer::loadTranslationOverrides(const std::string & modContext, const std::string & language, const JsonNode & config)
 {
+	std::lock_guard globalLock(globalTextMutex);
+
 	for(const auto & node : config.Struct())
 		registerStringOverride(modContext, node.first, node.second.String(), language);
+
+	updateSnapshot();
 }
 
 bool TextLocalizationContainer::identifierExists(const TextIdentifier & UID) const
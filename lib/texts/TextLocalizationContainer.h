@@ -48,6 +48,27 @@ protected:
 
 	std::vector<const TextLocalizationContainer *> subContainers;
 
+	/// Immutable copy of translated strings that can be read without locking
+	using TranslationSnapshot = std::unordered_map<std::string, std::string>;
+
+	/// Current snapshot, accessed via std::atomic_load/atomic_store. Reset once any string stored in it is modified,
+	/// and created again after batch of modifications is over
+	std::shared_ptr<const TranslationSnapshot> snapshot;
+
+	/// Most recently replaced snapshots. Kept alive since callers may still hold references to their strings
+	std::deque<std::shared_ptr<const TranslationSnapshot>> retiredSnapshots;
+
+	/// True once createTranslationSnapshot was called. Containers without it never create snapshots
+	bool snapshotEnabled = false;
+
+	void replaceSnapshot(std::shared_ptr<const TranslationSnapshot> newSnapshot);
+
+	/// Discards current snapshot if it contains provided string, so modified string is not read from it
+	void invalidateSnapshot(const TextIdentifier & UID);
+
+	/// Creates new snapshot after batch of modifications, if this container uses snapshots
+	void updateSnapshot();
+
 	/// add selected string to internal storage as high-priority strings
 	void registerStringOverride(const std::string & modContext, const TextIdentifier & UID, const std::string & localized, const std::string & language);
 
@@ -77,6 +98,10 @@ public:
 	/// converts identifier into user-readable string
 	const std::string & translateString(const TextIdentifier & identifier) const;
 
+	/// Creates snapshot of all currently registered strings, so following lookups of these strings do not need to lock
+	/// Should be called once loading is over. Snapshot is recreated after every following batch of modifications
+	void createTranslationSnapshot();
+
 	/// Debug method, returns all currently stored texts
 	/// Format: [mod ID][string ID] -> human-readable text
 	void exportAllTexts(std::map<std::string, std::map<std::string, std::string>> & storage, bool onlyMissing) const;
@@ -94,6 +119,9 @@ public:
 	{
 		std::lock_guard globalLock(globalTextMutex);
 
+		if (!h.saving)
+			replaceSnapshot(nullptr);
+
 		if (h.version >= Handler::Version::SIMPLE_TEXT_CONTAINER_SERIALIZATION)
 		{
 			h & stringsLocalizations;
@@ -132,6 +160,9 @@ public:
 				}
 			}
 		}
+
+		if (!h.saving)
+			updateSnapshot();
 	}
 };
 
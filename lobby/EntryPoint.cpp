@@ -44,7 +44,8 @@ int main(int argc, const char * argv[])
 		logGlobal->error("Failed to start server! Another server already uses the same port? Reason: '%s'", e.what());
 		return 1;
 	}
-	server.run();
+	// at least two threads, so relayed game traffic is not blocked by processing of lobby messages
+	server.run(std::max(2u, boost::thread::hardware_concurrency()));
 
 	return 0;
 }
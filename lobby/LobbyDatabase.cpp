@@ -12,6 +12,32 @@
 
 #include "SQLiteConnection.h"
 
+#include "../lib/CThreadHelper.h"
+
+/// Maximal interval between commits of database modifications
+static constexpr auto COMMIT_INTERVAL = std::chrono::milliseconds(500);
+/// Number of modifications after which commit will be performed without waiting for interval to pass
+static constexpr size_t COMMIT_BATCH_SIZE = 256;
+/// Interval between checkpoints that move committed modifications from write-ahead log into database file
+static constexpr auto CHECKPOINT_INTERVAL = std::chrono::seconds(30);
+
+/// Limits of recent chat history that is sent to players on login, must match getRecentMessageHistoryStatement
+static constexpr size_t RECENT_CHAT_MESSAGES_LIMIT = 100;
+static constexpr size_t RECENT_CHAT_CHANNELS_LIMIT = 256;
+static constexpr auto RECENT_CHAT_MESSAGES_AGE = std::chrono::hours(18);
+
+void LobbyDatabase::configureDatabase()
+{
+	// Write-ahead log allows commits without waiting for fsync of the database file
+	// With WAL, fsync is only done on checkpoint, and database remains consistent on power loss
+	database->prepare("PRAGMA journal_mode = WAL")->execute();
+	database->prepare("PRAGMA synchronous = NORMAL")->execute();
+	database->prepare("PRAGMA temp_store = MEMORY")->execute();
+	database->prepare("PRAGMA cache_size = -16384")->execute(); // 16 Mb
+	// checkpoints are done by commit thread, so they never block lobby thread
+	database->prepare("PRAGMA wal_autocheckpoint = 0")->execute();
+}
+
 void LobbyDatabase::createTables()
 {
 	static const std::string createChatMessages = R"(
@@ -81,6 +107,23 @@ void LobbyDatabase::createTables()
 	database->prepare(createTableGameRoomInvites)->execute();
 }
 
+void LobbyDatabase::createIndices()
+{
+	static const std::string createIndices[] = {
+		"CREATE INDEX IF NOT EXISTS chatMessagesChannel ON chatMessages (channelType, channelName, creationTime)",
+		"CREATE INDEX IF NOT EXISTS gameRoomsRoomID ON gameRooms (roomID)",
+		"CREATE INDEX IF NOT EXISTS gameRoomsStatus ON gameRooms (status)",
+		"CREATE INDEX IF NOT EXISTS gameRoomPlayersRoomID ON gameRoomPlayers (roomID)",
+		"CREATE INDEX IF NOT EXISTS gameRoomPlayersAccountID ON gameRoomPlayers (accountID)",
+		"CREATE INDEX IF NOT EXISTS gameRoomInvitesRoomID ON gameRoomInvites (roomID)",
+		"CREATE INDEX IF NOT EXISTS accountsAccountID ON accounts (accountID)",
+		"CREATE INDEX IF NOT EXISTS accountCookiesAccountID ON accountCookies (accountID)",
+	};
+
+	for(const auto & statement : createIndices)
+		database->prepare(statement)->execute();
+}
+
 void LobbyDatabase::upgradeDatabase()
 {
 	auto getDatabaseVersionStatement = database->prepare(R"(
@@ -139,6 +182,14 @@ void LobbyDatabase::clearOldData()
 
 void LobbyDatabase::prepareStatements()
 {
+	beginTransactionStatement = database->prepare(R"(
+		BEGIN TRANSACTION
+	)");
+
+	commitTransactionStatement = database->prepare(R"(
+		COMMIT TRANSACTION
+	)");
+
 	// INSERT INTO
 
 	insertChatMessageStatement = database->prepare(R"(
@@ -272,6 +323,13 @@ void LobbyDatabase::prepareStatements()
 		ORDER BY secondsElapsed ASC
 	)");
 
+	getGameRoomStatement = database->prepare(R"(
+		SELECT roomID, hostAccountID, displayName, description, status, playerLimit, version, mods, strftime('%s',CURRENT_TIMESTAMP)- strftime('%s',gr.creationTime)  AS secondsElapsed
+		FROM gameRooms gr
+		LEFT JOIN accounts a ON gr.hostAccountID = a.accountID
+		WHERE roomID = ?
+	)");
+
 	getGameRoomInvitesStatement = database->prepare(R"(
 		SELECT a.accountID, a.displayName
 		FROM gameRoomInvites gri
@@ -337,24 +395,141 @@ void LobbyDatabase::prepareStatements()
 	)");
 }
 
-LobbyDatabase::~LobbyDatabase() = default;
+LobbyDatabase::~LobbyDatabase()
+{
+	{
+		std::lock_guard lock(databaseMutex);
+		commitThreadStopRequested = true;
+	}
+	commitCondition.notify_one();
+	commitThread.join();
+}
 
 LobbyDatabase::LobbyDatabase(const boost::filesystem::path & databasePath)
 {
 	database = SQLiteInstance::open(databasePath, true);
+	configureDatabase();
 	createTables();
+	createIndices();
 	upgradeDatabase();
 	clearOldData();
 	prepareStatements();
+
+	commitThread = boost::thread([this, databasePath](){ runCommitThread(databasePath); });
+}
+
+void LobbyDatabase::runCommitThread(const boost::filesystem::path & databasePath)
+{
+	setThreadName("lobbyDatabase");
+
+	// separate connection, so checkpoint can run in parallel with lobby
+	auto checkpointDatabase = SQLiteInstance::open(databasePath, true);
+	auto checkpointStatement = checkpointDatabase->prepare("PRAGMA wal_checkpoint(PASSIVE)");
+	auto lastCheckpoint = std::chrono::steady_clock::now();
+
+	std::unique_lock lock(databaseMutex);
+
+	while(!commitThreadStopRequested)
+	{
+		commitCondition.wait_for(lock, COMMIT_INTERVAL, [this]()
+		{
+			return commitThreadStopRequested || uncommittedWrites >= COMMIT_BATCH_SIZE;
+		});
+
+		try
+		{
+			commitTransaction();
+		}
+		catch(const std::runtime_error & e)
+		{
+			logGlobal->warn("Failed to commit lobby database changes, will retry: %s", e.what());
+		}
+
+		if(std::chrono::steady_clock::now() - lastCheckpoint < CHECKPOINT_INTERVAL)
+			continue;
+
+		lock.unlock();
+		try
+		{
+			checkpointStatement->execute();
+			checkpointStatement->reset();
+		}
+		catch(const std::runtime_error & e)
+		{
+			logGlobal->warn("Failed to checkpoint lobby database: %s", e.what());
+		}
+		lock.lock();
+		lastCheckpoint = std::chrono::steady_clock::now();
+	}
+}
+
+void LobbyDatabase::beginWrite()
+{
+	if(!transactionActive)
+	{
+		beginTransactionStatement->execute();
+		beginTransactionStatement->reset();
+		transactionActive = true;
+	}
+
+	uncommittedWrites++;
+	if(uncommittedWrites == COMMIT_BATCH_SIZE)
+		commitCondition.notify_one();
+}
+
+void LobbyDatabase::commitTransaction()
+{
+	if(!transactionActive)
+		return;
+
+	try
+	{
+		commitTransactionStatement->execute();
+		commitTransactionStatement->reset();
+	}
+	catch(const std::runtime_error & e)
+	{
+		// statement reports error of failed step again on reset
+		try
+		{
+			commitTransactionStatement->reset();
+		}
+		catch(const std::runtime_error &)
+		{
+		}
+
+		// on some errors, e.g. if database is busy, transaction remains active and commit can be retried later
+		if(database->isInTransaction())
+			throw;
+
+		// otherwise sqlite has rolled back all pending writes, including already confirmed accounts and logins
+		logGlobal->error("Lobby database has rolled back %d changes: %s", uncommittedWrites, e.what());
+		std::terminate();
+	}
+
+	transactionActive = false;
+	uncommittedWrites = 0;
 }
 
 void LobbyDatabase::insertChatMessage(const std::string & sender, const std::string & channelType, const std::string & channelName, const std::string & messageText)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	insertChatMessageStatement->executeOnce(sender, messageText, channelType, channelName);
+
+	auto cachedChannel = recentChatMessages.find({channelType, channelName});
+	if(cachedChannel != recentChatMessages.end())
+	{
+		auto & cachedMessages = cachedChannel->second.messages;
+		cachedMessages.push_front({sender, getAccountDisplayName(sender), messageText, std::chrono::steady_clock::now()});
+		if(cachedMessages.size() > RECENT_CHAT_MESSAGES_LIMIT)
+			cachedMessages.pop_back();
+	}
 }
 
 bool LobbyDatabase::isPlayerInGameRoom(const std::string & accountID)
 {
+	std::lock_guard lock(databaseMutex);
 	bool result = false;
 
 	isPlayerInAnyGameRoomStatement->setBinds(accountID);
@@ -367,6 +542,7 @@ bool LobbyDatabase::isPlayerInGameRoom(const std::string & accountID)
 
 bool LobbyDatabase::isPlayerInGameRoom(const std::string & accountID, const std::string & roomID)
 {
+	std::lock_guard lock(databaseMutex);
 	bool result = false;
 
 	isPlayerInGameRoomStatement->setBinds(accountID, roomID);
@@ -379,22 +555,54 @@ bool LobbyDatabase::isPlayerInGameRoom(const std::string & accountID, const std:
 
 std::vector<LobbyChatMessage> LobbyDatabase::getRecentMessageHistory(const std::string & channelType, const std::string & channelName)
 {
+	std::lock_guard lock(databaseMutex);
+	auto currentTime = std::chrono::steady_clock::now();
+	auto channelKey = std::make_pair(channelType, channelName);
+
+	// load channel from database on first request, all further messages will be added on insertion
+	if(!recentChatMessages.count(channelKey))
+	{
+		if(recentChatMessages.size() >= RECENT_CHAT_CHANNELS_LIMIT)
+		{
+			auto leastRecentlyUsed = std::min_element(recentChatMessages.begin(), recentChatMessages.end(), [](const auto & left, const auto & right)
+			{
+				return left.second.lastAccess < right.second.lastAccess;
+			});
+			recentChatMessages.erase(leastRecentlyUsed);
+		}
+
+		auto & cachedMessages = recentChatMessages[channelKey].messages;
+
+		getRecentMessageHistoryStatement->setBinds(channelType, channelName);
+		while(getRecentMessageHistoryStatement->execute())
+		{
+			LobbyChatMessage message;
+			getRecentMessageHistoryStatement->getColumns(message.accountID, message.displayName, message.messageText, message.age);
+			cachedMessages.push_back({message.accountID, message.displayName, message.messageText, currentTime - message.age});
+		}
+		getRecentMessageHistoryStatement->reset();
+	}
+
+	auto & cachedChannel = recentChatMessages.at(channelKey);
+	cachedChannel.lastAccess = currentTime;
+
 	std::vector<LobbyChatMessage> result;
 
-	getRecentMessageHistoryStatement->setBinds(channelType, channelName);
-	while(getRecentMessageHistoryStatement->execute())
+	for(const auto & cachedMessage : cachedChannel.messages)
 	{
-		LobbyChatMessage message;
-		getRecentMessageHistoryStatement->getColumns(message.accountID, message.displayName, message.messageText, message.age);
-		result.push_back(message);
+		auto age = std::chrono::duration_cast<std::chrono::seconds>(currentTime - cachedMessage.creationTime);
+		if(age >= RECENT_CHAT_MESSAGES_AGE)
+			break;
+
+		result.push_back({cachedMessage.accountID, cachedMessage.displayName, cachedMessage.messageText, age});
 	}
-	getRecentMessageHistoryStatement->reset();
 
 	return result;
 }
 
 std::vector<LobbyChatMessage> LobbyDatabase::getFullMessageHistory(const std::string & channelType, const std::string & channelName)
 {
+	std::lock_guard lock(databaseMutex);
 	std::vector<LobbyChatMessage> result;
 
 	getFullMessageHistoryStatement->setBinds(channelType, channelName);
@@ -411,66 +619,97 @@ std::vector<LobbyChatMessage> LobbyDatabase::getFullMessageHistory(const std::st
 
 void LobbyDatabase::setAccountOnline(const std::string & accountID, bool isOnline)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	setAccountOnlineStatement->executeOnce(isOnline ? 1 : 0, accountID);
 }
 
 void LobbyDatabase::setGameRoomStatus(const std::string & roomID, LobbyRoomState roomStatus)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	setGameRoomStatusStatement->executeOnce(vstd::to_underlying(roomStatus), roomID);
 }
 
 void LobbyDatabase::insertPlayerIntoGameRoom(const std::string & accountID, const std::string & roomID)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	insertGameRoomPlayersStatement->executeOnce(roomID, accountID);
 }
 
 void LobbyDatabase::deletePlayerFromGameRoom(const std::string & accountID, const std::string & roomID)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	deleteGameRoomPlayersStatement->executeOnce(roomID, accountID);
 }
 
 void LobbyDatabase::deleteGameRoomInvite(const std::string & targetAccountID, const std::string & roomID)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	deleteGameRoomInvitesStatement->executeOnce(roomID, targetAccountID);
 }
 
 void LobbyDatabase::insertGameRoomInvite(const std::string & targetAccountID, const std::string & roomID)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	insertGameRoomInvitesStatement->executeOnce(roomID, targetAccountID);
 }
 
 void LobbyDatabase::insertGameRoom(const std::string & roomID, const std::string & hostAccountID, const std::string & serverVersion, const std::string & modListJson)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	insertGameRoomStatement->executeOnce(roomID, hostAccountID, serverVersion, modListJson);
 }
 
 void LobbyDatabase::insertAccount(const std::string & accountID, const std::string & displayName)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	insertAccountStatement->executeOnce(accountID, displayName);
+
+	// credentials are sent to client right after this call and must not be lost
+	commitTransaction();
 }
 
 void LobbyDatabase::insertAccessCookie(const std::string & accountID, const std::string & accessCookieUUID)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	insertAccessCookieStatement->executeOnce(accountID, accessCookieUUID);
+
+	// credentials are sent to client right after this call and must not be lost
+	commitTransaction();
 }
 
 void LobbyDatabase::updateAccountLoginTime(const std::string & accountID)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	updateAccountLoginTimeStatement->executeOnce(accountID);
 }
 
 void LobbyDatabase::updateRoomPlayerLimit(const std::string & gameRoomID, int playerLimit)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	updateRoomPlayerLimitStatement->executeOnce(playerLimit, gameRoomID);
 }
 
 void LobbyDatabase::updateRoomDescription(const std::string & gameRoomID, const std::string & description)
 {
+	std::lock_guard lock(databaseMutex);
+	beginWrite();
 	updateRoomDescriptionStatement->executeOnce(description, gameRoomID);
 }
 
 std::string LobbyDatabase::getAccountDisplayName(const std::string & accountID)
 {
+	std::lock_guard lock(databaseMutex);
 	std::string result;
 
 	getAccountDisplayNameStatement->setBinds(accountID);
@@ -483,6 +722,7 @@ std::string LobbyDatabase::getAccountDisplayName(const std::string & accountID)
 
 LobbyCookieStatus LobbyDatabase::getAccountCookieStatus(const std::string & accountID, const std::string & accessCookieUUID)
 {
+	std::lock_guard lock(databaseMutex);
 	bool result = false;
 
 	isAccountCookieValidStatement->setBinds(accountID, accessCookieUUID);
@@ -495,6 +735,7 @@ LobbyCookieStatus LobbyDatabase::getAccountCookieStatus(const std::string & acco
 
 LobbyInviteStatus LobbyDatabase::getAccountInviteStatus(const std::string & accountID, const std::string & roomID)
 {
+	std::lock_guard lock(databaseMutex);
 	int result = 0;
 
 	getAccountInviteStatusStatement->setBinds(accountID, roomID);
@@ -510,6 +751,7 @@ LobbyInviteStatus LobbyDatabase::getAccountInviteStatus(const std::string & acco
 
 LobbyRoomState LobbyDatabase::getGameRoomStatus(const std::string & roomID)
 {
+	std::lock_guard lock(databaseMutex);
 	LobbyRoomState result;
 
 	getGameRoomStatusStatement->setBinds(roomID);
@@ -524,6 +766,7 @@ LobbyRoomState LobbyDatabase::getGameRoomStatus(const std::string & roomID)
 
 uint32_t LobbyDatabase::getGameRoomFreeSlots(const std::string & roomID)
 {
+	std::lock_guard lock(databaseMutex);
 	uint32_t usedSlots = 0;
 	uint32_t totalSlots = 0;
 
@@ -545,6 +788,7 @@ uint32_t LobbyDatabase::getGameRoomFreeSlots(const std::string & roomID)
 
 bool LobbyDatabase::isAccountNameExists(const std::string & displayName)
 {
+	std::lock_guard lock(databaseMutex);
 	bool result = false;
 
 	isAccountNameExistsStatement->setBinds(displayName);
@@ -556,6 +800,7 @@ bool LobbyDatabase::isAccountNameExists(const std::string & displayName)
 
 bool LobbyDatabase::isAccountIDExists(const std::string & accountID)
 {
+	std::lock_guard lock(databaseMutex);
 	bool result = false;
 
 	isAccountIDExistsStatement->setBinds(accountID);
@@ -567,6 +812,7 @@ bool LobbyDatabase::isAccountIDExists(const std::string & accountID)
 
 std::vector<LobbyGameRoom> LobbyDatabase::getActiveGameRooms()
 {
+	std::lock_guard lock(databaseMutex);
 	std::vector<LobbyGameRoom> result;
 
 	while(getActiveGameRoomsStatement->execute())
@@ -578,34 +824,53 @@ std::vector<LobbyGameRoom> LobbyDatabase::getActiveGameRooms()
 	getActiveGameRoomsStatement->reset();
 
 	for (auto & room : result)
+		loadGameRoomAccounts(room);
+
+	return result;
+}
+
+std::optional<LobbyGameRoom> LobbyDatabase::getGameRoom(const std::string & roomID)
+{
+	std::lock_guard lock(databaseMutex);
+	LobbyGameRoom result;
+
+	getGameRoomStatement->setBinds(roomID);
+	bool found = getGameRoomStatement->execute();
+	if(found)
+		getGameRoomStatement->getColumns(result.roomID, result.hostAccountID, result.hostAccountDisplayName, result.description, result.roomState, result.playerLimit, result.version, result.modsJson, result.age);
+	getGameRoomStatement->reset();
+
+	if(!found)
+		return std::nullopt;
+
+	loadGameRoomAccounts(result);
+	return result;
+}
+
+void LobbyDatabase::loadGameRoomAccounts(LobbyGameRoom & room)
+{
+	getGameRoomPlayersStatement->setBinds(room.roomID);
+	while(getGameRoomPlayersStatement->execute())
 	{
-		getGameRoomPlayersStatement->setBinds(room.roomID);
-		while(getGameRoomPlayersStatement->execute())
-		{
-			LobbyAccount account;
-			getGameRoomPlayersStatement->getColumns(account.accountID, account.displayName);
-			room.participants.push_back(account);
-		}
-		getGameRoomPlayersStatement->reset();
+		LobbyAccount account;
+		getGameRoomPlayersStatement->getColumns(account.accountID, account.displayName);
+		room.participants.push_back(account);
 	}
+	getGameRoomPlayersStatement->reset();
 
-	for (auto & room : result)
+	getGameRoomInvitesStatement->setBinds(room.roomID);
+	while(getGameRoomInvitesStatement->execute())
 	{
-		getGameRoomInvitesStatement->setBinds(room.roomID);
-		while(getGameRoomInvitesStatement->execute())
-		{
-			LobbyAccount account;
-			getGameRoomInvitesStatement->getColumns(account.accountID, account.displayName);
-			room.invited.push_back(account);
-		}
-		getGameRoomInvitesStatement->reset();
+		LobbyAccount account;
+		getGameRoomInvitesStatement->getColumns(account.accountID, account.displayName);
+		room.invited.push_back(account);
 	}
-
-	return result;
+	getGameRoomInvitesStatement->reset();
 }
 
 std::vector<LobbyGameRoom> LobbyDatabase::getAccountGameHistory(const std::string & accountID)
 {
+	std::lock_guard lock(databaseMutex);
 	std::vector<LobbyGameRoom> result;
 
 	getAccountGameHistoryStatement->setBinds(accountID);
@@ -633,6 +898,7 @@ std::vector<LobbyGameRoom> LobbyDatabase::getAccountGameHistory(const std::strin
 
 std::vector<LobbyAccount> LobbyDatabase::getActiveAccounts()
 {
+	std::lock_guard lock(databaseMutex);
 	std::vector<LobbyAccount> result;
 
 	while(getActiveAccountsStatement->execute())
@@ -647,6 +913,7 @@ std::vector<LobbyAccount> LobbyDatabase::getActiveAccounts()
 
 std::string LobbyDatabase::getIdleGameRoom(const std::string & hostAccountID)
 {
+	std::lock_guard lock(databaseMutex);
 	std::string result;
 
 	getIdleGameRoomStatement->setBinds(hostAccountID);
@@ -659,6 +926,7 @@ std::string LobbyDatabase::getIdleGameRoom(const std::string & hostAccountID)
 
 std::string LobbyDatabase::getAccountGameRoom(const std::string & accountID)
 {
+	std::lock_guard lock(databaseMutex);
 	std::string result;
 
 	getAccountGameRoomStatement->setBinds(accountID);
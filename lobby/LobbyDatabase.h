@@ -11,6 +11,8 @@
 
 #include "LobbyDefines.h"
 
+#include <condition_variable>
+
 class SQLiteInstance;
 class SQLiteStatement;
 
@@ -19,8 +21,42 @@ using SQLiteStatementPtr = std::unique_ptr<SQLiteStatement>;
 
 class LobbyDatabase
 {
+	struct RecentChatMessage
+	{
+		std::string accountID;
+		std::string displayName;
+		std::string messageText;
+		std::chrono::steady_clock::time_point creationTime;
+	};
+
 	SQLiteInstancePtr database;
 
+	/// Database is accessed by lobby and by commit thread
+	std::recursive_mutex databaseMutex;
+	std::condition_variable_any commitCondition;
+	boost::thread commitThread;
+	bool commitThreadStopRequested = false;
+
+	/// All writes are grouped into a single transaction that is periodically committed by commit thread
+	/// Since lobby uses same connection for reading, all uncommitted changes are still visible to lobby
+	/// Commits only append to write-ahead log, checkpoints are done by commit thread without locking database
+	bool transactionActive = false;
+	size_t uncommittedWrites = 0;
+
+	struct RecentChatChannel
+	{
+		/// Newest messages first
+		std::deque<RecentChatMessage> messages;
+		std::chrono::steady_clock::time_point lastAccess;
+	};
+
+	/// Most recent messages of channels that were requested recently, least recently requested channels are evicted
+	/// Key: channel type and channel name
+	std::map<std::pair<std::string, std::string>, RecentChatChannel> recentChatMessages;
+
+	SQLiteStatementPtr beginTransactionStatement;
+	SQLiteStatementPtr commitTransactionStatement;
+
 	SQLiteStatementPtr insertChatMessageStatement;
 	SQLiteStatementPtr insertAccountStatement;
 	SQLiteStatementPtr insertAccessCookieStatement;
@@ -43,6 +79,7 @@ class LobbyDatabase
 	SQLiteStatementPtr getGameRoomStatusStatement;
 	SQLiteStatementPtr getAccountGameHistoryStatement;
 	SQLiteStatementPtr getActiveGameRoomsStatement;
+	SQLiteStatementPtr getGameRoomStatement;
 	SQLiteStatementPtr getActiveAccountsStatement;
 	SQLiteStatementPtr getAccountInviteStatusStatement;
 	SQLiteStatementPtr getAccountGameRoomStatement;
@@ -60,10 +97,21 @@ class LobbyDatabase
 	SQLiteStatementPtr isAccountNameExistsStatement;
 
 	void prepareStatements();
+	void configureDatabase();
 	void createTables();
+	void createIndices();
 	void upgradeDatabase();
 	void clearOldData();
 
+	/// Must be called before any modification of database
+	void beginWrite();
+	/// Commits all pending writes. Throws if commit has failed, in which case pending writes are kept for next attempt
+	void commitTransaction();
+	void runCommitThread(const boost::filesystem::path & databasePath);
+
+	/// Loads lists of participants and invited accounts of a game room
+	void loadGameRoomAccounts(LobbyGameRoom & room);
+
 public:
 	explicit LobbyDatabase(const boost::filesystem::path & databasePath);
 	~LobbyDatabase();
@@ -88,6 +136,7 @@ public:
 
 	std::vector<LobbyGameRoom> getAccountGameHistory(const std::string & accountID);
 	std::vector<LobbyGameRoom> getActiveGameRooms();
+	std::optional<LobbyGameRoom> getGameRoom(const std::string & roomID);
 	std::vector<LobbyAccount> getActiveAccounts();
 	std::vector<LobbyChatMessage> getRecentMessageHistory(const std::string & channelType, const std::string & channelName);
 	std::vector<LobbyChatMessage> getFullMessageHistory(const std::string & channelType, const std::string & channelName);
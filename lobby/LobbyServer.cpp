@@ -163,25 +163,71 @@ void LobbyServer::sendChatHistory(const NetworkConnectionPtr & target, const std
 	sendMessage(target, reply);
 }
 
-void LobbyServer::broadcastActiveAccounts()
+void LobbyServer::broadcastMessage(const JsonNode & json, bool incrementalUpdates)
 {
-	auto activeAccountsStats = database->getActiveAccounts();
+	assert(JsonUtils::validate(json, "vcmi:lobbyProtocol/" + json["type"].String(), json["type"].String() + " pack"));
+
+	std::vector<std::byte> message;
+	size_t receivers = 0;
+
+	for(const auto & connection : activeAccounts)
+	{
+		if(incrementalUpdateAccounts.count(connection.first) != static_cast<size_t>(incrementalUpdates))
+			continue;
+
+		// serialize only once for all receivers
+		if(message.empty())
+			message = json.toBytes();
+
+		connection.first->sendPacket(message);
+		receivers++;
+	}
+
+	if(receivers != 0)
+		logGlobal->info("Broadcasting message of type %s to %d accounts", json["type"].String(), receivers);
+}
+
+static JsonNode loadOnlineAccountToJson(const LobbyAccount & account)
+{
+	JsonNode jsonEntry;
+	jsonEntry["accountID"].String() = account.accountID;
+	jsonEntry["displayName"].String() = account.displayName;
+	jsonEntry["status"].String() = "In Lobby"; // TODO: in room status, in match status, offline status(?)
+	return jsonEntry;
+}
 
+JsonNode LobbyServer::prepareActiveAccounts() const
+{
 	JsonNode reply;
 	reply["type"].String() = "activeAccounts";
 	reply["accounts"].Vector(); // force creation of empty vector
 
-	for(const auto & account : activeAccountsStats)
-	{
-		JsonNode jsonEntry;
-		jsonEntry["accountID"].String() = account.accountID;
-		jsonEntry["displayName"].String() = account.displayName;
-		jsonEntry["status"].String() = "In Lobby"; // TODO: in room status, in match status, offline status(?)
-		reply["accounts"].Vector().push_back(jsonEntry);
-	}
+	for(const auto & account : onlineAccounts)
+		reply["accounts"].Vector().push_back(loadOnlineAccountToJson(account.second));
 
-	for(const auto & connection : activeAccounts)
-		sendMessage(connection.first, reply);
+	return reply;
+}
+
+void LobbyServer::broadcastAccountJoined(const LobbyAccount & account)
+{
+	JsonNode update;
+	update["type"].String() = "accountJoined";
+	update["account"] = loadOnlineAccountToJson(account);
+	broadcastMessage(update, true);
+
+	if(activeAccounts.size() != incrementalUpdateAccounts.size())
+		broadcastMessage(prepareActiveAccounts(), false);
+}
+
+void LobbyServer::broadcastAccountLeft(const std::string & accountID)
+{
+	JsonNode update;
+	update["type"].String() = "accountLeft";
+	update["accountID"].String() = accountID;
+	broadcastMessage(update, true);
+
+	if(activeAccounts.size() != incrementalUpdateAccounts.size())
+		broadcastMessage(prepareActiveAccounts(), false);
 }
 
 static JsonNode loadLobbyAccountToJson(const LobbyAccount & account)
@@ -239,25 +285,64 @@ void LobbyServer::sendMatchesHistory(const NetworkConnectionPtr & target)
 	sendMessage(target, reply);
 }
 
-JsonNode LobbyServer::prepareActiveGameRooms()
+JsonNode LobbyServer::prepareActiveGameRooms() const
 {
-	auto activeGameRoomStats = database->getActiveGameRooms();
+	auto currentTime = std::chrono::steady_clock::now();
+	std::vector<LobbyGameRoom> gameRooms;
+
+	for(const auto & entry : listedGameRooms)
+	{
+		LobbyGameRoom gameRoom = entry.second.room;
+		gameRoom.age += std::chrono::duration_cast<std::chrono::seconds>(currentTime - entry.second.loadTime);
+		gameRooms.push_back(gameRoom);
+	}
+
+	// newest rooms first, same as in database query
+	std::stable_sort(gameRooms.begin(), gameRooms.end(), [](const LobbyGameRoom & left, const LobbyGameRoom & right)
+	{
+		return left.age < right.age;
+	});
+
 	JsonNode reply;
 	reply["type"].String() = "activeGameRooms";
 	reply["gameRooms"].Vector(); // force creation of empty vector
 
-	for(const auto & gameRoom : activeGameRoomStats)
+	for(const auto & gameRoom : gameRooms)
 		reply["gameRooms"].Vector().push_back(loadLobbyGameRoomToJson(gameRoom));
 
 	return reply;
 }
 
-void LobbyServer::broadcastActiveGameRooms()
+void LobbyServer::broadcastGameRoomChanged(const std::string & gameRoomID)
 {
-	auto reply = prepareActiveGameRooms();
+	auto gameRoom = database->getGameRoom(gameRoomID);
 
-	for(const auto & connection : activeAccounts)
-		sendMessage(connection.first, reply);
+	bool isListed = gameRoom.has_value()
+		&& (gameRoom->roomState == LobbyRoomState::PUBLIC || gameRoom->roomState == LobbyRoomState::PRIVATE || gameRoom->roomState == LobbyRoomState::BUSY);
+
+	JsonNode update;
+
+	if(isListed)
+	{
+		listedGameRooms[gameRoomID] = { *gameRoom, std::chrono::steady_clock::now() };
+
+		update["type"].String() = "gameRoomChanged";
+		update["gameRoom"] = loadLobbyGameRoomToJson(*gameRoom);
+	}
+	else
+	{
+		// room was not visible to clients before and is still not visible - nothing to report
+		if(listedGameRooms.erase(gameRoomID) == 0)
+			return;
+
+		update["type"].String() = "gameRoomRemoved";
+		update["gameRoomID"].String() = gameRoomID;
+	}
+
+	broadcastMessage(update, true);
+
+	if(activeAccounts.size() != incrementalUpdateAccounts.size())
+		broadcastMessage(prepareActiveGameRooms(), false);
 }
 
 void LobbyServer::sendAccountJoinsRoom(const NetworkConnectionPtr & target, const std::string & accountID)
@@ -292,17 +377,29 @@ void LobbyServer::sendChatMessage(const NetworkConnectionPtr & target, const std
 
 void LobbyServer::onNewConnection(const NetworkConnectionPtr & connection)
 {
+	std::lock_guard lock(lobbyStateMutex);
 	connection->setAsyncWritesEnabled(true);
 	// no-op - waiting for incoming data
 }
 
 void LobbyServer::onDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage)
 {
+	std::lock_guard lock(lobbyStateMutex);
+
 	if(activeAccounts.count(connection))
 	{
-		logGlobal->info("Account %s disconnecting. Accounts online: %d", activeAccounts.at(connection), activeAccounts.size() - 1);
-		database->setAccountOnline(activeAccounts.at(connection), false);
+		std::string accountID = activeAccounts.at(connection);
+		logGlobal->info("Account %s disconnecting. Accounts online: %d", accountID, activeAccounts.size() - 1);
+		database->setAccountOnline(accountID, false);
 		activeAccounts.erase(connection);
+		incrementalUpdateAccounts.erase(connection);
+
+		// account might still be logged in using another connection
+		if(findAccount(accountID) == nullptr)
+		{
+			onlineAccounts.erase(accountID);
+			broadcastAccountLeft(accountID);
+		}
 	}
 
 	if(activeGameRooms.count(connection))
@@ -321,6 +418,14 @@ void LobbyServer::onDisconnected(const NetworkConnectionPtr & connection, const
 			database->setGameRoomStatus(gameRoomID, LobbyRoomState::CANCELLED);
 
 		activeGameRooms.erase(connection);
+		broadcastGameRoomChanged(gameRoomID);
+
+		if(proxyStatistics.count(gameRoomID))
+		{
+			const auto & statistics = proxyStatistics.at(gameRoomID);
+			logGlobal->info("Game room %s: %d packets (%d bytes) were relayed through proxy", gameRoomID, statistics->packets.load(), statistics->bytes.load());
+			proxyStatistics.erase(gameRoomID);
+		}
 	}
 
 	if(activeProxies.count(connection))
@@ -333,9 +438,6 @@ void LobbyServer::onDisconnected(const NetworkConnectionPtr & connection, const
 		activeProxies.erase(connection);
 		activeProxies.erase(otherConnection);
 	}
-
-	broadcastActiveAccounts();
-	broadcastActiveGameRooms();
 }
 
 JsonNode LobbyServer::parseAndValidateMessage(const std::vector<std::byte> & message) const
@@ -379,7 +481,10 @@ JsonNode LobbyServer::parseAndValidateMessage(const std::vector<std::byte> & mes
 
 void LobbyServer::onPacketReceived(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message)
 {
-	// proxy connection - no processing, only redirect
+	std::lock_guard lock(lobbyStateMutex);
+
+	// proxy connection that was established while this packet was being received - no processing, only redirect
+	// any further packets will be relayed by connection itself
 	if(activeProxies.count(connection))
 	{
 		auto lockedPtr = activeProxies.at(connection);
@@ -414,6 +519,9 @@ void LobbyServer::onPacketReceived(const NetworkConnectionPtr & connection, cons
 		if(messageType == "sendInvite")
 			return receiveSendInvite(connection, json);
 
+		if(messageType == "enableIncrementalUpdates")
+			return receiveEnableIncrementalUpdates(connection, json);
+
 		logGlobal->warn("%s: Unknown message type: %s", accountName, messageType);
 		return;
 	}
@@ -602,6 +710,14 @@ void LobbyServer::receiveClientLogin(const NetworkConnectionPtr & connection, co
 
 	std::string displayName = database->getAccountDisplayName(accountID);
 
+	// notify everybody else about new account, new account will receive full lists below
+	if(!onlineAccounts.count(accountID))
+	{
+		LobbyAccount account{accountID, displayName};
+		onlineAccounts[accountID] = account;
+		broadcastAccountJoined(account);
+	}
+
 	activeAccounts[connection] = accountID;
 
 	logGlobal->info("%s: Logged in as %s", accountID, displayName);
@@ -610,9 +726,7 @@ void LobbyServer::receiveClientLogin(const NetworkConnectionPtr & connection, co
 	if (language != "english")
 		sendRecentChatHistory(connection, "global", language);
 
-	// send active game rooms list to new account
-	// and update account list to everybody else including new account
-	broadcastActiveAccounts();
+	sendMessage(connection, prepareActiveAccounts());
 	sendMessage(connection, prepareActiveGameRooms());
 	sendMatchesHistory(connection);
 }
@@ -636,7 +750,7 @@ void LobbyServer::receiveServerLogin(const NetworkConnectionPtr & connection, co
 		database->insertGameRoom(gameRoomID, accountID, version, modListString);
 		activeGameRooms[connection] = gameRoomID;
 		sendServerLoginSuccess(connection, accountCookie);
-		broadcastActiveGameRooms();
+		broadcastGameRoomChanged(gameRoomID);
 	}
 }
 
@@ -665,6 +779,13 @@ void LobbyServer::receiveClientProxyLogin(const NetworkConnectionPtr & connectio
 			{
 				activeProxies[gameRoomConnection] = connection;
 				activeProxies[connection] = gameRoomConnection;
+
+				auto & statistics = proxyStatistics[gameRoomID];
+				if(!statistics)
+					statistics = std::make_shared<NetworkRelayStatistics>();
+
+				gameRoomConnection->setRelayTarget(connection, statistics);
+				connection->setRelayTarget(gameRoomConnection, statistics);
 			}
 			return;
 		}
@@ -730,7 +851,7 @@ void LobbyServer::receiveActivateGameRoom(const NetworkConnectionPtr & connectio
 
 	database->updateRoomPlayerLimit(gameRoomID, playerLimit);
 	database->insertPlayerIntoGameRoom(accountID, gameRoomID);
-	broadcastActiveGameRooms();
+	broadcastGameRoomChanged(gameRoomID);
 	sendJoinRoomSuccess(connection, gameRoomID, false);
 }
 
@@ -765,7 +886,7 @@ void LobbyServer::receiveJoinGameRoom(const NetworkConnectionPtr & connection, c
 	sendAccountJoinsRoom(targetRoom, accountID);
 	//No reply to client - will be sent once match server establishes proxy connection with lobby
 
-	broadcastActiveGameRooms();
+	broadcastGameRoomChanged(gameRoomID);
 }
 
 void LobbyServer::receiveChangeRoomDescription(const NetworkConnectionPtr & connection, const JsonNode & json)
@@ -774,7 +895,7 @@ void LobbyServer::receiveChangeRoomDescription(const NetworkConnectionPtr & conn
 	std::string description = json["description"].String();
 
 	database->updateRoomDescription(gameRoomID, description);
-	broadcastActiveGameRooms();
+	broadcastGameRoomChanged(gameRoomID);
 }
 
 void LobbyServer::receiveGameStarted(const NetworkConnectionPtr & connection, const JsonNode & json)
@@ -782,7 +903,7 @@ void LobbyServer::receiveGameStarted(const NetworkConnectionPtr & connection, co
 	std::string gameRoomID = activeGameRooms[connection];
 
 	database->setGameRoomStatus(gameRoomID, LobbyRoomState::BUSY);
-	broadcastActiveGameRooms();
+	broadcastGameRoomChanged(gameRoomID);
 }
 
 void LobbyServer::receiveLeaveGameRoom(const NetworkConnectionPtr & connection, const JsonNode & json)
@@ -795,7 +916,7 @@ void LobbyServer::receiveLeaveGameRoom(const NetworkConnectionPtr & connection,
 
 	database->deletePlayerFromGameRoom(accountID, gameRoomID);
 
-	broadcastActiveGameRooms();
+	broadcastGameRoomChanged(gameRoomID);
 }
 
 void LobbyServer::receiveSendInvite(const NetworkConnectionPtr & connection, const JsonNode & json)
@@ -820,7 +941,13 @@ void LobbyServer::receiveSendInvite(const NetworkConnectionPtr & connection, con
 
 	database->insertGameRoomInvite(accountID, gameRoomID);
 	sendInviteReceived(targetAccountConnection, senderName, gameRoomID);
-	broadcastActiveGameRooms();
+	broadcastGameRoomChanged(gameRoomID);
+}
+
+void LobbyServer::receiveEnableIncrementalUpdates(const NetworkConnectionPtr & connection, const JsonNode & json)
+{
+	// full lists were already sent on login, from now on only changes will be sent to this account
+	incrementalUpdateAccounts.insert(connection);
 }
 
 LobbyServer::~LobbyServer() = default;
@@ -837,7 +964,15 @@ void LobbyServer::start(uint16_t port)
 	networkServer->start(port);
 }
 
-void LobbyServer::run()
+void LobbyServer::run(int threadsCount)
 {
+	std::vector<boost::thread> networkThreads;
+
+	for(int i = 1; i < threadsCount; ++i)
+		networkThreads.emplace_back([this](){ networkHandler->run(); });
+
 	networkHandler->run();
+
+	for(auto & thread : networkThreads)
+		thread.join();
 }
@@ -34,12 +34,35 @@ class LobbyServer final : public INetworkServerListener
 	/// list of half-established proxies from server that are still waiting for client to connect
 	std::vector<AwaitingProxyState> awaitingProxies;
 
+	/// traffic relayed through proxies of each game room, key is game room ID
+	std::map<std::string, std::shared_ptr<NetworkRelayStatistics>> proxyStatistics;
+
+	/// Protects all lobby state. Network is processed by multiple threads, so packets of established proxies,
+	/// which are relayed by network connections directly, are not delayed by processing of lobby messages
+	std::mutex lobbyStateMutex;
+
 	/// list of logged in accounts (vcmiclient's)
 	std::map<NetworkConnectionPtr, std::string> activeAccounts;
 
 	/// list of currently logged in game rooms (vcmiserver's)
 	std::map<NetworkConnectionPtr, std::string> activeGameRooms;
 
+	/// accounts that requested incremental updates of accounts and rooms lists instead of full lists
+	std::set<NetworkConnectionPtr> incrementalUpdateAccounts;
+
+	struct ListedGameRoom
+	{
+		LobbyGameRoom room;
+		/// time at which room was loaded from database, to keep reported room age up to date
+		std::chrono::steady_clock::time_point loadTime;
+	};
+
+	/// in-memory copy of accounts list that is sent to clients, key is account ID
+	std::map<std::string, LobbyAccount> onlineAccounts;
+
+	/// in-memory copy of game rooms list that is sent to clients, key is game room ID
+	std::map<std::string, ListedGameRoom> listedGameRooms;
+
 	std::unique_ptr<LobbyDatabase> database;
 	std::unique_ptr<INetworkHandler> networkHandler;
 	std::unique_ptr<INetworkServer> networkServer;
@@ -58,10 +81,16 @@ class LobbyServer final : public INetworkServerListener
 
 	void sendMessage(const NetworkConnectionPtr & target, const JsonNode & json);
 
-	void broadcastActiveAccounts();
-	void broadcastActiveGameRooms();
+	/// Serializes message once and sends it to all logged in accounts that use (or don't use) incremental updates
+	void broadcastMessage(const JsonNode & json, bool incrementalUpdates);
 
-	JsonNode prepareActiveGameRooms();
+	void broadcastAccountJoined(const LobbyAccount & account);
+	void broadcastAccountLeft(const std::string & accountID);
+	/// Reloads game room from database and notifies accounts if room was changed, added to or removed from list of active rooms
+	void broadcastGameRoomChanged(const std::string & gameRoomID);
+
+	JsonNode prepareActiveAccounts() const;
+	JsonNode prepareActiveGameRooms() const;
 
 	/// Attempts to load json from incoming byte stream and validate it
 	/// Returns parsed json on success or empty json node on failure
@@ -94,11 +123,14 @@ class LobbyServer final : public INetworkServerListener
 	void receiveChangeRoomDescription(const NetworkConnectionPtr & connection, const JsonNode & json);
 	void receiveGameStarted(const NetworkConnectionPtr & connection, const JsonNode & json);
 	void receiveSendInvite(const NetworkConnectionPtr & connection, const JsonNode & json);
+	void receiveEnableIncrementalUpdates(const NetworkConnectionPtr & connection, const JsonNode & json);
 
 public:
 	explicit LobbyServer(const boost::filesystem::path & databasePath);
 	~LobbyServer();
 
 	void start(uint16_t port);
-	void run();
+
+	/// Processes network on this and on additional threads, does not returns until network processing has been terminated
+	void run(int threadsCount);
 };
@@ -181,6 +181,11 @@ SQLiteInstance::~SQLiteInstance()
 	sqlite3_close(m_connection);
 }
 
+bool SQLiteInstance::isInTransaction() const
+{
+	return sqlite3_get_autocommit(m_connection) == 0;
+}
+
 SQLiteStatementPtr SQLiteInstance::prepare(const std::string & sql_text)
 {
 	sqlite3_stmt * statement;
@@ -118,6 +118,9 @@ public:
 
 	SQLiteStatementPtr prepare(const std::string & statement);
 
+	/// Returns true if transaction was started on this connection and was not committed or rolled back yet
+	bool isInTransaction() const;
+
 private:
 	explicit SQLiteInstance(sqlite3 * connection);
 
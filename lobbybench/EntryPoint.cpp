@@ -0,0 +1,119 @@
+/*
+ * EntryPoint.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "LobbyBench.h"
+
+#include "../lib/CConsoleHandler.h"
+#include "../lib/constants/NumericConstants.h"
+#include "../lib/logging/CBasicLogConfigurator.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/VCMIDirs.h"
+
+#include <boost/program_options.hpp>
+
+static void handleCommandOptions(int argc, const char * argv[], boost::program_options::variables_map & options)
+{
+	boost::program_options::options_description opts("Allowed options");
+	opts.add_options()
+	("help,h", "display help and exit")
+	("version,v", "display version information and exit")
+	("host", boost::program_options::value<std::string>()->default_value("127.0.0.1"), "address of lobby server")
+	("port", boost::program_options::value<uint16_t>()->default_value(3031), "port of lobby server")
+	("clients", boost::program_options::value<int>()->default_value(100), "number of simulated clients")
+	("rooms", boost::program_options::value<int>()->default_value(10), "number of game rooms hosted by clients")
+	("guests", boost::program_options::value<int>()->default_value(1), "number of clients that join every room")
+	("duration", boost::program_options::value<int>()->default_value(60), "duration of test, in seconds")
+	("connect-interval", boost::program_options::value<int>()->default_value(20), "delay between connections of clients, in milliseconds")
+	("chat-interval", boost::program_options::value<int>()->default_value(5000), "interval between chat messages of every client, in milliseconds, 0 to disable")
+	("proxy-interval", boost::program_options::value<int>()->default_value(100), "interval between packets sent by guests through proxy, in milliseconds, 0 to disable")
+	("proxy-size", boost::program_options::value<size_t>()->default_value(1024), "size of packets sent through proxy, in bytes")
+	("full-updates", "do not request incremental updates of accounts and rooms lists, like older clients")
+	("output", boost::program_options::value<std::string>(), "path to json file to write results to");
+
+	try
+	{
+		boost::program_options::store(boost::program_options::parse_command_line(argc, argv, opts), options);
+	}
+	catch(boost::program_options::error & e)
+	{
+		std::cerr << "Failure during parsing command-line options:\n" << e.what() << std::endl;
+		exit(1);
+	}
+
+	boost::program_options::notify(options);
+
+	if(options.count("help"))
+	{
+		printf("%s - lobby server load test\n", GameConstants::VCMI_VERSION.c_str());
+		printf("Usage: vcmilobbybench [options]\n");
+		printf("\n");
+		std::cout << opts;
+		exit(0);
+	}
+
+	if(options.count("version"))
+	{
+		printf("%s\n", GameConstants::VCMI_VERSION.c_str());
+		std::cout << VCMIDirs::get().genHelpString();
+		exit(0);
+	}
+}
+
+int main(int argc, const char * argv[])
+{
+	boost::program_options::variables_map opts;
+	handleCommandOptions(argc, argv, opts);
+
+	std::optional<boost::filesystem::path> outputPath;
+	if(opts.count("output"))
+		outputPath = boost::filesystem::absolute(opts["output"].as<std::string>());
+
+	console = new CConsoleHandler();
+	CBasicLogConfigurator logConfig(VCMIDirs::get().userLogsPath() / "VCMI_LobbyBench_log.txt", console);
+	logConfig.configureDefault();
+
+	LobbyBenchConfig config;
+	config.host = opts["host"].as<std::string>();
+	config.port = opts["port"].as<uint16_t>();
+	config.clients = opts["clients"].as<int>();
+	config.rooms = opts["rooms"].as<int>();
+	config.guestsPerRoom = opts["guests"].as<int>();
+	config.duration = std::chrono::seconds(opts["duration"].as<int>());
+	config.connectInterval = std::chrono::milliseconds(opts["connect-interval"].as<int>());
+	config.chatInterval = std::chrono::milliseconds(opts["chat-interval"].as<int>());
+	config.proxyInterval = std::chrono::milliseconds(opts["proxy-interval"].as<int>());
+	config.proxyPacketSize = opts["proxy-size"].as<size_t>();
+	config.incrementalUpdates = !opts.count("full-updates");
+
+	int exitCode = 0;
+
+	try
+	{
+		LobbyBench bench(config);
+		bench.run();
+		bench.getStatistics().printReport(config.duration);
+
+		if(outputPath)
+		{
+			std::ofstream file(outputPath->c_str(), std::ofstream::trunc);
+			file << bench.getStatistics().toJson(config.duration).toString();
+		}
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Lobby benchmark failed: %s", e.what());
+		exitCode = 1;
+	}
+
+	logConfig.deconfigure();
+
+	return exitCode;
+}
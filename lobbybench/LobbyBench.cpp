@@ -0,0 +1,86 @@
+/*
+ * LobbyBench.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "LobbyBench.h"
+
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+/// Maximal number of players in a game room, including host
+static constexpr int MAX_PLAYERS_IN_ROOM = 8;
+
+LobbyBench::LobbyBench(const LobbyBenchConfig & config)
+	: network(INetworkHandler::createHandler())
+	, config(config)
+	, context{*network, this->config, statistics, generateAccountPrefix()}
+{
+	if(config.clients < 1)
+		throw std::runtime_error("Number of clients must be positive");
+
+	if(config.rooms < 0 || config.guestsPerRoom < 0)
+		throw std::runtime_error("Number of rooms and guests can not be negative");
+
+	if(config.guestsPerRoom + 1 > MAX_PLAYERS_IN_ROOM)
+		throw std::runtime_error("Room can not have more than " + std::to_string(MAX_PLAYERS_IN_ROOM - 1) + " guests");
+
+	if(config.rooms * (config.guestsPerRoom + 1) > config.clients)
+		throw std::runtime_error("Not enough clients to host and join all rooms");
+
+	if(config.proxyPacketSize < sizeof(int64_t))
+		throw std::runtime_error("Proxy packets must be at least " + std::to_string(sizeof(int64_t)) + " bytes long");
+
+	for(int i = 0; i < config.clients; ++i)
+		clients.push_back(std::make_unique<SimulatedClient>(context, i));
+
+	// first clients host rooms, followed by guests of every room, remaining clients only use chat
+	int nextClient = 0;
+	for(int i = 0; i < config.rooms; ++i)
+	{
+		auto room = std::make_unique<SimulatedRoom>();
+		room->gameRoomID = boost::uuids::to_string(boost::uuids::random_generator()());
+		clients[nextClient++]->setHostedRoom(*room);
+		rooms.push_back(std::move(room));
+	}
+
+	for(const auto & room : rooms)
+		for(int i = 0; i < config.guestsPerRoom; ++i)
+			clients[nextClient++]->setJoinedRoom(*room);
+}
+
+LobbyBench::~LobbyBench() = default;
+
+std::string LobbyBench::generateAccountPrefix()
+{
+	// account names must be unique and may only contain latin letters and numbers
+	std::string uuid = boost::uuids::to_string(boost::uuids::random_generator()());
+	return "lb" + uuid.substr(0, 6);
+}
+
+void LobbyBench::run()
+{
+	logGlobal->info("Simulating %d clients in %d rooms on %s:%d for %d seconds", config.clients, config.rooms, config.host, config.port, config.duration.count());
+
+	for(size_t i = 0; i < clients.size(); ++i)
+		clients[i]->start(config.connectInterval * i);
+
+	stopTimer.start(*network, config.duration, [this]()
+	{
+		context.stopping = true;
+		network->stop();
+	});
+
+	network->run();
+}
+
+const LobbyBenchStatistics & LobbyBench::getStatistics() const
+{
+	return statistics;
+}
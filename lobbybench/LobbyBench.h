@@ -0,0 +1,42 @@
+/*
+ * LobbyBench.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "LobbyBenchStatistics.h"
+#include "SimulatedClient.h"
+
+/// Simulates load of many players on lobby server: registration, login, chat, hosting and joining of game rooms
+/// and game traffic through lobby proxy. All simulated clients and match servers share single network thread
+class LobbyBench : boost::noncopyable
+{
+	/// Must be declared first - connections of clients are owned by network handler and must be destroyed last
+	std::unique_ptr<INetworkHandler> network;
+
+	LobbyBenchConfig config;
+	LobbyBenchStatistics statistics;
+	LobbyBenchContext context;
+
+	std::vector<std::unique_ptr<SimulatedRoom>> rooms;
+	std::vector<std::unique_ptr<SimulatedClient>> clients;
+
+	CallbackTimer stopTimer;
+
+	static std::string generateAccountPrefix();
+
+public:
+	/// Throws std::runtime_error if configuration is not valid
+	explicit LobbyBench(const LobbyBenchConfig & config);
+	~LobbyBench();
+
+	/// Runs benchmark on calling thread for configured duration
+	void run();
+
+	const LobbyBenchStatistics & getStatistics() const;
+};
@@ -0,0 +1,135 @@
+/*
+ * LobbyBenchStatistics.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "LobbyBenchStatistics.h"
+
+#include "../lib/json/JsonNode.h"
+
+static double toMilliseconds(LobbyBenchStatistics::Duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+static double toSeconds(LobbyBenchStatistics::Duration duration)
+{
+	return std::chrono::duration<double>(duration).count();
+}
+
+void LobbyBenchStatistics::addLatency(const std::string & operation, Duration latency)
+{
+	latencies[operation].push_back(latency);
+}
+
+void LobbyBenchStatistics::addError(const std::string & description)
+{
+	logGlobal->debug("Lobby benchmark error: %s", description);
+	errors[description] += 1;
+}
+
+void LobbyBenchStatistics::addSent(size_t bytes)
+{
+	sent.packets += 1;
+	sent.bytes += bytes;
+}
+
+void LobbyBenchStatistics::addReceived(size_t bytes)
+{
+	received.packets += 1;
+	received.bytes += bytes;
+}
+
+void LobbyBenchStatistics::addProxied(size_t bytes)
+{
+	proxied.packets += 1;
+	proxied.bytes += bytes;
+}
+
+double LobbyBenchStatistics::getPercentile(const std::vector<Duration> & sortedSamples, double percentile)
+{
+	if(sortedSamples.empty())
+		return 0;
+
+	size_t index = std::min(sortedSamples.size() - 1, static_cast<size_t>(percentile * sortedSamples.size()));
+	return toMilliseconds(sortedSamples[index]);
+}
+
+void LobbyBenchStatistics::printReport(Duration testDuration) const
+{
+	double seconds = toSeconds(testDuration);
+
+	logGlobal->info("Lobby load test finished after %.1f seconds", seconds);
+	logGlobal->info("Latency, ms:");
+
+	for(const auto & operation : latencies)
+	{
+		auto samples = operation.second;
+		std::sort(samples.begin(), samples.end());
+
+		logGlobal->info("\t%s: %d samples, p50 %.2f, p90 %.2f, p99 %.2f, max %.2f",
+			operation.first,
+			samples.size(),
+			getPercentile(samples, 0.5),
+			getPercentile(samples, 0.9),
+			getPercentile(samples, 0.99),
+			toMilliseconds(samples.back()));
+	}
+
+	logGlobal->info("Throughput:");
+	logGlobal->info("\tsent: %d messages, %.0f per second, %.1f KB per second", sent.packets, sent.packets / seconds, sent.bytes / seconds / 1024);
+	logGlobal->info("\treceived: %d messages, %.0f per second, %.1f KB per second", received.packets, received.packets / seconds, received.bytes / seconds / 1024);
+	logGlobal->info("\tproxied: %d packets, %.0f per second, %.1f KB per second", proxied.packets, proxied.packets / seconds, proxied.bytes / seconds / 1024);
+
+	if(!errors.empty())
+	{
+		logGlobal->info("Errors:");
+		for(const auto & error : errors)
+			logGlobal->info("\t%s: %d", error.first, error.second);
+	}
+}
+
+JsonNode LobbyBenchStatistics::toJson(Duration testDuration) const
+{
+	double seconds = toSeconds(testDuration);
+	JsonNode output;
+
+	output["duration"].Float() = seconds;
+
+	for(const auto & operation : latencies)
+	{
+		auto samples = operation.second;
+		std::sort(samples.begin(), samples.end());
+
+		auto & entry = output["latency"][operation.first];
+		entry["samples"].Integer() = samples.size();
+		entry["p50"].Float() = getPercentile(samples, 0.5);
+		entry["p90"].Float() = getPercentile(samples, 0.9);
+		entry["p99"].Float() = getPercentile(samples, 0.99);
+		entry["max"].Float() = toMilliseconds(samples.back());
+	}
+
+	const auto & trafficToJson = [seconds](const TrafficCounter & counter)
+	{
+		JsonNode entry;
+		entry["packets"].Integer() = counter.packets;
+		entry["bytes"].Integer() = counter.bytes;
+		entry["packetsPerSecond"].Float() = counter.packets / seconds;
+		entry["bytesPerSecond"].Float() = counter.bytes / seconds;
+		return entry;
+	};
+
+	output["sent"] = trafficToJson(sent);
+	output["received"] = trafficToJson(received);
+	output["proxied"] = trafficToJson(proxied);
+
+	for(const auto & error : errors)
+		output["errors"][error.first].Integer() = error.second;
+
+	return output;
+}
@@ -0,0 +1,55 @@
+/*
+ * LobbyBenchStatistics.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+class JsonNode;
+VCMI_LIB_NAMESPACE_END
+
+/// Latencies of lobby operations and traffic counters collected by all simulated clients
+/// All clients are processed by a single network thread, so no synchronization is needed
+class LobbyBenchStatistics : boost::noncopyable
+{
+public:
+	using Duration = std::chrono::steady_clock::duration;
+
+private:
+	struct TrafficCounter
+	{
+		uint64_t packets = 0;
+		uint64_t bytes = 0;
+	};
+
+	/// Key: name of operation, e.g. login or chat
+	std::map<std::string, std::vector<Duration>> latencies;
+	/// Key: description of error
+	std::map<std::string, int> errors;
+
+	TrafficCounter sent;
+	TrafficCounter received;
+	TrafficCounter proxied;
+
+	static double getPercentile(const std::vector<Duration> & sortedSamples, double percentile);
+
+public:
+	void addLatency(const std::string & operation, Duration latency);
+	void addError(const std::string & description);
+
+	void addSent(size_t bytes);
+	void addReceived(size_t bytes);
+	/// Packet that went through lobby proxy and was echoed back by simulated match server
+	void addProxied(size_t bytes);
+
+	/// Prints summary to the log. Duration is used to compute throughput
+	void printReport(Duration testDuration) const;
+
+	/// Converts summary to json, for comparison with results of other builds or lobby configurations
+	JsonNode toJson(Duration testDuration) const;
+};
@@ -0,0 +1,396 @@
+/*
+ * SimulatedClient.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "SimulatedClient.h"
+
+#include "LobbyBenchStatistics.h"
+
+#include "../lib/json/JsonFormatException.h"
+#include "../lib/json/JsonNode.h"
+
+static JsonNode parseMessage(const std::vector<std::byte> & message)
+{
+	try
+	{
+		return JsonNode(message.data(), message.size(), "<lobby message>");
+	}
+	catch(const JsonFormatException &)
+	{
+		return JsonNode();
+	}
+}
+
+void CallbackTimer::start(INetworkHandler & network, std::chrono::milliseconds delay, const std::function<void()> & newCallback)
+{
+	callback = newCallback;
+	network.createTimer(*this, delay);
+}
+
+void CallbackTimer::onTimer()
+{
+	callback();
+}
+
+SimulatedMatchServer::SimulatedMatchServer(LobbyBenchContext & context, SimulatedRoom & room, SimulatedClient & host)
+	: context(context)
+	, room(room)
+	, host(host)
+{
+}
+
+void SimulatedMatchServer::start()
+{
+	context.network.connectToRemote(*this, context.config.host, context.config.port);
+}
+
+void SimulatedMatchServer::onConnectionFailed(const std::string & errorMessage)
+{
+	context.statistics.addError("match server failed to connect: " + errorMessage);
+}
+
+void SimulatedMatchServer::onConnectionEstablished(const NetworkConnectionPtr & connection)
+{
+	connection->setAsyncWritesEnabled(true);
+
+	if(controlConnection == nullptr)
+	{
+		controlConnection = connection;
+
+		JsonNode toSend;
+		toSend["type"].String() = "serverLogin";
+		toSend["gameRoomID"].String() = room.gameRoomID;
+		toSend["accountID"].String() = host.getAccountID();
+		toSend["accountCookie"].String() = host.getAccountCookie();
+		toSend["version"].String() = VCMI_VERSION_STRING;
+		toSend["mods"].Vector();
+
+		auto data = toSend.toBytes();
+		context.statistics.addSent(data.size());
+		connection->sendPacket(data);
+		return;
+	}
+
+	if(awaitingGuests.empty())
+	{
+		context.statistics.addError("match server received unexpected connection");
+		connection->close();
+		return;
+	}
+
+	JsonNode toSend;
+	toSend["type"].String() = "serverProxyLogin";
+	toSend["gameRoomID"].String() = room.gameRoomID;
+	toSend["guestAccountID"].String() = awaitingGuests.front();
+	toSend["accountCookie"].String() = host.getAccountCookie();
+	awaitingGuests.pop_front();
+
+	auto data = toSend.toBytes();
+	context.statistics.addSent(data.size());
+	connection->sendPacket(data);
+	proxyConnections.insert(connection);
+}
+
+void SimulatedMatchServer::onDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage)
+{
+	if(!context.stopping)
+		context.statistics.addError("match server disconnected: " + errorMessage);
+
+	proxyConnections.erase(connection);
+}
+
+void SimulatedMatchServer::onPacketReceived(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message)
+{
+	if(proxyConnections.count(connection))
+	{
+		// game traffic from guest - send it back so guest can measure round trip time
+		connection->sendPacket(message);
+		return;
+	}
+
+	context.statistics.addReceived(message.size());
+	JsonNode json = parseMessage(message);
+	std::string messageType = json["type"].String();
+
+	if(messageType == "serverLoginSuccess")
+		return host.onMatchServerReady();
+
+	if(messageType == "accountJoinsRoom")
+	{
+		awaitingGuests.push_back(json["accountID"].String());
+		context.network.connectToRemote(*this, context.config.host, context.config.port);
+		return;
+	}
+
+	if(messageType == "operationFailed")
+		context.statistics.addError("match server: " + json["reason"].String());
+}
+
+SimulatedClient::SimulatedClient(LobbyBenchContext & context, int index)
+	: context(context)
+	, accountName(context.accountPrefix + std::to_string(index))
+{
+}
+
+SimulatedClient::~SimulatedClient() = default;
+
+void SimulatedClient::setHostedRoom(SimulatedRoom & room)
+{
+	hostedRoom = &room;
+}
+
+void SimulatedClient::setJoinedRoom(SimulatedRoom & room)
+{
+	joinedRoom = &room;
+	room.guests.push_back(this);
+}
+
+const std::string & SimulatedClient::getAccountID() const
+{
+	return accountID;
+}
+
+const std::string & SimulatedClient::getAccountCookie() const
+{
+	return accountCookie;
+}
+
+void SimulatedClient::start(std::chrono::milliseconds delay)
+{
+	startTimer.start(context.network, delay, [this]()
+	{
+		context.network.connectToRemote(*this, context.config.host, context.config.port);
+	});
+}
+
+void SimulatedClient::sendMessage(const NetworkConnectionPtr & connection, const JsonNode & json)
+{
+	auto data = json.toBytes();
+	context.statistics.addSent(data.size());
+	connection->sendPacket(data);
+}
+
+void SimulatedClient::onConnectionFailed(const std::string & errorMessage)
+{
+	context.statistics.addError("client failed to connect: " + errorMessage);
+}
+
+void SimulatedClient::onConnectionEstablished(const NetworkConnectionPtr & connection)
+{
+	connection->setAsyncWritesEnabled(true);
+
+	if(controlConnection == nullptr)
+	{
+		controlConnection = connection;
+
+		JsonNode toSend;
+		toSend["type"].String() = "clientRegister";
+		toSend["displayName"].String() = accountName;
+		toSend["language"].String() = "english";
+		toSend["version"].String() = VCMI_VERSION_STRING;
+
+		registerStartTime = std::chrono::steady_clock::now();
+		sendMessage(connection, toSend);
+		return;
+	}
+
+	proxyConnection = connection;
+
+	JsonNode toSend;
+	toSend["type"].String() = "clientProxyLogin";
+	toSend["gameRoomID"].String() = joinedRoom->gameRoomID;
+	toSend["accountID"].String() = accountID;
+	toSend["accountCookie"].String() = accountCookie;
+	sendMessage(connection, toSend);
+
+	// lobby processes packets of a connection in order, so all further packets will be relayed to match server
+	if(context.config.proxyInterval.count() != 0)
+		proxyTimer.start(context.network, context.config.proxyInterval, [this](){ sendProxyPacket(); });
+}
+
+void SimulatedClient::onDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage)
+{
+	if(!context.stopping)
+		context.statistics.addError("client disconnected: " + errorMessage);
+
+	if(connection == proxyConnection)
+		proxyConnection.reset();
+}
+
+void SimulatedClient::onPacketReceived(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message)
+{
+	if(connection == proxyConnection)
+		return receiveProxyPacket(message);
+
+	context.statistics.addReceived(message.size());
+	JsonNode json = parseMessage(message);
+	std::string messageType = json["type"].String();
+
+	if(messageType == "accountCreated")
+		return receiveAccountCreated(json);
+
+	if(messageType == "clientLoginSuccess")
+		return receiveClientLoginSuccess(json);
+
+	if(messageType == "chatMessage")
+		return receiveChatMessage(json);
+
+	if(messageType == "joinRoomSuccess")
+		return receiveJoinRoomSuccess(json);
+
+	if(messageType == "operationFailed")
+		context.statistics.addError("client: " + json["reason"].String());
+
+	// any other messages, such as lists of accounts and rooms, are only accounted in traffic statistics
+}
+
+void SimulatedClient::receiveAccountCreated(const JsonNode & json)
+{
+	context.statistics.addLatency("register", std::chrono::steady_clock::now() - registerStartTime);
+
+	accountID = json["accountID"].String();
+	accountCookie = json["accountCookie"].String();
+
+	JsonNode toSend;
+	toSend["type"].String() = "clientLogin";
+	toSend["accountID"].String() = accountID;
+	toSend["accountCookie"].String() = accountCookie;
+	toSend["language"].String() = "english";
+	toSend["version"].String() = VCMI_VERSION_STRING;
+
+	loginStartTime = std::chrono::steady_clock::now();
+	sendMessage(controlConnection, toSend);
+}
+
+void SimulatedClient::receiveClientLoginSuccess(const JsonNode & json)
+{
+	context.statistics.addLatency("login", std::chrono::steady_clock::now() - loginStartTime);
+	loggedIn = true;
+
+	if(context.config.incrementalUpdates)
+	{
+		JsonNode toSend;
+		toSend["type"].String() = "enableIncrementalUpdates";
+		sendMessage(controlConnection, toSend);
+	}
+
+	if(context.config.chatInterval.count() != 0)
+		chatTimer.start(context.network, context.config.chatInterval, [this](){ sendChatMessage(); });
+
+	if(hostedRoom)
+	{
+		matchServer = std::make_unique<SimulatedMatchServer>(context, *hostedRoom, *this);
+		matchServer->start();
+	}
+
+	if(joinedRoom)
+		joinRoom();
+}
+
+void SimulatedClient::onMatchServerReady()
+{
+	JsonNode toSend;
+	toSend["type"].String() = "activateGameRoom";
+	toSend["hostAccountID"].String() = accountID;
+	toSend["roomType"].String() = "public";
+	toSend["playerLimit"].Integer() = hostedRoom->guests.size() + 1;
+
+	activateStartTime = std::chrono::steady_clock::now();
+	sendMessage(controlConnection, toSend);
+}
+
+void SimulatedClient::joinRoom()
+{
+	if(!loggedIn || !joinedRoom->active)
+		return; // will be called again once both client and room are ready
+
+	JsonNode toSend;
+	toSend["type"].String() = "joinGameRoom";
+	toSend["gameRoomID"].String() = joinedRoom->gameRoomID;
+
+	joinStartTime = std::chrono::steady_clock::now();
+	sendMessage(controlConnection, toSend);
+}
+
+void SimulatedClient::sendChatMessage()
+{
+	std::string messageText = accountName + " says " + std::to_string(chatMessagesCounter++);
+
+	JsonNode toSend;
+	toSend["type"].String() = "sendChatMessage";
+	toSend["channelType"].String() = "global";
+	toSend["channelName"].String() = "english";
+	toSend["messageText"].String() = messageText;
+
+	awaitingChatMessages[messageText] = std::chrono::steady_clock::now();
+	sendMessage(controlConnection, toSend);
+
+	chatTimer.start(context.network, context.config.chatInterval, [this](){ sendChatMessage(); });
+}
+
+void SimulatedClient::receiveChatMessage(const JsonNode & json)
+{
+	if(json["accountID"].String() != accountID)
+		return;
+
+	auto it = awaitingChatMessages.find(json["messageText"].String());
+	if(it == awaitingChatMessages.end())
+		return;
+
+	context.statistics.addLatency("chat", std::chrono::steady_clock::now() - it->second);
+	awaitingChatMessages.erase(it);
+}
+
+void SimulatedClient::receiveJoinRoomSuccess(const JsonNode & json)
+{
+	if(!json["proxyMode"].Bool())
+	{
+		// reply to activation of our own room
+		context.statistics.addLatency("activateRoom", std::chrono::steady_clock::now() - activateStartTime);
+
+		hostedRoom->active = true;
+		for(auto * guest : hostedRoom->guests)
+			guest->joinRoom();
+		return;
+	}
+
+	context.statistics.addLatency("joinRoom", std::chrono::steady_clock::now() - joinStartTime);
+	context.network.connectToRemote(*this, context.config.host, context.config.port);
+}
+
+void SimulatedClient::sendProxyPacket()
+{
+	if(!proxyConnection)
+		return;
+
+	// packet starts with time of sending, to measure round trip time once match server sends it back
+	std::vector<std::byte> packet(context.config.proxyPacketSize);
+	int64_t sendTime = std::chrono::steady_clock::now().time_since_epoch().count();
+	std::memcpy(packet.data(), &sendTime, sizeof(sendTime));
+
+	proxyConnection->sendPacket(packet);
+
+	proxyTimer.start(context.network, context.config.proxyInterval, [this](){ sendProxyPacket(); });
+}
+
+void SimulatedClient::receiveProxyPacket(const std::vector<std::byte> & message)
+{
+	if(message.size() != context.config.proxyPacketSize)
+	{
+		context.statistics.addError("unexpected message received through proxy");
+		return;
+	}
+
+	int64_t sendTime = 0;
+	std::memcpy(&sendTime, message.data(), sizeof(sendTime));
+
+	auto latency = std::chrono::steady_clock::now().time_since_epoch() - std::chrono::steady_clock::duration(sendTime);
+	context.statistics.addLatency("proxy", latency);
+	context.statistics.addProxied(message.size());
+}
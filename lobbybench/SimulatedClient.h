@@ -0,0 +1,167 @@
+/*
+ * SimulatedClient.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/network/NetworkInterface.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+class JsonNode;
+VCMI_LIB_NAMESPACE_END
+
+class LobbyBenchStatistics;
+class SimulatedClient;
+
+struct LobbyBenchConfig
+{
+	std::string host = "127.0.0.1";
+	uint16_t port = 3031;
+
+	int clients = 100;
+	/// Number of clients that host a game room, each room gets its own simulated match server
+	int rooms = 10;
+	/// Number of clients that join each room through lobby proxy
+	int guestsPerRoom = 1;
+
+	std::chrono::seconds duration{60};
+	/// Delay between connection of two clients, to avoid login of all clients at once
+	std::chrono::milliseconds connectInterval{20};
+	/// Interval between chat messages of every client, zero to disable chat
+	std::chrono::milliseconds chatInterval{5000};
+	/// Interval between packets sent by every guest through proxy, zero to disable proxy traffic
+	std::chrono::milliseconds proxyInterval{100};
+	size_t proxyPacketSize = 1024;
+
+	/// If set, clients will request incremental updates of accounts and rooms lists after login
+	bool incrementalUpdates = true;
+};
+
+/// State shared by all simulated clients
+struct LobbyBenchContext
+{
+	INetworkHandler & network;
+	const LobbyBenchConfig & config;
+	LobbyBenchStatistics & statistics;
+
+	/// Used to generate unique account names for every run of benchmark
+	std::string accountPrefix;
+
+	/// Set once benchmark is over, after that disconnections are expected and not reported
+	bool stopping = false;
+};
+
+struct SimulatedRoom
+{
+	std::string gameRoomID;
+	bool active = false;
+	std::vector<SimulatedClient *> guests;
+};
+
+/// Timer that invokes callback on network thread
+class CallbackTimer final : public INetworkTimerListener
+{
+	std::function<void()> callback;
+
+public:
+	void start(INetworkHandler & network, std::chrono::milliseconds delay, const std::function<void()> & callback);
+	void onTimer() override;
+};
+
+/// Match server that hosts a room in lobby and echoes back all packets received from guests through lobby proxy
+class SimulatedMatchServer final : public INetworkClientListener, boost::noncopyable
+{
+	LobbyBenchContext & context;
+	SimulatedRoom & room;
+	SimulatedClient & host;
+
+	NetworkConnectionPtr controlConnection;
+	std::set<NetworkConnectionPtr> proxyConnections;
+	/// guests that lobby announced, for which proxy connection is still being established
+	std::deque<std::string> awaitingGuests;
+
+	void onConnectionFailed(const std::string & errorMessage) override;
+	void onConnectionEstablished(const NetworkConnectionPtr & connection) override;
+	void onDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage) override;
+	void onPacketReceived(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message) override;
+
+public:
+	SimulatedMatchServer(LobbyBenchContext & context, SimulatedRoom & room, SimulatedClient & host);
+
+	void start();
+};
+
+/// Lobby client that registers new account, logs in, sends chat messages
+/// and optionally hosts or joins game room and sends game traffic through lobby proxy
+class SimulatedClient final : public INetworkClientListener, boost::noncopyable
+{
+	using TimePoint = std::chrono::steady_clock::time_point;
+
+	LobbyBenchContext & context;
+	std::string accountName;
+	std::string accountID;
+	std::string accountCookie;
+	bool loggedIn = false;
+
+	/// Room hosted by this client, if any
+	SimulatedRoom * hostedRoom = nullptr;
+	std::unique_ptr<SimulatedMatchServer> matchServer;
+
+	/// Room joined by this client, if any
+	SimulatedRoom * joinedRoom = nullptr;
+
+	NetworkConnectionPtr controlConnection;
+	NetworkConnectionPtr proxyConnection;
+
+	CallbackTimer startTimer;
+	CallbackTimer chatTimer;
+	CallbackTimer proxyTimer;
+
+	int chatMessagesCounter = 0;
+	/// Key: text of sent message
+	std::map<std::string, TimePoint> awaitingChatMessages;
+
+	TimePoint registerStartTime;
+	TimePoint loginStartTime;
+	TimePoint activateStartTime;
+	TimePoint joinStartTime;
+
+	void sendMessage(const NetworkConnectionPtr & connection, const JsonNode & json);
+
+	void sendChatMessage();
+	void sendProxyPacket();
+
+	void receiveAccountCreated(const JsonNode & json);
+	void receiveClientLoginSuccess(const JsonNode & json);
+	void receiveChatMessage(const JsonNode & json);
+	void receiveJoinRoomSuccess(const JsonNode & json);
+	void receiveProxyPacket(const std::vector<std::byte> & message);
+
+	void onConnectionFailed(const std::string & errorMessage) override;
+	void onConnectionEstablished(const NetworkConnectionPtr & connection) override;
+	void onDisconnected(const NetworkConnectionPtr & connection, const std::string & errorMessage) override;
+	void onPacketReceived(const NetworkConnectionPtr & connection, const std::vector<std::byte> & message) override;
+
+public:
+	SimulatedClient(LobbyBenchContext & context, int index);
+	~SimulatedClient();
+
+	void setHostedRoom(SimulatedRoom & room);
+	void setJoinedRoom(SimulatedRoom & room);
+
+	/// Connects to lobby after specified delay
+	void start(std::chrono::milliseconds delay);
+
+	/// Called by match server once it has logged in into lobby
+	void onMatchServerReady();
+	/// Sends request to join room, if both client and room are ready
+	void joinRoom();
+
+	const std::string & getAccountID() const;
+	const std::string & getAccountCookie() const;
+};
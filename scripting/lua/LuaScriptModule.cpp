@@ -46,7 +46,41 @@ std::string LuaScriptModule::compile(const std::string & name, const std::string
 
 std::shared_ptr<ContextBase> LuaScriptModule::createContextFor(const Script * source, const Environment * env) const
 {
-	return std::make_shared<LuaContext>(source, env);
+	return std::make_shared<LuaContext>(source, env, getBytecode(source));
+}
+
+static int writeBytecode(lua_State * L, const void * data, size_t size, void * output)
+{
+	static_cast<std::string *>(output)->append(static_cast<const char *>(data), size);
+	return 0;
+}
+
+std::shared_ptr<const std::string> LuaScriptModule::getBytecode(const Script * source) const
+{
+	std::lock_guard lock(compiledScriptsMutex);
+
+	auto & compiled = compiledScripts[source];
+
+	//script source may be replaced on loading of saved game
+	if(compiled.bytecode && compiled.source == source->getSource())
+		return compiled.bytecode;
+
+	compiled.source = source->getSource();
+	compiled.bytecode.reset();
+
+	lua_State * L = luaL_newstate();
+
+	if(luaL_loadbuffer(L, compiled.source.c_str(), compiled.source.size(), source->getName().c_str()) == 0)
+	{
+		auto bytecode = std::make_shared<std::string>();
+
+		if(lua_dump(L, &writeBytecode, bytecode.get()) == 0)
+			compiled.bytecode = bytecode;
+	}
+
+	lua_close(L);
+
+	return compiled.bytecode;
 }
 
 void LuaScriptModule::registerSpellEffect(spells::effects::Registry * registry, const Script * source) const
@@ -29,7 +29,20 @@ public:
 
 	void registerSpellEffect(spells::effects::Registry * registry, const Script * source) const override;
 
+	/// Returns precompiled bytecode of script, compiling it on first request
+	/// Returns nullptr if script can not be compiled, in which case context will report error on loading its source
+	std::shared_ptr<const std::string> getBytecode(const Script * source) const;
+
 private:
+	struct CompiledScript
+	{
+		std::string source;
+		std::shared_ptr<const std::string> bytecode;
+	};
+
+	/// Bytecode shared by all contexts of same script, so each new context does not need to parse script again
+	mutable std::map<const Script *, CompiledScript> compiledScripts;
+	mutable std::mutex compiledScriptsMutex;
 };
 
 }
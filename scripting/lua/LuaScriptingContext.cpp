@@ -34,11 +34,12 @@ namespace scripting
 
 const std::string LuaContext::STATE_FIELD = "DATA";
 
-LuaContext::LuaContext(const Script * source, const Environment * env_):
+LuaContext::LuaContext(const Script * source, const Environment * env_, std::shared_ptr<const std::string> bytecode_):
 	ContextBase(env_->logger()),
 	L(luaL_newstate()),
 	script(source),
-	env(env_)
+	env(env_),
+	bytecode(std::move(bytecode_))
 {
 	static const std::vector<luaL_Reg> STD_LIBS =
 	{
@@ -161,7 +162,12 @@ void LuaContext::run(const JsonNode & initialState)
 {
 	setGlobal(STATE_FIELD, initialState);
 
-	int ret = luaL_loadbuffer(L, script->getSource().c_str(), script->getSource().size(), script->getName().c_str());
+	int ret;
+
+	if(bytecode)
+		ret = luaL_loadbuffer(L, bytecode->data(), bytecode->size(), script->getName().c_str());
+	else
+		ret = luaL_loadbuffer(L, script->getSource().c_str(), script->getSource().size(), script->getName().c_str());
 
 	if(ret)
 	{
@@ -190,30 +196,27 @@ int LuaContext::errorRetVoid(const std::string & message)
 	return 0;
 }
 
-JsonNode LuaContext::callGlobal(const std::string & name, const JsonNode & parameters)
+bool LuaContext::pushGlobalFunction(const std::string & name)
 {
-	LuaStack S(L);
-
 	lua_getglobal(L, name.c_str());
 
-	if(!S.isFunction(-1))
+	if(!lua_isfunction(L, -1))
 	{
 		boost::format fmt("%s is not a function");
 		fmt % name;
 
 		logger->error(fmt.str());
 
-		S.clear();
+		popAll();
 
-		return JsonNode();
+		return false;
 	}
+	return true;
+}
 
-	int argc = parameters.Vector().size();
-
-	for(int idx = 0; idx < argc; idx++)
-		S.push(parameters.Vector()[idx]);
-
-	if(lua_pcall(L, argc, 1, 0))
+bool LuaContext::callFunction(const std::string & name, int argc, int resultc)
+{
+	if(lua_pcall(L, argc, resultc, 0))
 	{
 		std::string error = lua_tostring(L, -1);
 
@@ -222,10 +225,48 @@ JsonNode LuaContext::callGlobal(const std::string & name, const JsonNode & param
 
 		logger->error(fmt.str());
 
-		S.clear();
+		popAll();
 
-		return JsonNode();
+		return false;
 	}
+	return true;
+}
+
+std::optional<bool> LuaContext::popPredicateResult(const std::string & name)
+{
+	std::optional<bool> ret;
+
+	if(lua_isboolean(L, -1))
+		ret = (lua_toboolean(L, -1) != 0);
+	else
+		logger->error("Lua function %s returned non-boolean value", name);
+
+	lua_pop(L, 1);
+
+	return ret;
+}
+
+void LuaContext::setServer(ServerCallback * cb)
+{
+	LuaStack S(L);
+	S.push(cb);
+	lua_setglobal(L, "SERVER");
+}
+
+JsonNode LuaContext::callGlobal(const std::string & name, const JsonNode & parameters)
+{
+	LuaStack S(L);
+
+	if(!pushGlobalFunction(name))
+		return JsonNode();
+
+	int argc = parameters.Vector().size();
+
+	for(int idx = 0; idx < argc; idx++)
+		S.push(parameters.Vector()[idx]);
+
+	if(!callFunction(name, argc, 1))
+		return JsonNode();
 
 	JsonNode ret;
 
@@ -237,18 +278,63 @@ JsonNode LuaContext::callGlobal(const std::string & name, const JsonNode & param
 
 JsonNode LuaContext::callGlobal(ServerCallback * cb, const std::string & name, const JsonNode & parameters)
 {
-	LuaStack S(L);
-	S.push(cb);
-	lua_setglobal(L, "SERVER");
+	setServer(cb);
 
 	auto ret = callGlobal(name, parameters);
 
-	S.pushNil();
-	lua_setglobal(L, "SERVER");
+	setServer(nullptr);
+
+	return ret;
+}
+
+std::optional<bool> LuaContext::callGlobalPredicate(const std::string & name)
+{
+	LuaStack S(L);
+
+	if(!pushGlobalFunction(name) || !callFunction(name, 0, 1))
+		return std::nullopt;
+
+	auto ret = popPredicateResult(name);
+	S.balance();
+
+	return ret;
+}
+
+std::optional<bool> LuaContext::callGlobalPredicate(const std::string & name, const EffectTargets & targets)
+{
+	LuaStack S(L);
+
+	if(!pushGlobalFunction(name))
+		return std::nullopt;
+
+	push(targets);
+
+	if(!callFunction(name, 1, 1))
+		return std::nullopt;
+
+	auto ret = popPredicateResult(name);
+	S.balance();
 
 	return ret;
 }
 
+void LuaContext::callGlobal(ServerCallback * cb, const std::string & name, const EffectTargets & targets)
+{
+	LuaStack S(L);
+
+	setServer(cb);
+
+	if(pushGlobalFunction(name))
+	{
+		push(targets);
+
+		if(callFunction(name, 1, 0))
+			S.balance();
+	}
+
+	setServer(nullptr);
+}
+
 void LuaContext::getGlobal(const std::string & name, int & value)
 {
 	LuaStack S(L);
@@ -408,6 +494,22 @@ void LuaContext::push(lua_CFunction f, void * opaque)
 	lua_pushcclosure(L, f, 1);
 }
 
+void LuaContext::push(const EffectTargets & targets)
+{
+	//same layout as JsonNode request: array of {hex, unitId} arrays
+	lua_createtable(L, static_cast<int>(targets.size()), 0);
+
+	for(size_t idx = 0; idx < targets.size(); idx++)
+	{
+		lua_createtable(L, 2, 0);
+		lua_pushinteger(L, targets[idx].first);
+		lua_rawseti(L, -2, 1);
+		lua_pushinteger(L, targets[idx].second);
+		lua_rawseti(L, -2, 2);
+		lua_rawseti(L, -2, static_cast<int>(idx) + 1);
+	}
+}
+
 void LuaContext::popAll()
 {
 	lua_settop(L, 0);
@@ -26,7 +26,7 @@ class LuaContext : public ContextBase
 public:
 	static const std::string STATE_FIELD;
 
-	LuaContext(const Script * source, const Environment * env_);
+	LuaContext(const Script * source, const Environment * env_, std::shared_ptr<const std::string> bytecode_ = nullptr);
 	virtual ~LuaContext();
 
 	void run(const JsonNode & initialState) override;
@@ -38,6 +38,10 @@ public:
 	JsonNode callGlobal(const std::string & name, const JsonNode & parameters) override;
 	JsonNode callGlobal(ServerCallback * cb, const std::string & name, const JsonNode & parameters) override;
 
+	std::optional<bool> callGlobalPredicate(const std::string & name) override;
+	std::optional<bool> callGlobalPredicate(const std::string & name, const EffectTargets & targets) override;
+	void callGlobal(ServerCallback * cb, const std::string & name, const EffectTargets & targets) override;
+
 	void getGlobal(const std::string & name, int & value) override;
 	void getGlobal(const std::string & name, std::string & value) override;
 	void getGlobal(const std::string & name, double & value) override;
@@ -56,6 +60,7 @@ public:
 
 	void push(const std::string & value);
 	void push(lua_CFunction f, void * opaque);
+	void push(const EffectTargets & targets);
 
 	std::string toStringRaw(int index);
 
@@ -66,11 +71,25 @@ private:
 
 	const Environment * env;
 
+	/// Precompiled script shared with other contexts, or nullptr if script should be loaded from source
+	std::shared_ptr<const std::string> bytecode;
+
 	std::shared_ptr<LuaReference> modules;
 	std::shared_ptr<LuaReference> scriptClosure;
 
 	void cleanupGlobals();
 
+	void setServer(ServerCallback * cb);
+
+	//push global function onto stack, returns false and logs error if there is no such function
+	bool pushGlobalFunction(const std::string & name);
+
+	//call function with arguments already on stack, returns false and logs error on failure
+	bool callFunction(const std::string & name, int argc, int resultc);
+
+	//pop boolean result of function call
+	std::optional<bool> popPredicateResult(const std::string & name);
+
 	void registerCore();
 
 	//require global function
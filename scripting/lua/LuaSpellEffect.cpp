@@ -71,15 +71,14 @@ bool LuaSpellEffect::applicable(Problem & problem, const Mechanics * m) const
 
 	setContextVariables(m, context);
 
-	JsonNode response = context->callGlobal(APPLICABLE_GENERAL, JsonNode());
+	std::optional<bool> response = context->callGlobalPredicate(APPLICABLE_GENERAL);
 
-	if(response.getType() != JsonNode::JsonType::DATA_BOOL)
+	if(!response.has_value())
 	{
 		logMod->error("Invalid API response from script %s.", script->getName());
-		logMod->debug(response.toCompactString());
 		return false;
 	}
-	return response.Bool();
+	return response.value();
 }
 
 bool LuaSpellEffect::applicable(Problem & problem, const Mechanics * m, const EffectTarget & target) const
@@ -90,36 +89,17 @@ bool LuaSpellEffect::applicable(Problem & problem, const Mechanics * m, const Ef
 
 	setContextVariables(m, context);
 
-	JsonNode requestP;
-
 	if(target.empty())
 		return false;
 
-	for(const auto & dest : target)
-	{
-		JsonNode targetData;
-		targetData.Vector().emplace_back(dest.hexValue.hex);
-
-		if(dest.unitValue)
-			targetData.Vector().emplace_back(dest.unitValue->unitId());
-		else
-			targetData.Vector().emplace_back(-1);
-
-		requestP.Vector().push_back(targetData);
-	}
+	std::optional<bool> response = context->callGlobalPredicate(APPLICABLE_TARGET, convertTarget(target));
 
-	JsonNode request;
-	request.Vector().push_back(requestP);
-
-	JsonNode response = context->callGlobal(APPLICABLE_TARGET, request);
-
-	if(response.getType() != JsonNode::JsonType::DATA_BOOL)
+	if(!response.has_value())
 	{
 		logMod->error("Invalid API response from script %s.", script->getName());
-		logMod->debug(response.toCompactString());
 		return false;
 	}
-	return response.Bool();
+	return response.value();
 }
 
 void LuaSpellEffect::apply(ServerCallback * server, const Mechanics * m, const EffectTarget & target) const
@@ -136,25 +116,7 @@ void LuaSpellEffect::apply(ServerCallback * server, const Mechanics * m, const E
 
 	setContextVariables(m, context);
 
-	JsonNode requestP;
-
-	for(const auto & dest : target)
-	{
-		JsonNode targetData;
-		targetData.Vector().emplace_back(dest.hexValue.hex);
-
-		if(dest.unitValue)
-			targetData.Vector().emplace_back(dest.unitValue->unitId());
-		else
-			targetData.Vector().emplace_back(-1);
-
-		requestP.Vector().push_back(targetData);
-	}
-
-	JsonNode request;
-	request.Vector().push_back(requestP);
-
-	context->callGlobal(server, APPLY, request);
+	context->callGlobal(server, APPLY, convertTarget(target));
 }
 
 EffectTarget LuaSpellEffect::filterTarget(const Mechanics * m, const EffectTarget & target) const
@@ -172,6 +134,17 @@ void LuaSpellEffect::serializeJsonEffect(JsonSerializeFormat & handler)
 	//TODO: load everything and provide to script
 }
 
+scripting::EffectTargets LuaSpellEffect::convertTarget(const EffectTarget & target)
+{
+	scripting::EffectTargets ret;
+	ret.reserve(target.size());
+
+	for(const auto & dest : target)
+		ret.emplace_back(dest.hexValue.hex, dest.unitValue ? dest.unitValue->unitId() : -1);
+
+	return ret;
+}
+
 std::shared_ptr<Context> LuaSpellEffect::resolveScript(const Mechanics * m) const
 {
 	return m->battle()->getContextPool()->getContext(script);
@@ -13,13 +13,9 @@
 #include "../../lib/spells/effects/Effect.h"
 #include "../../lib/spells/effects/Registry.h"
 
-VCMI_LIB_NAMESPACE_BEGIN
+#include <vcmi/scripting/Service.h>
 
-namespace scripting
-{
-	class Script;
-	class Context;
-}
+VCMI_LIB_NAMESPACE_BEGIN
 
 namespace spells
 {
@@ -68,6 +64,8 @@ private:
 
 	std::shared_ptr<Context> resolveScript(const Mechanics * m) const;
 
+	static scripting::EffectTargets convertTarget(const EffectTarget & target);
+
 	static void setContextVariables(const Mechanics * m, const std::shared_ptr<Context>& context) ;
 };
 
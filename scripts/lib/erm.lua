@@ -114,8 +114,16 @@ local Receivers = {}
 
 local function createReceiverLoader(name)
 	local loader = function(...)
-		Receivers[name] = Receivers[name] or require("core:erm."..name)
-		return Receivers[name]:new(ERM, ...)
+		local receiver = Receivers[name] or require("core:erm."..name)
+		Receivers[name] = receiver
+
+		-- module is resolved now, bind constructor directly so following calls skip loader
+		local constructor = function(...)
+			return receiver:new(ERM, ...)
+		end
+		rawset(ERM, name, constructor)
+
+		return constructor(...)
 	end
 	return loader
 end
@@ -228,8 +236,15 @@ function ERM:addTrigger(t)
 	trigger:addHandler(fn)
 end
 
+local FunctionKeys = {}
+
 function ERM:callFunction(id, x)
-	local id_key = makeIdKey("FU", id)
+	local id_key = FunctionKeys[id]
+
+	if not id_key then
+		id_key = makeIdKey("FU", id)
+		FunctionKeys[id] = id_key
+	end
 
 	local t = Triggers[id_key]
 	if t then
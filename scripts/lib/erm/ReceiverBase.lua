@@ -8,9 +8,18 @@ function ReceiverBase:new(o)
 end
 
 function ReceiverBase:p1Dispatcher(code)
+	-- names of methods are built once per used option, not on every call
+	local methods = setmetatable({}, {
+		__index = function(t, N)
+			local method = code..tostring(N)
+			rawset(t, N, method)
+			return method
+		end
+	})
+
 	self[code] = function(self, x, ...)
 		local N = select(1, ...)
-		return nil, self[code..tostring(N)](self, x, select(2, ...))
+		return nil, self[methods[N]](self, x, select(2, ...))
 	end
 end
 
@@ -4084,7 +4084,7 @@ void CGameHandler::removeAfterVisit(const CGObjectInstance *object)
 
 void CGameHandler::changeFogOfWar(int3 center, ui32 radius, PlayerColor player, ETileVisibility mode)
 {
-	std::unordered_set<int3> tiles;
+	TileSpanSet tiles;
 
 	if (mode == ETileVisibility::HIDDEN)
 	{
@@ -4097,7 +4097,7 @@ void CGameHandler::changeFogOfWar(int3 center, ui32 radius, PlayerColor player,
 	changeFogOfWar(tiles, player, mode);
 }
 
-void CGameHandler::changeFogOfWar(const std::unordered_set<int3> &tiles, PlayerColor player, ETileVisibility mode)
+void CGameHandler::changeFogOfWar(const TileSpanSet &tiles, PlayerColor player, ETileVisibility mode)
 {
 	if (tiles.empty())
 		return;
@@ -4111,13 +4111,12 @@ void CGameHandler::changeFogOfWar(const std::unordered_set<int3> &tiles, PlayerC
 	{
 		// do not hide tiles observed by owned objects. May lead to disastrous AI problems
 		// FIXME: this leads to a bug - shroud of darkness from Necropolis does can not override Skyship from Tower
-		std::unordered_set<int3> observedTiles;
+		TileSpanSet observedTiles;
 		auto p = getPlayerState(player);
 		for (auto obj : p->getOwnedObjects())
 			getTilesInRange(observedTiles, obj->getSightCenter(), obj->getSightRadius(), ETileVisibility::REVEALED, obj->getOwner());
 
-		for (auto tile : observedTiles)
-			vstd::erase_if_present (fow.tiles, tile);
+		fow.tiles.erase(observedTiles);
 	}
 
 	if (!fow.tiles.empty())
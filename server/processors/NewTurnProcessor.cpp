@@ -34,6 +34,39 @@
 
 #include <vstd/RNG.h>
 
+#include <tbb/parallel_for.h>
+
+namespace
+{
+
+/// Reports duration of each step of new turn processing
+class NewTurnStepTimer
+{
+	std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+
+public:
+	void finishStep(const std::string & stepName)
+	{
+		auto now = std::chrono::steady_clock::now();
+		auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - stepStart);
+		logGlobal->debug("New turn: %s took %d ms", stepName, duration.count());
+		stepStart = now;
+	}
+};
+
+std::vector<const CGHeroInstance *> getAllHeroes(const CGameState * gameState)
+{
+	std::vector<const CGHeroInstance *> result;
+
+	for (const auto & elem : gameState->players)
+		for (const CGHeroInstance * h : elem.second.getHeroes())
+			result.push_back(h);
+
+	return result;
+}
+
+}
+
 NewTurnProcessor::NewTurnProcessor(CGameHandler * gameHandler)
 	:gameHandler(gameHandler)
 {
@@ -183,22 +216,15 @@ void NewTurnProcessor::onPlayerTurnEnded(PlayerColor which)
 		gameHandler->heroPool->onNewWeek(which);
 }
 
-ResourceSet NewTurnProcessor::generatePlayerIncome(PlayerColor playerID, bool newWeek)
+ResourceSet NewTurnProcessor::generateMysticPondIncome(PlayerColor playerID)
 {
-	const auto & playerSettings = gameHandler->getPlayerSettings(playerID);
 	const PlayerState & state = gameHandler->gameState()->players.at(playerID);
 	ResourceSet income;
 
 	for (const auto & town : state.getTowns())
 	{
-		if (newWeek && town->hasBuilt(BuildingSubID::TREASURY))
-		{
-			//give 10% of starting gold
-			income[EGameResID::GOLD] += state.resources[EGameResID::GOLD] / 10;
-		}
-
 		//give resources if there's a Mystic Pond
-		if (newWeek && town->hasBuilt(BuildingSubID::MYSTIC_POND))
+		if (town->hasBuilt(BuildingSubID::MYSTIC_POND))
 		{
 			static constexpr std::array rareResources = {
 				GameResID::MERCURY,
@@ -216,6 +242,23 @@ ResourceSet NewTurnProcessor::generatePlayerIncome(PlayerColor playerID, bool ne
 			gameHandler->setObjPropertyValue(town->id, ObjProperty::BONUS_VALUE_SECOND, resVal);
 		}
 	}
+	return income;
+}
+
+ResourceSet NewTurnProcessor::generatePlayerIncome(PlayerColor playerID, bool newWeek, const ResourceSet & mysticPondIncome) const
+{
+	const auto & playerSettings = gameHandler->getPlayerSettings(playerID);
+	const PlayerState & state = gameHandler->gameState()->players.at(playerID);
+	ResourceSet income = mysticPondIncome;
+
+	for (const auto & town : state.getTowns())
+	{
+		if (newWeek && town->hasBuilt(BuildingSubID::TREASURY))
+		{
+			//give 10% of starting gold
+			income[EGameResID::GOLD] += state.resources[EGameResID::GOLD] / 10;
+		}
+	}
 
 	for (GameResID k = GameResID::WOOD; k < GameResID::COUNT; k++)
 	{
@@ -271,7 +314,7 @@ ResourceSet NewTurnProcessor::generatePlayerIncome(PlayerColor playerID, bool ne
 	return incomeHandicapped;
 }
 
-SetAvailableCreatures NewTurnProcessor::generateTownGrowth(const CGTownInstance * t, EWeekType weekType, CreatureID creatureWeek, bool firstDay)
+SetAvailableCreatures NewTurnProcessor::generateTownGrowth(const CGTownInstance * t, EWeekType weekType, CreatureID creatureWeek, bool firstDay) const
 {
 	SetAvailableCreatures sac;
 	PlayerColor player = t->tempOwner;
@@ -559,38 +602,47 @@ std::tuple<EWeekType, CreatureID> NewTurnProcessor::pickWeekType(bool newMonth)
 	}
 }
 
-std::vector<SetMana> NewTurnProcessor::updateHeroesManaPoints()
+std::vector<SetMana> NewTurnProcessor::updateHeroesManaPoints() const
 {
 	std::vector<SetMana> result;
+	auto heroes = getAllHeroes(gameHandler->gameState());
+	std::vector<int32_t> newMana(heroes.size());
 
-	for (auto & elem : gameHandler->gameState()->players)
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, heroes.size()), [&](const tbb::blocked_range<size_t> & r)
 	{
-		for (CGHeroInstance *h : elem.second.getHeroes())
-		{
-			int32_t newMana = h->getManaNewTurn();
+		for(size_t i = r.begin(); i != r.end(); ++i)
+			newMana[i] = heroes[i]->getManaNewTurn();
+	});
 
-			if (newMana != h->mana)
-				result.emplace_back(h->id, newMana, true);
-		}
+	for (size_t i = 0; i < heroes.size(); ++i)
+	{
+		if (newMana[i] != heroes[i]->mana)
+			result.emplace_back(heroes[i]->id, newMana[i], true);
 	}
 	return result;
 }
 
-std::vector<SetMovePoints> NewTurnProcessor::updateHeroesMovementPoints()
+std::vector<SetMovePoints> NewTurnProcessor::updateHeroesMovementPoints() const
 {
 	std::vector<SetMovePoints> result;
+	auto heroes = getAllHeroes(gameHandler->gameState());
+	std::vector<int32_t> newMovementPoints(heroes.size());
 
-	for (auto & elem : gameHandler->gameState()->players)
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, heroes.size()), [&](const tbb::blocked_range<size_t> & r)
 	{
-		for (CGHeroInstance *h : elem.second.getHeroes())
+		for(size_t i = r.begin(); i != r.end(); ++i)
 		{
+			const auto * h = heroes[i];
 			auto ti = h->getTurnInfo(1);
 			// NOTE: this code executed when bonuses of previous day not yet updated (this happen in NewTurn::applyGs). See issue 2356
-			int32_t newMovementPoints = h->movementPointsLimitCached(gameHandler->gameState()->map->getTile(h->visitablePos()).isLand(), ti.get());
-
-			if (newMovementPoints != h->movementPointsRemaining())
-				result.emplace_back(h->id, newMovementPoints, true);
+			newMovementPoints[i] = h->movementPointsLimitCached(gameHandler->gameState()->map->getTile(h->visitablePos()).isLand(), ti.get());
 		}
+	});
+
+	for (size_t i = 0; i < heroes.size(); ++i)
+	{
+		if (newMovementPoints[i] != heroes[i]->movementPointsRemaining())
+			result.emplace_back(heroes[i]->id, newMovementPoints[i], true);
 	}
 	return result;
 }
@@ -647,10 +699,33 @@ NewTurn NewTurnProcessor::generateNewTurnPack()
 	bool newWeek = gameHandler->getDate(Date::DAY_OF_WEEK) == 7; //day numbers are confusing, as day was not yet switched
 	bool newMonth = gameHandler->getDate(Date::DAY_OF_MONTH) == 28;
 
+	NewTurnStepTimer timer;
+
 	if (!firstTurn)
 	{
+		std::vector<PlayerColor> players;
 		for (const auto & player : gameHandler->gameState()->players)
-			n.playerIncome[player.first] = generatePlayerIncome(player.first, newWeek);
+			players.push_back(player.first);
+
+		// random income must be generated sequentially to keep random generator state deterministic
+		std::vector<ResourceSet> mysticPondIncome(players.size());
+		if (newWeek)
+		{
+			for (size_t i = 0; i < players.size(); ++i)
+				mysticPondIncome[i] = generateMysticPondIncome(players[i]);
+		}
+
+		std::vector<ResourceSet> income(players.size());
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, players.size()), [&](const tbb::blocked_range<size_t> & r)
+		{
+			for(size_t i = r.begin(); i != r.end(); ++i)
+				income[i] = generatePlayerIncome(players[i], newWeek, mysticPondIncome[i]);
+		});
+
+		for (size_t i = 0; i < players.size(); ++i)
+			n.playerIncome[players[i]] = income[i];
+
+		timer.finishStep("players income");
 	}
 
 	if (newWeek && !firstTurn)
@@ -661,12 +736,23 @@ NewTurn NewTurnProcessor::generateNewTurnPack()
 	}
 
 	n.heroesMana = updateHeroesManaPoints();
+	timer.finishStep("heroes mana");
+
 	n.heroesMovement = updateHeroesMovementPoints();
+	timer.finishStep("heroes movement points");
 
 	if (newWeek)
 	{
-		for (CGTownInstance *t : gameHandler->gameState()->map->towns)
-			n.availableCreatures.push_back(generateTownGrowth(t, n.specialWeek, n.creatureid, firstTurn));
+		const auto & towns = gameHandler->gameState()->map->towns;
+		n.availableCreatures.resize(towns.size());
+
+		tbb::parallel_for(tbb::blocked_range<size_t>(0, towns.size()), [&](const tbb::blocked_range<size_t> & r)
+		{
+			for(size_t i = r.begin(); i != r.end(); ++i)
+				n.availableCreatures[i] = generateTownGrowth(towns[i], n.specialWeek, n.creatureid, firstTurn);
+		});
+
+		timer.finishStep("towns growth");
 	}
 
 	if (newWeek)
@@ -684,19 +770,24 @@ NewTurn NewTurnProcessor::generateNewTurnPack()
 
 void NewTurnProcessor::onNewTurn()
 {
+	NewTurnStepTimer timer;
+
 	NewTurn n = generateNewTurnPack();
+	timer.finishStep("generation of new turn pack");
 
 	bool firstTurn = !gameHandler->getDate(Date::DAY);
 	bool newWeek = gameHandler->getDate(Date::DAY_OF_WEEK) == 7; //day numbers are confusing, as day was not yet switched
 	bool newMonth = gameHandler->getDate(Date::DAY_OF_MONTH) == 28;
 
 	gameHandler->sendAndApply(n);
+	timer.finishStep("application of new turn pack");
 
 	if (newWeek)
 	{
 		for (CGTownInstance *t : gameHandler->gameState()->map->towns)
 			if (t->hasBuilt(BuildingSubID::PORTAL_OF_SUMMONING))
 				gameHandler->setPortalDwelling(t, true, (n.specialWeek == EWeekType::PLAGUE ? true : false)); //set creatures for Portal of Summoning
+		timer.finishStep("portals of summoning");
 	}
 
 	if (newWeek && !firstTurn)
@@ -706,12 +797,14 @@ void NewTurnProcessor::onNewTurn()
 			if (!t->getOwner().isValidPlayer())
 				updateNeutralTownGarrison(t, 1 + gameHandler->getDate(Date::DAY) / 7);
 		}
+		timer.finishStep("neutral town garrisons");
 	}
 
 	//spawn wandering monsters
 	if (newMonth && (n.specialWeek == EWeekType::DOUBLE_GROWTH || n.specialWeek == EWeekType::DEITYOFFIRE))
 	{
 		gameHandler->spawnWanderingMonsters(n.creatureid);
+		timer.finishStep("wandering monsters");
 	}
 
 	logGlobal->trace("Info about turn %d has been sent!", n.day);
@@ -29,11 +29,15 @@ class NewTurnProcessor : boost::noncopyable
 {
 	CGameHandler * gameHandler;
 
-	std::vector<SetMana> updateHeroesManaPoints();
-	std::vector<SetMovePoints> updateHeroesMovementPoints();
+	// Methods marked as const only read game state and are executed in parallel from multiple threads
 
-	ResourceSet generatePlayerIncome(PlayerColor playerID, bool newWeek);
-	SetAvailableCreatures generateTownGrowth(const CGTownInstance * town, EWeekType weekType, CreatureID creatureWeek, bool firstDay);
+	std::vector<SetMana> updateHeroesManaPoints() const;
+	std::vector<SetMovePoints> updateHeroesMovementPoints() const;
+
+	/// Generates random income from Mystic Pond. Uses random generator and must be called sequentially
+	ResourceSet generateMysticPondIncome(PlayerColor playerID);
+	ResourceSet generatePlayerIncome(PlayerColor playerID, bool newWeek, const ResourceSet & mysticPondIncome) const;
+	SetAvailableCreatures generateTownGrowth(const CGTownInstance * town, EWeekType weekType, CreatureID creatureWeek, bool firstDay) const;
 	RumorState pickNewRumor();
 	InfoWindow createInfoWindow(EWeekType weekType, CreatureID creatureWeek, bool newMonth);
 	std::tuple<EWeekType, CreatureID> pickWeekType(bool newMonth);
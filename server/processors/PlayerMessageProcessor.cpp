@@ -607,17 +607,17 @@ void PlayerMessageProcessor::cheatMapReveal(PlayerColor player, bool reveal)
 	fc.player = player;
 	const auto & fowMap = gameHandler->gameState()->getPlayerTeam(player)->fogOfWarMap;
 	const auto & mapSize = gameHandler->gameState()->getMapSize();
-	auto hlp_tab = new int3[mapSize.x * mapSize.y * mapSize.z];
-	int lastUnc = 0;
 
 	for(int z = 0; z < mapSize.z; z++)
-		for(int x = 0; x < mapSize.x; x++)
-			for(int y = 0; y < mapSize.y; y++)
-				if(!fowMap[z][x][y] || fc.mode == ETileVisibility::HIDDEN)
-					hlp_tab[lastUnc++] = int3(x, y, z);
-
-	fc.tiles.insert(hlp_tab, hlp_tab + lastUnc);
-	delete [] hlp_tab;
+	{
+		for(int y = 0; y < mapSize.y; y++)
+		{
+			if(fc.mode == ETileVisibility::HIDDEN)
+				fc.tiles.insert(int3(0, y, z), mapSize.x);
+			else
+				fowMap.selectTiles(fc.tiles, int3(0, y, z), mapSize.x, false);
+		}
+	}
 
 	if (!fc.tiles.empty())
 		gameHandler->sendAndApply(fc);
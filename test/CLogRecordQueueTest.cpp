@@ -0,0 +1,83 @@
+/*
+ * CLogRecordQueueTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/logging/CLogger.h"
+
+static LogRecord makeRecord(const std::string & message)
+{
+	return LogRecord(CLoggerDomain(CLoggerDomain::DOMAIN_GLOBAL), ELogLevel::INFO, message);
+}
+
+TEST(CLogRecordQueueTest, rejectsRecordsWhenFull)
+{
+	CLogRecordQueue queue(4);
+
+	for(int i = 0; i < 4; ++i)
+		EXPECT_TRUE(queue.push(makeRecord(std::to_string(i))));
+
+	EXPECT_FALSE(queue.push(makeRecord("dropped")));
+
+	for(int i = 0; i < 4; ++i)
+	{
+		auto record = queue.pop();
+		ASSERT_TRUE(record.has_value());
+		EXPECT_EQ(record->message, std::to_string(i));
+	}
+
+	EXPECT_FALSE(queue.pop().has_value());
+	EXPECT_TRUE(queue.push(makeRecord("next")));
+}
+
+TEST(CLogRecordQueueTest, concurrentProducers)
+{
+	constexpr int producersCount = 4;
+	constexpr int recordsPerProducer = 1000;
+
+	CLogRecordQueue queue(64);
+	std::vector<boost::thread> producers;
+
+	for(int producer = 0; producer < producersCount; ++producer)
+	{
+		producers.emplace_back([&queue, producer]()
+		{
+			for(int i = 0; i < recordsPerProducer; ++i)
+				while(!queue.push(makeRecord(std::to_string(producer) + " " + std::to_string(i))))
+					boost::this_thread::yield();
+		});
+	}
+
+	// records of every producer must arrive complete and in order
+	std::vector<int> nextExpected(producersCount, 0);
+	int received = 0;
+
+	while(received < producersCount * recordsPerProducer)
+	{
+		auto record = queue.pop();
+		if(!record)
+		{
+			boost::this_thread::yield();
+			continue;
+		}
+
+		int producer;
+		int index;
+		std::istringstream(record->message) >> producer >> index;
+
+		EXPECT_EQ(index, nextExpected[producer]);
+		nextExpected[producer] = index + 1;
+		++received;
+	}
+
+	for(auto & thread : producers)
+		thread.join();
+
+	EXPECT_FALSE(queue.pop().has_value());
+}
@@ -0,0 +1,83 @@
+/*
+ * CMemoryViewStreamTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/filesystem/CMappedFile.h"
+#include "../lib/filesystem/CMemoryViewStream.h"
+
+struct CMemoryViewStreamTest : testing::Test
+{
+	std::shared_ptr<std::vector<ui8>> buffer = std::make_shared<std::vector<ui8>>(std::vector<ui8>{1, 2, 3, 4, 5, 6, 7, 8});
+	CMemoryViewStream subject{buffer, buffer->data() + 2, 4};
+};
+
+TEST_F(CMemoryViewStreamTest, read)
+{
+	EXPECT_EQ(subject.getSize(), 4);
+
+	ui8 data[8] = {};
+	auto ret = subject.read(data, 8);
+	EXPECT_EQ(ret, 4);
+	EXPECT_EQ(data[0], 3);
+	EXPECT_EQ(data[3], 6);
+	EXPECT_EQ(data[4], 0);
+	EXPECT_EQ(subject.tell(), 4);
+
+	ret = subject.read(data, 8);
+	EXPECT_EQ(ret, 0);
+}
+
+TEST_F(CMemoryViewStreamTest, seekAndSkip)
+{
+	EXPECT_EQ(subject.skip(3), 3);
+	EXPECT_EQ(subject.skip(3), 1);
+	EXPECT_EQ(subject.tell(), 4);
+
+	subject.seek(1);
+	ui8 value = 0;
+	EXPECT_EQ(subject.read(&value, 1), 1);
+	EXPECT_EQ(value, 4);
+}
+
+TEST_F(CMemoryViewStreamTest, sharedDataOutlivesStream)
+{
+	std::weak_ptr<std::vector<ui8>> weakBuffer = buffer;
+	auto view = subject.readAllShared();
+	buffer.reset();
+
+	EXPECT_FALSE(weakBuffer.expired());
+	EXPECT_EQ(view.second, 4);
+	EXPECT_EQ(view.first.get()[0], 3);
+
+	view.first.reset();
+	EXPECT_FALSE(weakBuffer.expired()); // still owned by stream
+}
+
+TEST(CMappedFileTest, mapsWholeFile)
+{
+	auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vcmi-mapped-%%%%%%%%.bin");
+	{
+		std::ofstream file(path.string(), std::ofstream::binary);
+		file << "mapped file";
+	}
+
+	{
+		auto mapped = std::make_shared<CMappedFile>(path);
+		ASSERT_EQ(mapped->size(), 11);
+		EXPECT_EQ(std::string(reinterpret_cast<const char *>(mapped->data()), mapped->size()), "mapped file");
+
+		CMemoryViewStream stream(mapped, mapped->data(), mapped->size());
+		auto data = stream.readAll();
+		EXPECT_EQ(data.second, 11);
+		EXPECT_EQ(data.first[0], 'm');
+	}
+
+	boost::filesystem::remove(path);
+}
@@ -0,0 +1,83 @@
+/*
+ * FogOfWarMapTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "../lib/gameState/FogOfWarMap.h"
+
+TEST(TileSpanSetTest, insertMergesAdjacentSpans)
+{
+	TileSpanSet tiles;
+	tiles.insert(int3(5, 1, 0), 3);
+	tiles.insert(int3(0, 1, 0), 2);
+	tiles.insert(int3(2, 1, 0), 3);
+	tiles.insert(int3(3, 0, 0));
+	tiles.insert(int3(3, 0, 1));
+
+	ASSERT_EQ(tiles.getSpans().size(), 3);
+	EXPECT_EQ(tiles.getSpans()[0], TileSpan(int3(3, 0, 0), 1));
+	EXPECT_EQ(tiles.getSpans()[1], TileSpan(int3(0, 1, 0), 8));
+	EXPECT_EQ(tiles.getSpans()[2], TileSpan(int3(3, 0, 1), 1));
+	EXPECT_EQ(tiles.size(), 10);
+
+	EXPECT_TRUE(tiles.contains(int3(7, 1, 0)));
+	EXPECT_FALSE(tiles.contains(int3(8, 1, 0)));
+	EXPECT_FALSE(tiles.contains(int3(3, 0, 2)));
+}
+
+TEST(TileSpanSetTest, eraseSplitsSpans)
+{
+	TileSpanSet tiles;
+	tiles.insert(int3(0, 0, 0), 10);
+	tiles.insert(int3(0, 1, 0), 10);
+
+	TileSpanSet removed;
+	removed.insert(int3(2, 0, 0), 2);
+	removed.insert(int3(6, 0, 0));
+	removed.insert(int3(0, 1, 0), 20);
+
+	tiles.erase(removed);
+
+	ASSERT_EQ(tiles.getSpans().size(), 3);
+	EXPECT_EQ(tiles.getSpans()[0], TileSpan(int3(0, 0, 0), 2));
+	EXPECT_EQ(tiles.getSpans()[1], TileSpan(int3(4, 0, 0), 2));
+	EXPECT_EQ(tiles.getSpans()[2], TileSpan(int3(7, 0, 0), 3));
+}
+
+TEST(FogOfWarMapTest, revealAndSelect)
+{
+	FogOfWarMap fow;
+	fow.resize(int3(144, 3, 2));
+
+	TileSpanSet revealed;
+	revealed.insert(int3(60, 1, 1), 10);
+	revealed.insert(int3(130, 1, 1));
+	fow.reveal(revealed);
+
+	EXPECT_FALSE(fow.isVisible(int3(59, 1, 1)));
+	EXPECT_TRUE(fow.isVisible(int3(60, 1, 1)));
+	EXPECT_TRUE(fow.isVisible(int3(69, 1, 1)));
+	EXPECT_FALSE(fow.isVisible(int3(70, 1, 1)));
+	EXPECT_FALSE(fow.isVisible(int3(60, 1, 0)));
+
+	TileSpanSet visible;
+	fow.selectTiles(visible, int3(0, 1, 1), 144, true);
+	EXPECT_EQ(visible, revealed);
+
+	TileSpanSet hidden;
+	fow.selectTiles(hidden, int3(0, 1, 1), 144, false);
+	ASSERT_EQ(hidden.getSpans().size(), 3);
+	EXPECT_EQ(hidden.getSpans()[0], TileSpan(int3(0, 1, 1), 60));
+	EXPECT_EQ(hidden.getSpans()[1], TileSpan(int3(70, 1, 1), 60));
+	EXPECT_EQ(hidden.getSpans()[2], TileSpan(int3(131, 1, 1), 13));
+
+	fow.hide(int3(65, 1, 1));
+	EXPECT_FALSE(fow.isVisible(int3(65, 1, 1)));
+	EXPECT_TRUE(fow.isVisible(int3(64, 1, 1)));
+}
@@ -26,6 +26,10 @@ public:
 	MOCK_METHOD2(callGlobal, JsonNode(const std::string &, const JsonNode &));
 	MOCK_METHOD3(callGlobal, JsonNode(ServerCallback *, const std::string &, const JsonNode &));
 
+	MOCK_METHOD1(callGlobalPredicate, std::optional<bool>(const std::string &));
+	MOCK_METHOD2(callGlobalPredicate, std::optional<bool>(const std::string &, const EffectTargets &));
+	MOCK_METHOD3(callGlobal, void(ServerCallback *, const std::string &, const EffectTargets &));
+
 	MOCK_METHOD2(getGlobal, void(const std::string &, int &));
 	MOCK_METHOD2(getGlobal, void(const std::string &, std::string &));
 	MOCK_METHOD2(getGlobal, void(const std::string &, double &));
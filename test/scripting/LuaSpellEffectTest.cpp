@@ -50,8 +50,6 @@ public:
 	RegistryMock::FactoryPtr factory;
 	StrictMock<ServerCallbackMock> serverMock;
 
-	JsonNode request;
-
 	LuaSpellEffectTest()
 		: EffectFixture("testScript")
 	{
@@ -89,22 +87,6 @@ public:
 //		EffectFixture::setupEffect(options);
 	}
 
-	JsonNode saveRequest(const std::string &, const JsonNode & parameters)
-	{
-		JsonNode response(true);
-
-		request = parameters;
-		return response;
-	}
-
-	JsonNode saveRequest2(ServerCallback *, const std::string &, const JsonNode & parameters)
-	{
-		JsonNode response(true);
-
-		request = parameters;
-		return response;
-	}
-
 protected:
 	void SetUp() override
 	{
@@ -123,9 +105,7 @@ TEST_F(LuaSpellEffectTest, ApplicableRedirected)
 {
 	setDefaultExpectations();
 
-	JsonNode response(true);
-
-	EXPECT_CALL(*contextMock, callGlobal(Eq("applicable"),_)).WillOnce(Return(response));//TODO: check call parameter
+	EXPECT_CALL(*contextMock, callGlobalPredicate(Eq("applicable"))).WillOnce(Return(true));
 
 	EXPECT_TRUE(subject->applicable(problemMock, &mechanicsMock));
 }
@@ -134,8 +114,6 @@ TEST_F(LuaSpellEffectTest, ApplicableTargetRedirected)
 {
 	setDefaultExpectations();
 
-	EXPECT_CALL(*contextMock, callGlobal(Eq("applicableTarget"),_)).WillOnce(Invoke(this, &LuaSpellEffectTest::saveRequest));
-
 	auto & unit1 = unitsFake.add(BattleSide::ATTACKER);
 
 	EffectTarget target;
@@ -150,34 +128,21 @@ TEST_F(LuaSpellEffectTest, ApplicableTargetRedirected)
 	target.emplace_back(&unit1, hex1);
 	target.emplace_back(hex2);
 
-	EXPECT_TRUE(subject->applicable(problemMock, &mechanicsMock, target));
-
-
-	JsonNode first;
-	first.Vector().emplace_back(hex1.hex);
-	first.Vector().emplace_back(id1);
-
-	JsonNode second;
-	second.Vector().emplace_back(hex2.hex);
-	second.Vector().emplace_back(-1);
-
-	JsonNode targets;
-	targets.Vector().push_back(first);
-	targets.Vector().push_back(second);
+	EffectTargets expected =
+	{
+		{hex1.hex, id1},
+		{hex2.hex, -1}
+	};
 
-	JsonNode expected;
-	expected.Vector().push_back(targets);
+	EXPECT_CALL(*contextMock, callGlobalPredicate(Eq("applicableTarget"), Eq(expected))).WillOnce(Return(true));
 
-	JsonComparer c(false);
-	c.compare("applicableTarget request", request, expected);
+	EXPECT_TRUE(subject->applicable(problemMock, &mechanicsMock, target));
 }
 
 TEST_F(LuaSpellEffectTest, ApplyRedirected)
 {
 	setDefaultExpectations();
 
-	EXPECT_CALL(*contextMock, callGlobal(Eq(&serverMock), Eq("apply"),_)).WillOnce(Invoke(this, &LuaSpellEffectTest::saveRequest2));
-
 	auto & unit1 = unitsFake.add(BattleSide::ATTACKER);
 
 	EffectTarget target;
@@ -190,21 +155,14 @@ TEST_F(LuaSpellEffectTest, ApplyRedirected)
 
 	target.emplace_back(&unit1, hex1);
 
-	subject->apply(&serverMock, &mechanicsMock, target);
-
-	JsonNode first;
-	first.Vector().emplace_back(hex1.hex);
-	first.Vector().emplace_back(id1);
-
-	JsonNode targets;
-	targets.Vector().push_back(first);
+	EffectTargets expected =
+	{
+		{hex1.hex, id1}
+	};
 
-	JsonNode expected;
-	expected.Vector().push_back(targets);
+	EXPECT_CALL(*contextMock, callGlobal(Eq(&serverMock), Eq("apply"), Eq(expected)));
 
-	JsonComparer c(false);
-	c.compare("apply request", request, expected);
+	subject->apply(&serverMock, &mechanicsMock, target);
 }
 
 }
-
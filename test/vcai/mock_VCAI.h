@@ -44,7 +44,7 @@ public:
 	MOCK_METHOD1(heroMoved, void(const TryMoveHero & details));
 	MOCK_METHOD1(heroInGarrisonChange, void(const CGTownInstance * town));
 	MOCK_METHOD2(centerView, void(int3 pos, int focusTime));
-	MOCK_METHOD1(tileHidden, void(const std::unordered_set<int3, ShashInt3> & pos));
+	MOCK_METHOD1(tileHidden, void(const TileSpanSet & pos));
 	MOCK_METHOD2(artifactMoved, void(const ArtifactLocation & src, const ArtifactLocation & dst));
 	MOCK_METHOD1(artifactAssembled, void(const ArtifactLocation & al));
 	MOCK_METHOD1(showTavernWindow, void(const CGObjectInstance * townOrTavern));
@@ -59,7 +59,7 @@ public:
 	MOCK_METHOD3(heroVisit, void(const CGHeroInstance * visitor, const CGObjectInstance * visitedObj, bool start));
 	MOCK_METHOD1(availableArtifactsChanged, void(const CGBlackMarket * bm));
 	MOCK_METHOD2(heroVisitsTown, void(const CGHeroInstance * hero, const CGTownInstance * town));
-	MOCK_METHOD1(tileRevealed, void(const std::unordered_set<int3, ShashInt3> & pos));
+	MOCK_METHOD1(tileRevealed, void(const TileSpanSet & pos));
 	MOCK_METHOD3(heroExchangeStarted, void(ObjectInstanceID hero1, ObjectInstanceID hero2, QueryID query));
 	MOCK_METHOD3(heroPrimarySkillChanged, void(const CGHeroInstance * hero, int which, si64 val));
 	MOCK_METHOD3(showRecruitmentDialog, void(const CGDwelling * dwelling, const CArmedInstance * dst, int level));